@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+"""
+Headless benchmark harness for the jtxt library
+
+Boots a benchmark cartridge (c/oscar64_crt/bench_bitmap.crt and its
+variants), or a benchmark PRG with a font cartridge attached, in a
+6502/C64 model, presses SPACE whenever the program waits
+for it, and collects the CIA2 timer intervals of every benchmark case.
+The benchmark names each case by writing its number to the tag port
+($D7FE) before running it.
+
+Results are written as JSON. With --baseline, every case is compared with
+a previous run and the harness exits with status 1 when a case got slower
+than the configured threshold.
+
+Usage:
+  python3 bench_harness.py bench_bitmap.crt -o results.json
+  python3 bench_harness.py bench_bitmap.crt --write-baseline baseline.json
+  python3 bench_harness.py bench_bitmap.crt --baseline baseline.json --threshold 2
+  python3 bench_harness.py c64jpkanji.crt --prg bench_bitmap_reu.prg --reu 512
+  python3 bench_harness.py c64jpkanji.crt --prg bench_bitmap_reu.prg --reu 512 --pairs
+"""
+
+import argparse
+import json
+import os
+import sys
+
+from c64machine import C64Machine, CRTError, TAG_DONE
+from cpu6502 import CPUError
+
+# Case names by tag number (see BENCH_TAG in bench_bitmap.c and bench_term.c)
+CASE_NAMES = {
+    1: 'draw_ascii_1',
+    2: 'draw_kanji_1',
+    3: 'bputs_ascii_10',
+    4: 'bputs_kanji_10',
+    5: 'line_ascii_40',
+    6: 'line_kanji_40',
+    7: 'scroll_up',
+    8: 'fullscreen_ascii',
+    9: 'fullscreen_kanji',
+    10: 'bputs_fast_ascii_10',
+    11: 'bputs_fast_kanji_10',
+    12: 'fullscreen_ascii_fast',
+    13: 'fullscreen_kanji_fast',
+    14: 'cache_line_kanji_40_cold',
+    15: 'cache_line_kanji_40_warm',
+    16: 'cache_fullscreen_kanji',
+    17: 'shadow_bputs',
+    18: 'shadow_bputs_diff',
+    19: 'shadow_commit_row',
+    20: 'puts_kanji_10',
+    21: 'puts_fast_kanji_10',
+    22: 'puts_kanji_40',
+    23: 'puts_fast_kanji_40',
+    24: 'grouped_line_kanji_40',
+    25: 'grouped_fullscreen_kanji',
+    26: 'grouped_fullscreen_ascii',
+    27: 'fast_line_kanji_40',
+    28: 'index_off_draw_kanji_1',
+    29: 'index_off_line_kanji_40',
+    30: 'index_off_fullscreen_kanji',
+    31: 'index_on_draw_kanji_1',
+    32: 'index_on_line_kanji_40',
+    33: 'index_on_fullscreen_kanji',
+    34: 'reu_off_draw_kanji_1',
+    35: 'reu_off_line_kanji_40',
+    36: 'reu_off_fullscreen_kanji',
+    37: 'reu_on_draw_kanji_1',
+    38: 'reu_on_line_kanji_40',
+    39: 'reu_on_fullscreen_kanji',
+    40: 'reu_off_scroll_up',
+    41: 'reu_on_scroll_up',
+    42: 'reu_off_bcls',
+    43: 'reu_on_bcls',
+    44: 'ime_lookup_words',
+    45: 'ime_lookup_unknown',
+    46: 'recv_text',
+    47: 'recv_ansi',
+}
+
+KEY_SPACE = (7, 4)          # CIA1 column 7, row 4
+KEY_TOGGLE_CYCLES = 20000   # SPACE pressed/released alternately
+STEP_BATCH = 1000
+
+DEFAULT_THRESHOLD = 2.0     # Percent
+DEFAULT_MAX_CYCLES = 500000000
+
+def case_key(tag):
+    return f"{tag:02d}_{CASE_NAMES.get(tag, 'tag')}"
+
+def run_benchmark(crt_file, max_cycles, roms, reu_kb=0, prg_file=None):
+    """Run the cartridge (or PRG) until it reports TAG_DONE; returns the result dict"""
+    machine = C64Machine(crt_file, kernal=roms.get('kernal'),
+                         basic=roms.get('basic'), chargen=roms.get('chargen'),
+                         reu_size=reu_kb * 1024)
+    machine.boot(machine.load_prg(prg_file) if prg_file else None)
+
+    cpu = machine.cpu
+    step = cpu.step
+    next_toggle = KEY_TOGGLE_CYCLES
+
+    while not machine.done:
+        for _ in range(STEP_BATCH):
+            step()
+        if cpu.cycles >= next_toggle:
+            machine.keys ^= {KEY_SPACE}
+            next_toggle = cpu.cycles + KEY_TOGGLE_CYCLES
+        if cpu.cycles > max_cycles:
+            raise CPUError(f"no TAG_DONE after {max_cycles} cycles (PC=${cpu.pc:04X}, tag {machine.tag})")
+
+    cases = {}
+    for tag, cycles, banks in machine.intervals:
+        if tag == 0 or tag == TAG_DONE:
+            continue
+        entry = cases.setdefault(case_key(tag), {'cycles': 0, 'intervals': 0, 'bank_switches': 0})
+        entry['cycles'] += cycles
+        entry['intervals'] += 1
+        entry['bank_switches'] += banks
+
+    results = {'crt': crt_file}
+    if prg_file:
+        results['prg'] = prg_file
+    results.update({
+        'reu_kb': reu_kb,
+        'total_cycles': cpu.cycles,
+        'cases': dict(sorted(cases.items())),
+    })
+    return results
+
+def load_config(filename):
+    if not filename:
+        return {}
+    with open(filename, 'r', encoding='utf-8') as f:
+        return json.load(f)
+
+def compare(results, baseline, config, threshold):
+    """Compare with baseline; returns list of failure messages"""
+    failures = []
+    overrides = config.get('cases', {})
+    current = results['cases']
+
+    print(f"{'CASE':32} {'BASE':>10} {'NOW':>10} {'DIFF':>8}", file=sys.stderr)
+    for name, base in sorted(baseline['cases'].items()):
+        limit = overrides.get(name, {}).get('threshold_percent', threshold)
+        if name not in current:
+            failures.append(f"{name}: missing from this run")
+            print(f"{name:32} {base['cycles']:>10} {'-':>10} {'MISSING':>8}", file=sys.stderr)
+            continue
+        now = current[name]['cycles']
+        diff = (now - base['cycles']) * 100.0 / base['cycles'] if base['cycles'] else 0.0
+        mark = ''
+        if diff > limit:
+            failures.append(f"{name}: {base['cycles']} -> {now} cycles (+{diff:.2f}% > {limit}%)")
+            mark = ' FAIL'
+        print(f"{name:32} {base['cycles']:>10} {now:>10} {diff:>+7.2f}%{mark}", file=sys.stderr)
+
+    return failures
+
+def print_pairs(results):
+    """Markdown table of the before/after cases (xxx_off_yyy against xxx_on_yyy)"""
+    cases = results['cases']
+    print("| Test | Before | After | Change |", file=sys.stderr)
+    print("|------|-------:|------:|-------:|", file=sys.stderr)
+    for name, before in cases.items():
+        tag, _, case = name.partition('_')
+        if '_off_' not in case:
+            continue
+        after_case = case.replace('_off_', '_on_', 1)
+        after_name = next((key for key in cases if key.partition('_')[2] == after_case), None)
+        if after_name is None:
+            continue
+        after = cases[after_name]
+        diff = (after['cycles'] - before['cycles']) * 100.0 / before['cycles'] if before['cycles'] else 0.0
+        label = f"{tag}/{after_name.partition('_')[0]} {after_case.replace('_on_', '_', 1)}"
+        print(f"| {label} | {before['cycles']} | {after['cycles']} | {diff:+.1f}% |", file=sys.stderr)
+
+def main():
+    parser = argparse.ArgumentParser(description='Headless jtxt benchmark harness')
+    parser.add_argument('crt', help='Benchmark cartridge image (.crt)')
+    parser.add_argument('--prg', default=None,
+                        help='Benchmark PRG to run with the cartridge attached (started via its SYS line)')
+    parser.add_argument('--output', '-o', default=None,
+                        help='Write results JSON to this file (default: stdout)')
+    parser.add_argument('--baseline', default=None,
+                        help='Compare with this results JSON and fail on regressions')
+    parser.add_argument('--write-baseline', default=None,
+                        help='Write results JSON as a new baseline')
+    parser.add_argument('--config', default=None,
+                        help='JSON config with threshold_percent and per-case overrides')
+    parser.add_argument('--threshold', type=float, default=None,
+                        help=f'Allowed slowdown in percent (default: config or {DEFAULT_THRESHOLD})')
+    parser.add_argument('--max-cycles', type=int, default=None,
+                        help=f'Abort after this many cycles (default: {DEFAULT_MAX_CYCLES})')
+    parser.add_argument('--reu', type=int, default=None, choices=[0, 128, 256, 512],
+                        help='Attach an REU of this many KB (default: config or 0)')
+    parser.add_argument('--pairs', action='store_true',
+                        help='Print the before/after (_off_/_on_) cases as a Markdown table on stderr')
+    parser.add_argument('--kernal', default=None, help='KERNAL ROM image (optional)')
+    parser.add_argument('--basic', default=None, help='BASIC ROM image (optional)')
+    parser.add_argument('--chargen', default=None, help='Character ROM image (optional)')
+    args = parser.parse_args()
+
+    config = load_config(args.config)
+    threshold = args.threshold if args.threshold is not None else \
+        config.get('threshold_percent', DEFAULT_THRESHOLD)
+    max_cycles = args.max_cycles or config.get('max_cycles', DEFAULT_MAX_CYCLES)
+    roms = {'kernal': args.kernal, 'basic': args.basic, 'chargen': args.chargen}
+    reu_kb = args.reu if args.reu is not None else config.get('reu_kb', 0)
+
+    # A gate without a recorded baseline must not pass
+    if args.baseline and not os.path.exists(args.baseline):
+        print(f"Error: baseline {args.baseline} not found (record it with --write-baseline)",
+              file=sys.stderr)
+        return 2
+
+    try:
+        results = run_benchmark(args.crt, max_cycles, roms, reu_kb, args.prg)
+    except (CRTError, CPUError, OSError) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 2
+
+    text = json.dumps(results, indent=2)
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as f:
+            f.write(text + '\n')
+    else:
+        print(text)
+
+    if args.write_baseline:
+        with open(args.write_baseline, 'w', encoding='utf-8') as f:
+            f.write(text + '\n')
+
+    if args.pairs:
+        print_pairs(results)
+
+    if args.baseline:
+        with open(args.baseline, 'r', encoding='utf-8') as f:
+            baseline = json.load(f)
+        failures = compare(results, baseline, config, threshold)
+        if failures:
+            print("\nPerformance regression:", file=sys.stderr)
+            for message in failures:
+                print(f"  {message}", file=sys.stderr)
+            return 1
+        print("\nNo regression", file=sys.stderr)
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
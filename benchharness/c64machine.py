@@ -0,0 +1,606 @@
+#!/usr/bin/env python3
+"""
+Headless C64 machine model for the benchmark harness
+
+Only what the jtxt benchmarks touch is modeled:
+  - 64KB RAM, $00/$01 processor port (LORAM/HIRAM/CHAREN banking)
+  - Cartridge from a .crt image: EasyFlash (type 32) with $DE00 bank and
+    $DE02 control register plus 256 bytes RAM at $DF00, MagicDesk (type 19)
+    with $DE00 bank/disable, or a plain 8K/16K cartridge
+  - Color RAM ($D800-$DBFF), VIC/SID registers as plain storage with a
+    cycle-derived raster counter ($D011 bit 7 / $D012)
+  - CIA1 keyboard matrix, CIA2 timers A/B counting at the CPU clock
+  - Optional 17xx REU at $DF00 (stash/fetch/swap/verify, fixed address
+    fill, autoload), taking one cycle per byte moved
+  - Tag port at $D7FE (SID mirror, ignored by real hardware): writes name
+    the benchmark case that following CIA2 timer intervals belong to
+
+A PRG can be loaded next to the cartridge and started through its BASIC
+SYS line, for builds that keep their code in RAM and only read the
+cartridge ROM banks (e.g. an REU build with the MagicDesk font cartridge).
+
+Interrupts are not generated; the benchmarks run with them masked.
+KERNAL/BASIC/character ROM images are optional; without them those areas
+read as $00, so a stray call into the KERNAL stops at a BRK.
+"""
+
+import struct
+
+from cpu6502 import CPU6502, CPUError
+
+TAG_PORT = 0xD7FE
+TAG_DONE = 0xFF
+
+CRT_TYPE_NORMAL = 0
+CRT_TYPE_EASYFLASH = 32
+CRT_TYPE_MAGICDESK = 19
+
+CYCLES_PER_LINE = 63      # PAL
+LINES_PER_FRAME = 312
+
+EMPTY_8K = bytes(0x2000)  # Missing ROM images read as $00
+EMPTY_4K = bytes(0x1000)
+
+class CRTError(Exception):
+    pass
+
+def load_crt(filename):
+    """Parse a .crt file: returns (hardware_type, exrom, game, chips)
+
+    chips: {(bank, load_address): bytes}
+    """
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    if data[:16] != b'C64 CARTRIDGE   ':
+        raise CRTError(f"{filename}: not a CRT image")
+
+    header_len = struct.unpack('>I', data[0x10:0x14])[0]
+    hw_type = struct.unpack('>H', data[0x16:0x18])[0]
+    exrom = data[0x18]
+    game = data[0x19]
+
+    chips = {}
+    pos = header_len
+    while pos + 16 <= len(data):
+        if data[pos:pos + 4] != b'CHIP':
+            raise CRTError(f"{filename}: bad CHIP packet at {pos}")
+        packet_len = struct.unpack('>I', data[pos + 4:pos + 8])[0]
+        bank = struct.unpack('>H', data[pos + 10:pos + 12])[0]
+        load = struct.unpack('>H', data[pos + 12:pos + 14])[0]
+        size = struct.unpack('>H', data[pos + 14:pos + 16])[0]
+        rom = data[pos + 16:pos + 16 + size]
+
+        # 16KB chips cover ROML and ROMH
+        for i in range(0, size, 0x2000):
+            chips[(bank, load + i)] = rom[i:i + 0x2000]
+        pos += packet_len
+
+    return hw_type, exrom, game, chips
+
+class Timer:
+    """CIA timer counting down once per cycle (continuous or one-shot)"""
+
+    def __init__(self, machine):
+        self.machine = machine
+        self.latch = 0xFFFF
+        self.value = 0xFFFF
+        self.running = False
+        self.one_shot = False
+        self.start_cycle = 0
+
+    def current(self):
+        if not self.running:
+            return self.value
+        elapsed = self.machine.cpu.cycles - self.start_cycle
+        if elapsed <= self.value:
+            return self.value - elapsed
+        if self.one_shot:
+            return self.latch
+        period = self.latch + 1
+        return self.latch - ((elapsed - self.value - 1) % period)
+
+    def control(self, value):
+        self.value = self.current()
+        if value & 0x10:
+            self.value = self.latch
+        self.one_shot = bool(value & 0x08)
+        self.running = bool(value & 0x01)
+        self.start_cycle = self.machine.cpu.cycles
+
+class REU:
+    """17xx RAM expansion unit registers and DMA engine"""
+
+    def __init__(self, machine, size):
+        self.machine = machine
+        self.mem = bytearray(size)
+        self.bank_mask = max(size // 0x10000, 1) - 1
+        self.status = 0x10 if size > 0x20000 else 0x00  # Bit 4: 256K+ chips
+        self.command = 0x10
+        self.c64_addr = 0
+        self.reu_addr = 0     # 24 bits: bank << 16 | address
+        self.length = 0xFFFF
+        self.irq_mask = 0x1F
+        self.addr_ctrl = 0x3F
+        self._shadow = (0, 0, 0xFFFF)
+        self.transfers = 0
+
+    def read(self, reg):
+        if reg == 0x00:
+            value = self.status
+            self.status &= 0x1F            # Interrupt/end/fault clear on read
+            return value
+        if reg == 0x01:
+            return self.command
+        if reg == 0x02:
+            return self.c64_addr & 0xFF
+        if reg == 0x03:
+            return self.c64_addr >> 8
+        if reg == 0x04:
+            return self.reu_addr & 0xFF
+        if reg == 0x05:
+            return (self.reu_addr >> 8) & 0xFF
+        if reg == 0x06:
+            return (self.reu_addr >> 16) | 0xF8
+        if reg == 0x07:
+            return self.length & 0xFF
+        if reg == 0x08:
+            return self.length >> 8
+        if reg == 0x09:
+            return self.irq_mask | 0x1F
+        if reg == 0x0A:
+            return self.addr_ctrl | 0x3F
+        return 0xFF
+
+    def write(self, reg, value):
+        if reg == 0x01:
+            self.command = value
+            if value & 0x80 and value & 0x10:
+                self.execute()
+            return
+        if reg == 0x02:
+            self.c64_addr = (self.c64_addr & 0xFF00) | value
+        elif reg == 0x03:
+            self.c64_addr = (self.c64_addr & 0x00FF) | (value << 8)
+        elif reg == 0x04:
+            self.reu_addr = (self.reu_addr & 0xFFFF00) | value
+        elif reg == 0x05:
+            self.reu_addr = (self.reu_addr & 0xFF00FF) | (value << 8)
+        elif reg == 0x06:
+            self.reu_addr = (self.reu_addr & 0x00FFFF) | ((value & 0x07) << 16)
+        elif reg == 0x07:
+            self.length = (self.length & 0xFF00) | value
+        elif reg == 0x08:
+            self.length = (self.length & 0x00FF) | (value << 8)
+        elif reg == 0x09:
+            self.irq_mask = value & 0xE0
+            return
+        elif reg == 0x0A:
+            self.addr_ctrl = value & 0xC0
+            return
+        else:
+            return
+        # Writes go to the working and the autoload copy of that register
+        c64, reu, length = self._shadow
+        if reg <= 0x03:
+            c64 = self.c64_addr
+        elif reg <= 0x06:
+            reu = self.reu_addr
+        else:
+            length = self.length
+        self._shadow = (c64, reu, length)
+
+    def trigger_ff00(self):
+        """A write to $FF00 starts a transfer armed without bit 4"""
+        if self.command & 0x90 == 0x80:
+            self.execute()
+
+    def execute(self):
+        m = self.machine
+        mode = self.command & 0x03
+        count = self.length or 0x10000
+        fix_c64 = self.addr_ctrl & 0x80
+        fix_reu = self.addr_ctrl & 0x40
+        c64 = self.c64_addr
+        bank = (self.reu_addr >> 16) & self.bank_mask
+        reu = self.reu_addr & 0xFFFF
+        mem = self.mem
+        moved = 0
+        fault = False
+
+        while moved < count:
+            pos = (bank << 16) | reu
+            if mode == 0:                  # Stash: C64 -> REU
+                mem[pos] = m.read(c64)
+            elif mode == 1:                # Fetch: REU -> C64
+                m.write(c64, mem[pos])
+            elif mode == 2:                # Swap
+                value = m.read(c64)
+                m.write(c64, mem[pos])
+                mem[pos] = value
+            elif m.read(c64) != mem[pos]:  # Verify
+                fault = True
+            moved += 1
+            if not fix_c64:
+                c64 = (c64 + 1) & 0xFFFF
+            if not fix_reu:
+                reu += 1
+                if reu > 0xFFFF:
+                    reu = 0
+                    bank = (bank + 1) & self.bank_mask
+            if fault:
+                break
+
+        m.cpu.cycles += moved * (2 if mode == 2 else 1)
+        self.transfers += 1
+        self.status |= 0x40                # End of block
+        if fault:
+            self.status |= 0x20
+        self.command = (self.command & 0x7F) | 0x10
+
+        if self.command & 0x20:            # Autoload
+            self.c64_addr, self.reu_addr, self.length = self._shadow
+        else:
+            self.c64_addr = c64
+            self.reu_addr = (bank << 16) | reu
+            self.length = max(count - moved, 1)
+
+class C64Machine:
+    def __init__(self, crt_file=None, kernal=None, basic=None, chargen=None, reu_size=0):
+        self.ram = bytearray(0x10000)
+        self.color_ram = bytearray(0x400)
+        self.io = bytearray(0x1000)     # VIC/SID/CIA register storage
+        self.ef_ram = bytearray(0x100)  # EasyFlash RAM at $DF00
+        self.port_dir = 0x2F
+        self.port_data = 0x37
+
+        self.kernal = self._load_rom(kernal, 0x2000)
+        self.basic = self._load_rom(basic, 0x2000)
+        self.chargen = self._load_rom(chargen, 0x1000)
+
+        # Cartridge
+        self.hw_type = None
+        self.chips = {}
+        self.bank = 0
+        self.exrom = 1
+        self.game = 1
+        self.ef_control = 0
+        if crt_file:
+            self.hw_type, self.exrom, self.game, self.chips = load_crt(crt_file)
+            if self.hw_type == CRT_TYPE_EASYFLASH:
+                self._ef_update_lines()
+
+        # RAM expansion unit (size in bytes, 0 = none)
+        self.reu = REU(self, reu_size) if reu_size else None
+
+        # CIA
+        self.cia1_pra = 0xFF
+        self.keys = set()               # Pressed keys as (column, row)
+        self.timer_a = Timer(self)
+        self.timer_b = Timer(self)
+
+        # Harness bookkeeping
+        self.tag = 0
+        self.tag_log = []               # (tag, cycles) for each tag write
+        self.intervals = []             # (tag, cycles, bank switches) per timer A start/stop
+        self.done = False
+        self._interval_start = None
+        self._interval_banks = 0
+        self.bank_switches = 0
+        self.port_writes = 0
+
+        self.cpu = CPU6502(self)
+        self._update_map()
+
+    @staticmethod
+    def _load_rom(filename, size):
+        if not filename:
+            return None
+        with open(filename, 'rb') as f:
+            data = f.read()
+        if len(data) < size:
+            raise CRTError(f"{filename}: expected {size} bytes")
+        return data[:size]
+
+    #=========================================================================
+    # Banking
+    #=========================================================================
+
+    def _ef_update_lines(self):
+        # $DE02: bit2 M (GAME from bit0 instead of boot jumper),
+        #        bit1 X (EXROM asserted), bit0 G (GAME asserted)
+        c = self.ef_control
+        self.exrom = 0 if c & 0x02 else 1
+        if c & 0x04:
+            self.game = 0 if c & 0x01 else 1
+        else:
+            self.game = 0  # Boot jumper: Ultimax on reset
+
+    def _update_map(self):
+        """Recompute which chips are visible for the current $01 and cart lines"""
+        port = (self.port_data | ~self.port_dir) & 0x07
+        loram = port & 1
+        hiram = port & 2
+        charen = port & 4
+
+        ultimax = self.exrom == 1 and self.game == 0
+        cart_roml = None
+        cart_romh = None
+        romh_at_e000 = False
+
+        if self.chips:
+            roml = self.chips.get((self.bank, 0x8000))
+            romh = self.chips.get((self.bank, 0xA000)) or self.chips.get((self.bank, 0xE000))
+            if ultimax:
+                cart_roml = roml
+                cart_romh = romh
+                romh_at_e000 = True
+            elif self.exrom == 0:
+                if loram and hiram:
+                    cart_roml = roml
+                if self.game == 0 and hiram:
+                    cart_romh = romh
+
+        self.map_8000 = cart_roml
+
+        if cart_romh is not None and not romh_at_e000:
+            self.map_a000 = cart_romh
+        elif loram and hiram and not ultimax:
+            self.map_a000 = self.basic or EMPTY_8K
+        else:
+            self.map_a000 = None
+
+        if romh_at_e000:
+            self.map_e000 = cart_romh
+        elif hiram:
+            self.map_e000 = self.kernal or EMPTY_8K
+        else:
+            self.map_e000 = None
+
+        if ultimax or charen and (loram or hiram):
+            self.map_d000 = 'io'
+        elif loram or hiram:
+            self.map_d000 = self.chargen or EMPTY_4K
+        else:
+            self.map_d000 = None
+
+    #=========================================================================
+    # Bus
+    #=========================================================================
+
+    def read(self, addr):
+        if 2 <= addr < 0x8000:
+            return self.ram[addr]
+        return self._read_slow(addr)
+
+    def _read_slow(self, addr):
+        if addr < 2:
+            return self.port_dir if addr == 0 else \
+                (self.port_data & self.port_dir) | (0x17 & ~self.port_dir)
+        if addr < 0xA000:
+            rom = self.map_8000
+            return rom[addr - 0x8000] if rom is not None else self.ram[addr]
+        if addr < 0xC000:
+            rom = self.map_a000
+            return rom[addr - 0xA000] if rom is not None else self.ram[addr]
+        if addr < 0xD000:
+            return self.ram[addr]
+        if addr < 0xE000:
+            m = self.map_d000
+            if m is None:
+                return self.ram[addr]
+            if m == 'io':
+                return self._io_read(addr)
+            return m[addr - 0xD000]
+        rom = self.map_e000
+        return rom[addr - 0xE000] if rom is not None else self.ram[addr]
+
+    def write(self, addr, value):
+        if 2 <= addr < 0xD000:
+            self.ram[addr] = value
+            return
+        if addr < 2:
+            if addr == 0:
+                self.port_dir = value
+            else:
+                self.port_data = value
+            self.port_writes += 1
+            self._update_map()
+            return
+        if addr < 0xE000 and self.map_d000 == 'io':
+            self._io_write(addr, value)
+            return
+        self.ram[addr] = value
+        if addr == 0xFF00 and self.reu is not None:
+            self.reu.trigger_ff00()
+
+    #=========================================================================
+    # I/O
+    #=========================================================================
+
+    def _io_read(self, addr):
+        if 0xD800 <= addr < 0xDC00:
+            return self.color_ram[addr - 0xD800] | 0xF0
+        if addr < 0xD400:
+            reg = addr & 0x3F
+            if reg == 0x12 or reg == 0x11:
+                line = (self.cpu.cycles // CYCLES_PER_LINE) % LINES_PER_FRAME
+                if reg == 0x12:
+                    return line & 0xFF
+                return (self.io[0x011] & 0x7F) | ((line >> 1) & 0x80)
+            return self.io[reg]
+        if 0xDC00 <= addr < 0xDD00:
+            reg = addr & 0x0F
+            if reg == 0x01:
+                return self._keyboard_rows()
+            if reg == 0x0D:
+                return 0
+            return self.io[0xC00 + reg]
+        if 0xDD00 <= addr < 0xDE00:
+            reg = addr & 0x0F
+            if reg == 0x04:
+                return self.timer_a.current() & 0xFF
+            if reg == 0x05:
+                return self.timer_a.current() >> 8
+            if reg == 0x06:
+                return self.timer_b.current() & 0xFF
+            if reg == 0x07:
+                return self.timer_b.current() >> 8
+            if reg == 0x0D:
+                return 0
+            return self.io[0xD00 + reg]
+        if 0xDF00 <= addr and self.reu is not None:
+            return self.reu.read(addr & 0x1F)
+        if 0xDF00 <= addr and self.hw_type == CRT_TYPE_EASYFLASH:
+            return self.ef_ram[addr - 0xDF00]
+        return self.io[addr - 0xD000]
+
+    def _io_write(self, addr, value):
+        if 0xD800 <= addr < 0xDC00:
+            self.color_ram[addr - 0xD800] = value & 0x0F
+            return
+        if addr == TAG_PORT:
+            self.tag = value
+            self.tag_log.append((value, self.cpu.cycles))
+            if value == TAG_DONE:
+                self.done = True
+            return
+        if addr < 0xD400:
+            self.io[addr & 0x3F] = value
+            return
+        if 0xDC00 <= addr < 0xDD00:
+            reg = addr & 0x0F
+            if reg == 0x00:
+                self.cia1_pra = value
+            self.io[0xC00 + reg] = value
+            return
+        if 0xDD00 <= addr < 0xDE00:
+            self._cia2_write(addr & 0x0F, value)
+            return
+        if 0xDE00 <= addr < 0xDF00:
+            self._cart_write(addr, value)
+            return
+        if addr >= 0xDF00 and self.reu is not None:
+            self.reu.write(addr & 0x1F, value)
+            return
+        if addr >= 0xDF00 and self.hw_type == CRT_TYPE_EASYFLASH:
+            self.ef_ram[addr - 0xDF00] = value
+            return
+        self.io[addr - 0xD000] = value
+
+    def _cia2_write(self, reg, value):
+        self.io[0xD00 + reg] = value
+        if reg == 0x04:
+            self.timer_a.latch = (self.timer_a.latch & 0xFF00) | value
+        elif reg == 0x05:
+            self.timer_a.latch = (self.timer_a.latch & 0x00FF) | (value << 8)
+            if not self.timer_a.running:
+                self.timer_a.value = self.timer_a.latch
+        elif reg == 0x06:
+            self.timer_b.latch = (self.timer_b.latch & 0xFF00) | value
+        elif reg == 0x07:
+            self.timer_b.latch = (self.timer_b.latch & 0x00FF) | (value << 8)
+            if not self.timer_b.running:
+                self.timer_b.value = self.timer_b.latch
+        elif reg == 0x0E:
+            was_running = self.timer_a.running
+            self.timer_a.control(value)
+            # Harness interval: start on (re)start, stop when halted
+            if self.timer_a.running and (not was_running or value & 0x10):
+                self._interval_start = self.cpu.cycles
+                self._interval_banks = self.bank_switches
+            elif was_running and not self.timer_a.running and self._interval_start is not None:
+                self.intervals.append((self.tag, self.cpu.cycles - self._interval_start,
+                                       self.bank_switches - self._interval_banks))
+                self._interval_start = None
+        elif reg == 0x0F:
+            self.timer_b.control(value)
+
+    def _cart_write(self, addr, value):
+        reg = addr & 0xFF
+        if self.hw_type == CRT_TYPE_EASYFLASH:
+            if reg == 0x00:
+                self.bank = value & 0x3F
+                self.bank_switches += 1
+            elif reg == 0x02:
+                self.ef_control = value
+                self._ef_update_lines()
+            else:
+                return
+        elif self.hw_type == CRT_TYPE_MAGICDESK:
+            self.bank = value & 0x7F
+            self.exrom = 1 if value & 0x80 else 0
+            self.bank_switches += 1
+        else:
+            return
+        self._update_map()
+
+    #=========================================================================
+    # Keyboard
+    #=========================================================================
+
+    def _keyboard_rows(self):
+        cols = self.cia1_pra
+        rows = 0xFF
+        for col, row in self.keys:
+            if not (cols >> col) & 1:
+                rows &= ~(1 << row)
+        return rows
+
+    #=========================================================================
+    # Boot
+    #=========================================================================
+
+    def load_prg(self, filename):
+        """Copy a PRG into RAM; returns the address of its BASIC SYS line"""
+        with open(filename, 'rb') as f:
+            data = f.read()
+        if len(data) < 3:
+            raise CRTError(f"{filename}: not a PRG file")
+        load = data[0] | (data[1] << 8)
+        body = data[2:]
+        if load + len(body) > 0x10000:
+            raise CRTError(f"{filename}: does not fit in memory")
+        self.ram[load:load + len(body)] = body
+
+        # 10 SYS nnnn: link (2), line number (2), SYS token, digits
+        if load == 0x0801 and len(body) > 5 and body[4] == 0x9E:
+            digits = bytes(body[5:16]).split(b'\0')[0].strip()
+            if digits.isdigit():
+                return int(digits)
+        raise CRTError(f"{filename}: no BASIC SYS line to start from")
+
+    def boot(self, start=None):
+        """Reset the machine and enter the cartridge or a loaded PRG
+
+        With start (see load_prg) the program is entered there, with the
+        cartridge banked in as after a reset. Otherwise EasyFlash and
+        Ultimax carts start through the reset vector in ROMH, and 8K/16K
+        carts with a CBM80 signature through the cold-start vector at
+        $8000, as the KERNAL would.
+        """
+        self.port_dir = 0x2F
+        self.port_data = 0x37
+        self.bank = 0
+        self.ef_control = 0
+        if self.hw_type == CRT_TYPE_EASYFLASH:
+            self._ef_update_lines()
+        self._update_map()
+
+        if start is not None:
+            self.cpu.sp = 0xFF
+            self.cpu.pc = start
+            return
+
+        if self.exrom == 1 and self.game == 0:
+            self.cpu.reset()
+            return
+
+        if self.map_8000 is not None and bytes(self.map_8000[4:9]) == b'\xC3\xC2\xCD80':
+            self.cpu.sp = 0xFF
+            self.cpu.pc = self.map_8000[0] | (self.map_8000[1] << 8)
+            return
+
+        if self.kernal is None:
+            raise CRTError("cartridge has no autostart and no KERNAL image was given")
+        self.cpu.reset()
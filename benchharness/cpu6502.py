@@ -0,0 +1,478 @@
+#!/usr/bin/env python3
+"""
+NMOS 6502 CPU core for the benchmark harness
+
+Executes the documented 6502 instruction set with per-instruction cycle
+counts, including the extra cycle for page crossings on indexed reads and
+for taken branches. Undocumented opcodes raise CPUError; compilers used by
+this project (Oscar64, llvm-mos) do not emit them.
+
+The CPU talks to the machine only through bus.read(addr) and
+bus.write(addr, value); cycle counts are kept in cpu.cycles.
+"""
+
+class CPUError(Exception):
+    pass
+
+# Flag bits
+FLAG_C = 0x01
+FLAG_Z = 0x02
+FLAG_I = 0x04
+FLAG_D = 0x08
+FLAG_B = 0x10
+FLAG_U = 0x20
+FLAG_V = 0x40
+FLAG_N = 0x80
+
+class CPU6502:
+    def __init__(self, bus):
+        self.bus = bus
+        self.read = bus.read
+        self.write = bus.write
+        self.a = 0
+        self.x = 0
+        self.y = 0
+        self.sp = 0xFD
+        self.p = FLAG_U | FLAG_I
+        self.pc = 0
+        self.cycles = 0
+        self.ops = [None] * 256
+        self._build_table()
+
+    #=========================================================================
+    # Helpers
+    #=========================================================================
+
+    def reset(self):
+        """Load PC from the reset vector"""
+        self.sp = 0xFD
+        self.p = FLAG_U | FLAG_I
+        self.pc = self.read(0xFFFC) | (self.read(0xFFFD) << 8)
+        self.cycles += 7
+
+    def read16(self, addr):
+        return self.read(addr) | (self.read((addr + 1) & 0xFFFF) << 8)
+
+    def push(self, value):
+        self.write(0x100 | self.sp, value)
+        self.sp = (self.sp - 1) & 0xFF
+
+    def pull(self):
+        self.sp = (self.sp + 1) & 0xFF
+        return self.read(0x100 | self.sp)
+
+    def set_nz(self, value):
+        self.p = (self.p & ~(FLAG_N | FLAG_Z)) | (value & FLAG_N) | (0 if value else FLAG_Z)
+
+    def call(self, addr, return_addr=0xFFFF, max_cycles=None):
+        """Run a subroutine at addr until it returns (RTS to return_addr)
+
+        Pushes return_addr-1 like JSR would, so the subroutine's RTS lands
+        on return_addr. Returns the number of cycles spent.
+        """
+        ret = (return_addr - 1) & 0xFFFF
+        self.push(ret >> 8)
+        self.push(ret & 0xFF)
+        self.pc = addr
+        start = self.cycles
+        limit = None if max_cycles is None else start + max_cycles
+        while self.pc != return_addr:
+            self.step()
+            if limit is not None and self.cycles > limit:
+                raise CPUError(f"call ${addr:04X} exceeded {max_cycles} cycles")
+        return self.cycles - start
+
+    def step(self):
+        pc = self.pc
+        opcode = self.read(pc)
+        entry = self.ops[opcode]
+        if entry is None:
+            raise CPUError(f"undocumented opcode ${opcode:02X} at ${pc:04X}")
+        self.pc = (pc + 1) & 0xFFFF
+        handler, cycles = entry
+        self.cycles += cycles + (handler() or 0)
+
+    #=========================================================================
+    # Addressing modes: return (address, page_crossed)
+    #=========================================================================
+
+    def am_imm(self):
+        addr = self.pc
+        self.pc = (addr + 1) & 0xFFFF
+        return addr, 0
+
+    def am_zp(self):
+        addr = self.read(self.pc)
+        self.pc = (self.pc + 1) & 0xFFFF
+        return addr, 0
+
+    def am_zpx(self):
+        addr = (self.read(self.pc) + self.x) & 0xFF
+        self.pc = (self.pc + 1) & 0xFFFF
+        return addr, 0
+
+    def am_zpy(self):
+        addr = (self.read(self.pc) + self.y) & 0xFF
+        self.pc = (self.pc + 1) & 0xFFFF
+        return addr, 0
+
+    def am_abs(self):
+        addr = self.read16(self.pc)
+        self.pc = (self.pc + 2) & 0xFFFF
+        return addr, 0
+
+    def am_absx(self):
+        base = self.read16(self.pc)
+        self.pc = (self.pc + 2) & 0xFFFF
+        addr = (base + self.x) & 0xFFFF
+        return addr, (base ^ addr) >> 8 != 0
+
+    def am_absy(self):
+        base = self.read16(self.pc)
+        self.pc = (self.pc + 2) & 0xFFFF
+        addr = (base + self.y) & 0xFFFF
+        return addr, (base ^ addr) >> 8 != 0
+
+    def am_indx(self):
+        zp = (self.read(self.pc) + self.x) & 0xFF
+        self.pc = (self.pc + 1) & 0xFFFF
+        return self.read(zp) | (self.read((zp + 1) & 0xFF) << 8), 0
+
+    def am_indy(self):
+        zp = self.read(self.pc)
+        self.pc = (self.pc + 1) & 0xFFFF
+        base = self.read(zp) | (self.read((zp + 1) & 0xFF) << 8)
+        addr = (base + self.y) & 0xFFFF
+        return addr, (base ^ addr) >> 8 != 0
+
+    #=========================================================================
+    # Instruction table
+    #=========================================================================
+
+    def _build_table(self):
+        modes = {
+            'imm': self.am_imm, 'zp': self.am_zp, 'zpx': self.am_zpx,
+            'zpy': self.am_zpy, 'abs': self.am_abs, 'absx': self.am_absx,
+            'absy': self.am_absy, 'indx': self.am_indx, 'indy': self.am_indy,
+        }
+
+        def reg(opcode, cycles, handler):
+            self.ops[opcode] = (handler, cycles)
+
+        # Read instructions: (name, {mode: (opcode, cycles)}); indexed modes
+        # take one more cycle when the page is crossed
+        def read_op(fn, table):
+            for mode, (opcode, cycles) in table.items():
+                am = modes[mode]
+                def handler(am=am):
+                    addr, crossed = am()
+                    fn(self.read(addr))
+                    return 1 if crossed else 0
+                reg(opcode, cycles, handler)
+
+        def write_op(fn, table):
+            for mode, (opcode, cycles) in table.items():
+                am = modes[mode]
+                def handler(am=am):
+                    addr, _ = am()
+                    self.write(addr, fn())
+                reg(opcode, cycles, handler)
+
+        def rmw_op(fn, table, acc_opcode=None):
+            for mode, (opcode, cycles) in table.items():
+                am = modes[mode]
+                def handler(am=am):
+                    addr, _ = am()
+                    value = self.read(addr)
+                    self.write(addr, value)  # Dummy write, as on NMOS
+                    self.write(addr, fn(value))
+                reg(opcode, cycles, handler)
+            if acc_opcode is not None:
+                def acc_handler():
+                    self.a = fn(self.a)
+                reg(acc_opcode, 2, acc_handler)
+
+        std = lambda o: {  # Common layout of the ALU group
+            'imm': (o + 0x09, 2), 'zp': (o + 0x05, 3), 'zpx': (o + 0x15, 4),
+            'abs': (o + 0x0D, 4), 'absx': (o + 0x1D, 4), 'absy': (o + 0x19, 4),
+            'indx': (o + 0x01, 6), 'indy': (o + 0x11, 5),
+        }
+        rmw = lambda o: {
+            'zp': (o + 0x06, 5), 'zpx': (o + 0x16, 6),
+            'abs': (o + 0x0E, 6), 'absx': (o + 0x1E, 7),
+        }
+
+        # --- Loads / stores ---
+        def lda(v):
+            self.a = v
+            self.set_nz(v)
+        def ldx(v):
+            self.x = v
+            self.set_nz(v)
+        def ldy(v):
+            self.y = v
+            self.set_nz(v)
+        read_op(lda, std(0xA0))
+        read_op(ldx, {'imm': (0xA2, 2), 'zp': (0xA6, 3), 'zpy': (0xB6, 4),
+                      'abs': (0xAE, 4), 'absy': (0xBE, 4)})
+        read_op(ldy, {'imm': (0xA0, 2), 'zp': (0xA4, 3), 'zpx': (0xB4, 4),
+                      'abs': (0xAC, 4), 'absx': (0xBC, 4)})
+
+        sta_modes = std(0x80)
+        del sta_modes['imm']
+        sta_modes['absx'] = (0x9D, 5)
+        sta_modes['absy'] = (0x99, 5)
+        sta_modes['indy'] = (0x91, 6)
+        write_op(lambda: self.a, sta_modes)
+        write_op(lambda: self.x, {'zp': (0x86, 3), 'zpy': (0x96, 4), 'abs': (0x8E, 4)})
+        write_op(lambda: self.y, {'zp': (0x84, 3), 'zpx': (0x94, 4), 'abs': (0x8C, 4)})
+
+        # --- ALU ---
+        def ora(v):
+            self.a |= v
+            self.set_nz(self.a)
+        def and_(v):
+            self.a &= v
+            self.set_nz(self.a)
+        def eor(v):
+            self.a ^= v
+            self.set_nz(self.a)
+        read_op(ora, std(0x00))
+        read_op(and_, std(0x20))
+        read_op(eor, std(0x40))
+
+        def adc(v):
+            a = self.a
+            c = self.p & FLAG_C
+            if self.p & FLAG_D:
+                lo = (a & 0x0F) + (v & 0x0F) + c
+                hi = (a >> 4) + (v >> 4)
+                if lo > 9:
+                    lo += 6
+                if lo > 0x0F:
+                    hi += 1
+                binary = (a + v + c) & 0xFF
+                z = 0 if binary else FLAG_Z
+                n = (hi << 4) & FLAG_N
+                ov = FLAG_V if (~(a ^ v) & (a ^ (hi << 4)) & 0x80) else 0
+                if hi > 9:
+                    hi += 6
+                carry = FLAG_C if hi > 0x0F else 0
+                self.a = ((hi << 4) | (lo & 0x0F)) & 0xFF
+                self.p = (self.p & ~(FLAG_N | FLAG_Z | FLAG_V | FLAG_C)) | n | z | ov | carry
+            else:
+                r = a + v + c
+                ov = FLAG_V if (~(a ^ v) & (a ^ r) & 0x80) else 0
+                self.a = r & 0xFF
+                self.p = (self.p & ~(FLAG_V | FLAG_C)) | ov | (FLAG_C if r > 0xFF else 0)
+                self.set_nz(self.a)
+
+        def sbc(v):
+            a = self.a
+            borrow = 0 if self.p & FLAG_C else 1
+            r = a - v - borrow
+            ov = FLAG_V if ((a ^ v) & (a ^ r) & 0x80) else 0
+            if self.p & FLAG_D:
+                lo = (a & 0x0F) - (v & 0x0F) - borrow
+                hi = (a >> 4) - (v >> 4)
+                if lo < 0:
+                    lo -= 6
+                    hi -= 1
+                if hi < 0:
+                    hi -= 6
+                self.a = ((hi << 4) | (lo & 0x0F)) & 0xFF
+            else:
+                self.a = r & 0xFF
+            self.p = (self.p & ~(FLAG_V | FLAG_C)) | ov | (FLAG_C if r >= 0 else 0)
+            self.set_nz(r & 0xFF)
+
+        read_op(adc, std(0x60))
+        read_op(sbc, std(0xE0))
+
+        def compare(reg_value, v):
+            r = (reg_value - v) & 0x1FF
+            self.p = (self.p & ~FLAG_C) | (FLAG_C if reg_value >= v else 0)
+            self.set_nz(r & 0xFF)
+        read_op(lambda v: compare(self.a, v), std(0xC0))
+        read_op(lambda v: compare(self.x, v), {'imm': (0xE0, 2), 'zp': (0xE4, 3), 'abs': (0xEC, 4)})
+        read_op(lambda v: compare(self.y, v), {'imm': (0xC0, 2), 'zp': (0xC4, 3), 'abs': (0xCC, 4)})
+
+        def bit(v):
+            self.p = (self.p & ~(FLAG_N | FLAG_V | FLAG_Z)) | (v & (FLAG_N | FLAG_V)) | \
+                     (0 if (self.a & v) else FLAG_Z)
+        read_op(bit, {'zp': (0x24, 3), 'abs': (0x2C, 4)})
+
+        # --- Shifts / increments ---
+        def asl(v):
+            self.p = (self.p & ~FLAG_C) | (v >> 7)
+            v = (v << 1) & 0xFF
+            self.set_nz(v)
+            return v
+        def lsr(v):
+            self.p = (self.p & ~FLAG_C) | (v & 1)
+            v >>= 1
+            self.set_nz(v)
+            return v
+        def rol(v):
+            c = self.p & FLAG_C
+            self.p = (self.p & ~FLAG_C) | (v >> 7)
+            v = ((v << 1) | c) & 0xFF
+            self.set_nz(v)
+            return v
+        def ror(v):
+            c = self.p & FLAG_C
+            self.p = (self.p & ~FLAG_C) | (v & 1)
+            v = (v >> 1) | (c << 7)
+            self.set_nz(v)
+            return v
+        def inc(v):
+            v = (v + 1) & 0xFF
+            self.set_nz(v)
+            return v
+        def dec(v):
+            v = (v - 1) & 0xFF
+            self.set_nz(v)
+            return v
+        rmw_op(asl, rmw(0x00), 0x0A)
+        rmw_op(rol, rmw(0x20), 0x2A)
+        rmw_op(lsr, rmw(0x40), 0x4A)
+        rmw_op(ror, rmw(0x60), 0x6A)
+        rmw_op(dec, rmw(0xC0))
+        rmw_op(inc, rmw(0xE0))
+
+        # --- Register transfers / implied ---
+        def implied(opcode, fn, cycles=2):
+            reg(opcode, cycles, fn)
+
+        def tax():
+            self.x = self.a
+            self.set_nz(self.x)
+        def tay():
+            self.y = self.a
+            self.set_nz(self.y)
+        def txa():
+            self.a = self.x
+            self.set_nz(self.a)
+        def tya():
+            self.a = self.y
+            self.set_nz(self.a)
+        def tsx():
+            self.x = self.sp
+            self.set_nz(self.x)
+        def txs():
+            self.sp = self.x
+        def inx():
+            self.x = (self.x + 1) & 0xFF
+            self.set_nz(self.x)
+        def iny():
+            self.y = (self.y + 1) & 0xFF
+            self.set_nz(self.y)
+        def dex():
+            self.x = (self.x - 1) & 0xFF
+            self.set_nz(self.x)
+        def dey():
+            self.y = (self.y - 1) & 0xFF
+            self.set_nz(self.y)
+        implied(0xAA, tax)
+        implied(0xA8, tay)
+        implied(0x8A, txa)
+        implied(0x98, tya)
+        implied(0xBA, tsx)
+        implied(0x9A, txs)
+        implied(0xE8, inx)
+        implied(0xC8, iny)
+        implied(0xCA, dex)
+        implied(0x88, dey)
+        implied(0xEA, lambda: None)
+
+        def flag_op(opcode, mask, value):
+            def fn():
+                self.p = (self.p & ~mask) | value
+            implied(opcode, fn)
+        flag_op(0x18, FLAG_C, 0)
+        flag_op(0x38, FLAG_C, FLAG_C)
+        flag_op(0x58, FLAG_I, 0)
+        flag_op(0x78, FLAG_I, FLAG_I)
+        flag_op(0xB8, FLAG_V, 0)
+        flag_op(0xD8, FLAG_D, 0)
+        flag_op(0xF8, FLAG_D, FLAG_D)
+
+        # --- Stack ---
+        def pha():
+            self.push(self.a)
+        def php():
+            self.push(self.p | FLAG_B | FLAG_U)
+        def pla():
+            self.a = self.pull()
+            self.set_nz(self.a)
+        def plp():
+            self.p = (self.pull() & ~FLAG_B) | FLAG_U
+        implied(0x48, pha, 3)
+        implied(0x08, php, 3)
+        implied(0x68, pla, 4)
+        implied(0x28, plp, 4)
+
+        # --- Branches ---
+        def branch(opcode, mask, value):
+            def fn():
+                offset = self.read(self.pc)
+                self.pc = (self.pc + 1) & 0xFFFF
+                if (self.p & mask) == value:
+                    target = (self.pc + offset - (256 if offset & 0x80 else 0)) & 0xFFFF
+                    extra = 2 if (target ^ self.pc) >> 8 else 1
+                    self.pc = target
+                    return extra
+                return 0
+            reg(opcode, 2, fn)
+        branch(0x10, FLAG_N, 0)
+        branch(0x30, FLAG_N, FLAG_N)
+        branch(0x50, FLAG_V, 0)
+        branch(0x70, FLAG_V, FLAG_V)
+        branch(0x90, FLAG_C, 0)
+        branch(0xB0, FLAG_C, FLAG_C)
+        branch(0xD0, FLAG_Z, 0)
+        branch(0xF0, FLAG_Z, FLAG_Z)
+
+        # --- Jumps / subroutines ---
+        def jmp_abs():
+            self.pc = self.read16(self.pc)
+        def jmp_ind():
+            ptr = self.read16(self.pc)
+            # NMOS bug: high byte fetched from the same page
+            hi_addr = (ptr & 0xFF00) | ((ptr + 1) & 0xFF)
+            self.pc = self.read(ptr) | (self.read(hi_addr) << 8)
+        def jsr():
+            target = self.read16(self.pc)
+            ret = (self.pc + 1) & 0xFFFF
+            self.push(ret >> 8)
+            self.push(ret & 0xFF)
+            self.pc = target
+        def rts():
+            lo = self.pull()
+            hi = self.pull()
+            self.pc = (((hi << 8) | lo) + 1) & 0xFFFF
+        def rti():
+            self.p = (self.pull() & ~FLAG_B) | FLAG_U
+            lo = self.pull()
+            hi = self.pull()
+            self.pc = (hi << 8) | lo
+        def brk():
+            raise CPUError(f"BRK at ${(self.pc - 1) & 0xFFFF:04X}")
+        reg(0x4C, 3, jmp_abs)
+        reg(0x6C, 5, jmp_ind)
+        reg(0x20, 6, jsr)
+        reg(0x60, 6, rts)
+        reg(0x40, 6, rti)
+        reg(0x00, 7, brk)
+
+    def irq(self, vector=0xFFFE):
+        """Take an interrupt through vector (NMI: 0xFFFA)"""
+        if vector == 0xFFFE and self.p & FLAG_I:
+            return False
+        self.push(self.pc >> 8)
+        self.push(self.pc & 0xFF)
+        self.push((self.p | FLAG_U) & ~FLAG_B)
+        self.p |= FLAG_I
+        self.pc = self.read16(vector)
+        self.cycles += 7
+        return True
@@ -1,6 +1,6 @@
 /*
  * C64 Japanese Kanji ROM - Bitmap Rendering Benchmark
- * Oscar64 EasyFlash Version
+ * Oscar64 EasyFlash Version (REU build: PRG with the MagicDesk font cartridge)
  *
  * Measures rendering performance of bitmap mode character drawing
  * using CIA2 Timer A for cycle-accurate measurement.
@@ -15,12 +15,50 @@
  *   7. Scroll up (full 25-row scroll)
  *   8. Full screen ASCII fill (1000 chars, 32-bit accumulation)
  *   9. Full screen Kanji fill (1000 chars, 32-bit accumulation)
+ *
+ * Text mode (charset redefinition, jtxt_puts vs jtxt_puts_fast):
+ *  20. puts 10 Kanji
+ *  21. puts_fast 10 Kanji
+ *  22. puts 40 Kanji line
+ *  23. puts_fast 40 Kanji line
+ *
+ * Glyph cache build (make bench-cache, -dJTXT_GLYPH_CACHE):
+ *  14. Line fill 40 Kanji, cold cache (all misses)
+ *  15. Line fill 40 Kanji, warm cache (all hits)
+ *  16. Full screen Kanji fill with hit/miss counters
+ *
+ * SJIS index build (make bench-index, -dJTXT_SJIS_INDEX):
+ *   Tests 2, 6 and 9 rerun with the index disabled (before) and
+ *   enabled (after)
+ *
+ * Bank-grouped build (make bench-group, -dJTXT_BANK_GROUP):
+ *  24. 40 Kanji line, bputs_fast vs bputs_grouped
+ *  25. Full screen Kanji, test 13 vs bputs_grouped
+ *  26. Full screen ASCII, test 12 vs bputs_grouped
+ *
+ * Shadow buffer build (make bench-shadow, -dJTXT_SHADOW):
+ *  17. 40 Kanji line via bputs (full redraw)
+ *  18. Same line via bputs_diff (no cell changed)
+ *  19. bcommit_row with 1 of 40 cells changed
+ *
+ * REU build (make bench-reu, -dJTXT_REU): the REU and the EasyFlash RAM
+ * both sit at $DF00, so this build is a PRG that reads the fonts from the
+ * MagicDesk cartridge (crt/c64jpkanji.crt, 8KB banks)
+ *   Tests 2, 6 and 9 rerun with glyphs from cartridge ROM (before) and
+ *   REU DMA (after), tests 34-39
+ *   Test 7 (scroll, reported per scrolled line) and bcls with CPU
+ *   (before) and REU block move/fill (after), tests 40-43
+ *
+ * Headless runs (make check-bench): every case writes its number to the
+ * tag port before it runs, see benchharness/bench_harness.py
  */
 
 #include <c64/memmap.h>
 #include <c64/cia.h>
 #include <c64/vic.h>
+#ifdef JTXT_EASYFLASH
 #include <c64/easyflash.h>
+#endif
 #include <c64/keyboard.h>
 #include <string.h>
 #include "jtxt.h"
@@ -35,6 +73,16 @@
 #define COLOR_BLUE    6
 #define COLOR_YELLOW  7
 
+//=============================================================================
+// Harness tag port ($D7FE: SID register mirror, ignored by real hardware)
+//
+// benchharness/bench_harness.py attributes the CIA2 timer intervals that
+// follow a tag to that case number; BENCH_TAG_DONE ends the run.
+//=============================================================================
+
+#define BENCH_TAG(id)   POKE(0xD7FE, (id))
+#define BENCH_TAG_DONE  0xFF
+
 //=============================================================================
 // Main Region: RAM ($0900-$8000)
 //=============================================================================
@@ -317,6 +365,261 @@ static unsigned long bench_fullscreen_kanji_fast(void)
     return total;
 }
 
+#ifdef JTXT_GLYPH_CACHE
+//=============================================================================
+// Glyph cache benchmarks
+//=============================================================================
+
+// Test 14: 40 Kanji with an empty cache (every glyph fetched from ROM)
+static unsigned int bench_line_kanji_40_cold(void)
+{
+    jtxt_glyph_cache_clear();
+    return bench_line_kanji_40();
+}
+
+// Test 15: Same 40 Kanji again (every glyph served from RAM)
+static unsigned int bench_line_kanji_40_warm(void)
+{
+    return bench_line_kanji_40();
+}
+
+// Test 16: Full screen Kanji fill, counting cache hits/misses
+static unsigned long bench_fullscreen_kanji_cache(void)
+{
+    jtxt_glyph_cache_clear();
+    jtxt_glyph_cache_reset_stats();
+    return bench_fullscreen_kanji();
+}
+#endif
+
+#ifdef JTXT_SHADOW
+//=============================================================================
+// Shadow buffer benchmarks
+//=============================================================================
+
+static jtxt_line_t staged_line;
+
+// Test 17: Full 40-kanji line redraw via bputs
+static unsigned int bench_shadow_bputs(void)
+{
+    jtxt_blocate(0, 24);
+    timer_start();
+    jtxt_bputs(kanji_line_40);
+    return timer_stop();
+}
+
+// Test 18: Same line via bputs_diff (every cell unchanged)
+static unsigned int bench_shadow_bputs_diff(void)
+{
+    jtxt_blocate(0, 24);
+    timer_start();
+    jtxt_bputs_diff(kanji_line_40);
+    return timer_stop();
+}
+
+// Test 19: Commit staged row with a single changed cell
+static unsigned int bench_shadow_commit_row(void)
+{
+    jtxt_bline_clear(&staged_line, jtxt_state.bitmap_color);
+    jtxt_bline_puts(&staged_line, 0, kanji_line_40, jtxt_state.bitmap_color);
+    staged_line.code[20] = 0x8ABF;  // "漢"
+    timer_start();
+    jtxt_bcommit_row(24, &staged_line);
+    return timer_stop();
+}
+#endif
+
+#ifdef JTXT_SJIS_INDEX
+//=============================================================================
+// SJIS index before/after (tests 2, 6, 9)
+//=============================================================================
+
+static unsigned int idx_r2[2], idx_r6[2];
+static unsigned long idx_r9[2];
+
+// Run tests 2/6/9 with arithmetic lookup [0] and index lookup [1]
+static void bench_sjis_index(void)
+{
+    unsigned char i;
+    unsigned char ready = jtxt_sjis_index_ready;
+
+    for (i = 0; i < 2; i++) {
+        jtxt_sjis_index_ready = i ? ready : 0;
+#ifdef JTXT_GLYPH_CACHE
+        // Every lookup must reach ROM for a fair comparison
+        jtxt_glyph_cache_clear();
+#endif
+        BENCH_TAG(i ? 31 : 28);
+        idx_r2[i] = bench_draw_kanji_1();
+#ifdef JTXT_GLYPH_CACHE
+        jtxt_glyph_cache_clear();
+#endif
+        BENCH_TAG(i ? 32 : 29);
+        idx_r6[i] = bench_line_kanji_40();
+        BENCH_TAG(i ? 33 : 30);
+        idx_r9[i] = bench_fullscreen_kanji();
+    }
+    jtxt_sjis_index_ready = ready;
+}
+#endif
+
+#ifdef JTXT_REU
+//=============================================================================
+// REU glyph DMA before/after (tests 2, 6, 9)
+//=============================================================================
+
+static unsigned int reu_r2[2], reu_r6[2], reu_r7[2], reu_cls[2];
+static unsigned long reu_r9[2];
+
+// bcls of the whole screen (25 rows)
+static unsigned int bench_bcls(void)
+{
+    timer_start();
+    jtxt_bcls();
+    return timer_stop();
+}
+
+// Run tests 2/6/9, scroll and bcls with CPU/ROM [0] and REU [1]
+static void bench_reu(void)
+{
+    unsigned char i;
+    unsigned char ready = jtxt_reu_ready;
+
+    for (i = 0; i < 2; i++) {
+        jtxt_reu_ready = i ? ready : 0;
+#ifdef JTXT_GLYPH_CACHE
+        jtxt_glyph_cache_clear();
+#endif
+        BENCH_TAG(i ? 37 : 34);
+        reu_r2[i] = bench_draw_kanji_1();
+#ifdef JTXT_GLYPH_CACHE
+        jtxt_glyph_cache_clear();
+#endif
+        BENCH_TAG(i ? 38 : 35);
+        reu_r6[i] = bench_line_kanji_40();
+        BENCH_TAG(i ? 39 : 36);
+        reu_r9[i] = bench_fullscreen_kanji();
+        BENCH_TAG(i ? 41 : 40);
+        reu_r7[i] = bench_scroll_up();
+        BENCH_TAG(i ? 43 : 42);
+        reu_cls[i] = bench_bcls();
+    }
+    jtxt_reu_ready = ready;
+}
+#endif
+
+#if defined(JTXT_SJIS_INDEX) || defined(JTXT_BANK_GROUP) || defined(JTXT_REU)
+// Display one before/after row: label, before, after, saved
+static void put_index_row(unsigned char y, const char *label,
+                          unsigned long before, unsigned long after)
+{
+    jtxt_blocate(0, y);
+    jtxt_bputs(label);
+    jtxt_blocate(6, y);
+    put_uint32(before);
+    jtxt_blocate(13, y);
+    put_uint32(after);
+    jtxt_blocate(20, y);
+    put_uint32(before > after ? before - after : 0);
+}
+#endif
+
+#ifdef JTXT_BANK_GROUP
+//=============================================================================
+// Bank-grouped compositor (tests 24-26)
+//=============================================================================
+
+// Test 24: 40 Kanji line via bputs_grouped (compare: bputs_fast)
+static unsigned int bench_line_kanji_40_fast(void)
+{
+    jtxt_blocate(0, 24);
+    timer_start();
+    jtxt_bputs_fast(kanji_line_40);
+    return timer_stop();
+}
+
+static unsigned int bench_line_kanji_40_grouped(void)
+{
+    jtxt_blocate(0, 24);
+    timer_start();
+    jtxt_bputs_grouped(kanji_line_40);
+    return timer_stop();
+}
+
+// Test 25: Full screen Kanji via bputs_grouped (compare: test 13)
+static unsigned long bench_fullscreen_kanji_grouped(void)
+{
+    unsigned long total = 0;
+    unsigned char y;
+
+    for (y = 0; y < 25; y++) {
+        timer_start();
+        jtxt_blocate(0, y);
+        jtxt_bputs_grouped(kanji_line_40);
+        total += timer_stop();
+    }
+    return total;
+}
+
+// Test 26: Full screen ASCII via bputs_grouped (compare: test 12)
+static unsigned long bench_fullscreen_ascii_grouped(void)
+{
+    unsigned long total = 0;
+    unsigned char y;
+
+    for (y = 0; y < 25; y++) {
+        timer_start();
+        jtxt_blocate(0, y);
+        jtxt_bputs_grouped(ascii_line_40);
+        total += timer_stop();
+    }
+    return total;
+}
+#endif
+
+//=============================================================================
+// Text mode tests: puts vs puts_fast
+// Each test starts from an empty screen so every character defines a slot.
+//=============================================================================
+
+// Test 20: 10 Kanji chars via puts
+static unsigned int bench_puts_kanji_10(void)
+{
+    jtxt_cls();
+    timer_start();
+    jtxt_puts("\x82\xa0\x82\xa2\x82\xa4\x82\xa6\x82\xa8"
+              "\x82\xa9\x82\xab\x82\xad\x82\xaf\x82\xb1");
+    return timer_stop();
+}
+
+// Test 21: 10 Kanji chars via puts_fast
+static unsigned int bench_puts_fast_kanji_10(void)
+{
+    jtxt_cls();
+    timer_start();
+    jtxt_puts_fast("\x82\xa0\x82\xa2\x82\xa4\x82\xa6\x82\xa8"
+                   "\x82\xa9\x82\xab\x82\xad\x82\xaf\x82\xb1");
+    return timer_stop();
+}
+
+// Test 22: 40 Kanji line via puts
+static unsigned int bench_puts_kanji_40(void)
+{
+    jtxt_cls();
+    timer_start();
+    jtxt_puts(kanji_line_40);
+    return timer_stop();
+}
+
+// Test 23: 40 Kanji line via puts_fast
+static unsigned int bench_puts_fast_kanji_40(void)
+{
+    jtxt_cls();
+    timer_start();
+    jtxt_puts_fast(kanji_line_40);
+    return timer_stop();
+}
+
 //=============================================================================
 // Main
 //=============================================================================
@@ -327,8 +630,12 @@ int main(void)
     unsigned long r8, r9;
     unsigned int r10, r11;
     unsigned long r12, r13;
+#ifdef JTXT_GLYPH_CACHE
+    unsigned int r14, r15;
+    unsigned long r16;
+#endif
 
-    // Hardware initialization (EasyFlash, no KERNAL)
+    // Hardware initialization (EasyFlash: no KERNAL; PRG: KERNAL IRQs off)
     mmap_set(MMAP_ROM);
     cia_init();
     vic_setmode(VICM_TEXT, (char *)0x0400, (char *)0x1800);
@@ -362,11 +669,17 @@ int main(void)
 
     POKE(0xD020, COLOR_RED);    // Visual: red border during bench
 
+    BENCH_TAG(1);
     r1 = bench_draw_ascii_1();
+    BENCH_TAG(2);
     r2 = bench_draw_kanji_1();
+    BENCH_TAG(3);
     r3 = bench_bputs_ascii_10();
+    BENCH_TAG(4);
     r4 = bench_bputs_kanji_10();
+    BENCH_TAG(5);
     r5 = bench_line_ascii_40();
+    BENCH_TAG(6);
     r6 = bench_line_kanji_40();
 
     // Fill screen with data for scroll test
@@ -377,10 +690,13 @@ int main(void)
             jtxt_bputs("SCROLL TEST DATA 0123456789");
         }
     }
+    BENCH_TAG(7);
     r7 = bench_scroll_up();
 
     // Phase 3: bputs_fast tests
+    BENCH_TAG(10);
     r10 = bench_bputs_fast_ascii_10();
+    BENCH_TAG(11);
     r11 = bench_bputs_fast_kanji_10();
 
     POKE(0xD020, COLOR_BLACK);
@@ -499,6 +815,7 @@ int main(void)
     jtxt_bputs("RUNNING ASCII FILL...");
 
     POKE(0xD020, COLOR_RED);
+    BENCH_TAG(8);
     r8 = bench_fullscreen_ascii();
     POKE(0xD020, COLOR_BLACK);
 
@@ -510,6 +827,7 @@ int main(void)
     jtxt_bputs("RUNNING KANJI FILL...");
 
     POKE(0xD020, COLOR_GREEN);
+    BENCH_TAG(9);
     r9 = bench_fullscreen_kanji();
     POKE(0xD020, COLOR_BLACK);
 
@@ -621,6 +939,7 @@ int main(void)
     jtxt_bputs("RUNNING FAST ASCII FILL...");
 
     POKE(0xD020, COLOR_RED);
+    BENCH_TAG(12);
     r12 = bench_fullscreen_ascii_fast();
     POKE(0xD020, COLOR_BLACK);
 
@@ -630,6 +949,7 @@ int main(void)
     jtxt_bputs("RUNNING FAST KANJI FILL...");
 
     POKE(0xD020, COLOR_GREEN);
+    BENCH_TAG(13);
     r13 = bench_fullscreen_kanji_fast();
     POKE(0xD020, COLOR_BLACK);
 
@@ -762,8 +1082,408 @@ int main(void)
     jtxt_blocate(14, 22);
     put_uint16(r4 / 10 - r11 / 10);
 
+    jtxt_blocate(0, 24);
+    jtxt_bputs("PRESS SPACE FOR TEXT MODE PAGE");
+
+    wait_space();
+
+    //=========================================================================
+    // Text mode page: puts vs puts_fast
+    //=========================================================================
+
+    {
+        unsigned int t20, t21, t22, t23;
+
+        // Switch to text mode (copies the ROM charset to $3000)
+        jtxt_init(JTXT_TEXT_MODE);
+        jtxt_set_color(COLOR_WHITE);
+
+        POKE(0xD020, COLOR_RED);
+        BENCH_TAG(20);
+        t20 = bench_puts_kanji_10();
+        BENCH_TAG(21);
+        t21 = bench_puts_fast_kanji_10();
+        BENCH_TAG(22);
+        t22 = bench_puts_kanji_40();
+        BENCH_TAG(23);
+        t23 = bench_puts_fast_kanji_40();
+        POKE(0xD020, COLOR_BLACK);
+
+        // Back to bitmap mode to show results
+        jtxt_init(JTXT_BITMAP_MODE);
+        jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+
+        jtxt_blocate(0, 0);
+        jtxt_bputs("=== TEXT MODE (CYC) ===");
+
+        jtxt_blocate(0, 2);
+        jtxt_bputs("           TOTAL  /CH");
+
+        jtxt_blocate(0, 3);
+        jtxt_bputs("20 PUTS  10");
+        jtxt_blocate(11, 3);
+        put_uint16(t20);
+        jtxt_blocate(17, 3);
+        put_uint16(t20 / 10);
+
+        jtxt_blocate(0, 4);
+        jtxt_bputs("21 FAST  10");
+        jtxt_blocate(11, 4);
+        put_uint16(t21);
+        jtxt_blocate(17, 4);
+        put_uint16(t21 / 10);
+
+        jtxt_blocate(0, 5);
+        jtxt_bputs("22 PUTS  40");
+        jtxt_blocate(11, 5);
+        put_uint16(t22);
+        jtxt_blocate(17, 5);
+        put_uint16(t22 / 40);
+
+        jtxt_blocate(0, 6);
+        jtxt_bputs("23 FAST  40");
+        jtxt_blocate(11, 6);
+        put_uint16(t23);
+        jtxt_blocate(17, 6);
+        put_uint16(t23 / 40);
+
+        jtxt_blocate(0, 8);
+        jtxt_bputs("SAVED KNJ/CH:");
+        jtxt_blocate(14, 8);
+        put_uint16(t22 > t23 ? (t22 - t23) / 40 : 0);
+    }
+
+#ifdef JTXT_GLYPH_CACHE
+    jtxt_blocate(0, 24);
+    jtxt_bputs("PRESS SPACE FOR CACHE PAGE");
+
+    wait_space();
+
+    //=========================================================================
+    // Glyph cache page
+    //=========================================================================
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    jtxt_blocate(0, 0);
+    jtxt_bputs("RUNNING GLYPH CACHE TESTS...");
+
+    POKE(0xD020, COLOR_RED);
+    BENCH_TAG(14);
+    r14 = bench_line_kanji_40_cold();
+    BENCH_TAG(15);
+    r15 = bench_line_kanji_40_warm();
+    POKE(0xD020, COLOR_GREEN);
+    BENCH_TAG(16);
+    r16 = bench_fullscreen_kanji_cache();
+    POKE(0xD020, COLOR_BLACK);
+
+    // Snapshot counters before result display adds its own lookups
+    {
+        unsigned int hits = jtxt_glyph_cache_hits;
+        unsigned int misses = jtxt_glyph_cache_misses;
+        unsigned int lookups = hits + misses;
+        unsigned int saved_ch = r14 / 40 - r15 / 40;
+
+        jtxt_bcls();
+        jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+
+        jtxt_blocate(0, 0);
+        jtxt_bputs("=== GLYPH CACHE ===");
+        jtxt_blocate(0, 1);
+        jtxt_bputs("ENTRIES:");
+        jtxt_blocate(14, 1);
+        put_uint16(JTXT_GLYPH_CACHE_SIZE);
+
+        jtxt_blocate(0, 3);
+        jtxt_bputs("--- LINE KNJ x40 ---");
+
+        jtxt_blocate(0, 4);
+        jtxt_bputs("         TOTAL  /CH");
+
+        jtxt_blocate(0, 5);
+        jtxt_bputs("COLD");
+        jtxt_blocate(10, 5);
+        put_uint16(r14);
+        jtxt_blocate(16, 5);
+        put_uint16(r14 / 40);
+
+        jtxt_blocate(0, 6);
+        jtxt_bputs("WARM");
+        jtxt_blocate(10, 6);
+        put_uint16(r15);
+        jtxt_blocate(16, 6);
+        put_uint16(r15 / 40);
+
+        jtxt_blocate(0, 8);
+        jtxt_bputs("--- FULL SCREEN KNJ ---");
+
+        jtxt_blocate(0, 9);
+        jtxt_bputs("          TOTAL   /CH");
+
+        jtxt_blocate(0, 10);
+        jtxt_bputs("NO CACHE");
+        jtxt_blocate(9, 10);
+        put_uint32(r9);
+        jtxt_blocate(17, 10);
+        put_uint16((unsigned int)(r9 / 1000));
+
+        jtxt_blocate(0, 11);
+        jtxt_bputs("CACHE");
+        jtxt_blocate(9, 11);
+        put_uint32(r16);
+        jtxt_blocate(17, 11);
+        put_uint16((unsigned int)(r16 / 1000));
+
+        jtxt_blocate(0, 13);
+        jtxt_bputs("HITS    :");
+        jtxt_blocate(14, 13);
+        put_uint16(hits);
+
+        jtxt_blocate(0, 14);
+        jtxt_bputs("MISSES  :");
+        jtxt_blocate(14, 14);
+        put_uint16(misses);
+
+        jtxt_blocate(0, 15);
+        jtxt_bputs("HIT RATE:");
+        jtxt_blocate(14, 15);
+        put_uint16(lookups ? (unsigned int)((unsigned long)hits * 100 / lookups) : 0);
+        jtxt_bputs(" %");
+
+        // Cycles saved = hits x (miss cost - hit cost) per char
+        jtxt_blocate(0, 17);
+        jtxt_bputs("SAVED/HIT:");
+        jtxt_blocate(14, 17);
+        put_uint16(saved_ch);
+        jtxt_bputs(" CYC");
+
+        jtxt_blocate(0, 18);
+        jtxt_bputs("SAVED    :");
+        jtxt_blocate(12, 18);
+        put_uint32((unsigned long)hits * saved_ch);
+        jtxt_bputs(" CYC");
+    }
+#endif
+
+#ifdef JTXT_SHADOW
+    jtxt_blocate(0, 24);
+    jtxt_bputs("PRESS SPACE FOR SHADOW PAGE");
+
+    wait_space();
+
+    //=========================================================================
+    // Shadow buffer page
+    //=========================================================================
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    jtxt_blocate(0, 0);
+    jtxt_bputs("RUNNING SHADOW TESTS...");
+
+    {
+        unsigned int s17, s18, s19;
+
+        POKE(0xD020, COLOR_RED);
+        BENCH_TAG(17);
+        s17 = bench_shadow_bputs();
+        BENCH_TAG(18);
+        s18 = bench_shadow_bputs_diff();
+        BENCH_TAG(19);
+        s19 = bench_shadow_commit_row();
+        POKE(0xD020, COLOR_BLACK);
+
+        jtxt_bcls();
+        jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+
+        jtxt_blocate(0, 0);
+        jtxt_bputs("=== SHADOW BUFFER (CYC) ===");
+
+        jtxt_blocate(0, 2);
+        jtxt_bputs("           TOTAL  /CH");
+
+        jtxt_blocate(0, 3);
+        jtxt_bputs("17 BPUTS");
+        jtxt_blocate(11, 3);
+        put_uint16(s17);
+        jtxt_blocate(17, 3);
+        put_uint16(s17 / 40);
+
+        jtxt_blocate(0, 4);
+        jtxt_bputs("18 DIFF");
+        jtxt_blocate(11, 4);
+        put_uint16(s18);
+        jtxt_blocate(17, 4);
+        put_uint16(s18 / 40);
+
+        jtxt_blocate(0, 5);
+        jtxt_bputs("19 COMMIT");
+        jtxt_blocate(11, 5);
+        put_uint16(s19);
+        jtxt_blocate(17, 5);
+        put_uint16(s19 / 40);
+
+        jtxt_blocate(0, 7);
+        jtxt_bputs("SAVED DIFF  :");
+        jtxt_blocate(14, 7);
+        put_uint16(s17 > s18 ? s17 - s18 : 0);
+
+        jtxt_blocate(0, 8);
+        jtxt_bputs("SAVED COMMIT:");
+        jtxt_blocate(14, 8);
+        put_uint16(s17 > s19 ? s17 - s19 : 0);
+    }
+#endif
+
+#ifdef JTXT_SJIS_INDEX
+    jtxt_blocate(0, 24);
+    jtxt_bputs("PRESS SPACE FOR INDEX PAGE");
+
+    wait_space();
+
+    //=========================================================================
+    // SJIS index page: tests 2, 6, 9 before/after
+    //=========================================================================
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    jtxt_blocate(0, 0);
+    jtxt_bputs("RUNNING SJIS INDEX TESTS...");
+
+    POKE(0xD020, COLOR_RED);
+    bench_sjis_index();
+    POKE(0xD020, COLOR_BLACK);
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+
+    jtxt_blocate(0, 0);
+    jtxt_bputs("=== SJIS INDEX (CYC) ===");
+
+    if (!jtxt_sjis_index_ready) {
+        jtxt_blocate(0, 2);
+        jtxt_bputs("INDEX NOT FOUND IN BANK");
+        jtxt_blocate(24, 2);
+        jtxt_bput_dec2(JTXT_SJIS_INDEX_BANK);
+    } else {
+        jtxt_blocate(0, 2);
+        jtxt_bputs("TEST   BEFORE  AFTER  SAVED");
+
+        put_index_row(4, "2 x1", idx_r2[0], idx_r2[1]);
+        put_index_row(5, "6 x40", idx_r6[0], idx_r6[1]);
+        put_index_row(6, "9 FUL", idx_r9[0], idx_r9[1]);
+
+        jtxt_blocate(0, 8);
+        jtxt_bputs("--- PER CHAR ---");
+
+        put_index_row(9, "6 /CH", idx_r6[0] / 40, idx_r6[1] / 40);
+        put_index_row(10, "9 /CH", idx_r9[0] / 1000, idx_r9[1] / 1000);
+    }
+#endif
+
+#ifdef JTXT_BANK_GROUP
+    jtxt_blocate(0, 24);
+    jtxt_bputs("PRESS SPACE FOR GROUP PAGE");
+
+    wait_space();
+
+    //=========================================================================
+    // Bank-grouped compositor page: bputs_fast (before) vs grouped (after)
+    //=========================================================================
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    jtxt_blocate(0, 0);
+    jtxt_bputs("RUNNING BANK GROUP TESTS...");
+
+    {
+        unsigned int g24f, g24g;
+        unsigned long g25, g26;
+
+        POKE(0xD020, COLOR_RED);
+        BENCH_TAG(27);
+        g24f = bench_line_kanji_40_fast();
+        BENCH_TAG(24);
+        g24g = bench_line_kanji_40_grouped();
+        BENCH_TAG(25);
+        g25 = bench_fullscreen_kanji_grouped();
+        BENCH_TAG(26);
+        g26 = bench_fullscreen_ascii_grouped();
+        POKE(0xD020, COLOR_BLACK);
+
+        jtxt_bcls();
+        jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+
+        jtxt_blocate(0, 0);
+        jtxt_bputs("=== BANK GROUP (CYC) ===");
+
+        jtxt_blocate(0, 2);
+        jtxt_bputs("TEST   FAST    GROUP  SAVED");
+
+        put_index_row(4, "24 x40", g24f, g24g);
+        put_index_row(5, "25 KNJ", r13, g25);
+        put_index_row(6, "26 ASC", r12, g26);
+
+        jtxt_blocate(0, 8);
+        jtxt_bputs("--- PER CHAR ---");
+
+        put_index_row(9, "24 /CH", g24f / 40, g24g / 40);
+        put_index_row(10, "25 /CH", r13 / 1000, g25 / 1000);
+        put_index_row(11, "26 /CH", r12 / 1000, g26 / 1000);
+    }
+#endif
+
+#ifdef JTXT_REU
+    jtxt_blocate(0, 24);
+    jtxt_bputs("PRESS SPACE FOR REU PAGE");
+
+    wait_space();
+
+    //=========================================================================
+    // REU page: tests 2, 6, 9 with ROM glyphs vs REU DMA
+    //=========================================================================
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    jtxt_blocate(0, 0);
+    jtxt_bputs("RUNNING REU TESTS...");
+
+    POKE(0xD020, COLOR_RED);
+    bench_reu();
+    POKE(0xD020, COLOR_BLACK);
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+
+    jtxt_blocate(0, 0);
+    jtxt_bputs("=== REU GLYPH DMA (CYC) ===");
+
+    if (!jtxt_reu_ready) {
+        jtxt_blocate(0, 2);
+        jtxt_bputs("REU NOT FOUND");
+    } else {
+        jtxt_blocate(0, 2);
+        jtxt_bputs("TEST   ROM     REU    SAVED");
+
+        put_index_row(4, "2 x1", reu_r2[0], reu_r2[1]);
+        put_index_row(5, "6 x40", reu_r6[0], reu_r6[1]);
+        put_index_row(6, "9 FUL", reu_r9[0], reu_r9[1]);
+        put_index_row(7, "7 SCR", reu_r7[0], reu_r7[1]);
+        put_index_row(8, "CLS", reu_cls[0], reu_cls[1]);
+
+        jtxt_blocate(0, 10);
+        jtxt_bputs("--- PER CHAR / LINE ---");
+
+        put_index_row(11, "6 /CH", reu_r6[0] / 40, reu_r6[1] / 40);
+        put_index_row(12, "9 /CH", reu_r9[0] / 1000, reu_r9[1] / 1000);
+        put_index_row(13, "7 /LN", reu_r7[0] / 24, reu_r7[1] / 24);
+        put_index_row(14, "CL/LN", reu_cls[0] / 25, reu_cls[1] / 25);
+    }
+#endif
+
     jtxt_blocate(0, 24);
     jtxt_bputs("BENCHMARK COMPLETE");
+    BENCH_TAG(BENCH_TAG_DONE);
 
     // Halt
     while (1) {}
@@ -771,6 +1491,7 @@ int main(void)
     return 0;
 }
 
+#ifdef JTXT_EASYFLASH
 //=============================================================================
 // Bank 1: JIS X 0201 Half-width Font (2KB) + Misaki Gothic Part 1 (14KB)
 //=============================================================================
@@ -844,3 +1565,30 @@ __export const unsigned char font_gothic_4[] = {
 };
 
 #pragma data( data )
+
+#ifdef JTXT_SJIS_INDEX
+//=============================================================================
+// Banks 6-7: SJIS glyph index (create_crt.py --sjis-index-out)
+//=============================================================================
+
+#pragma section( idx6, 0 )
+#pragma region(sjisidx6, 0x8000, 0xc000, , 6, { idx6 })
+#pragma data( idx6 )
+
+__export const unsigned char sjis_index_0[] = {
+    #embed 16384 0 "sjis_index_ef.bin"
+};
+
+#pragma data( data )
+
+#pragma section( idx7, 0 )
+#pragma region(sjisidx7, 0x8000, 0xc000, , 7, { idx7 })
+#pragma data( idx7 )
+
+__export const unsigned char sjis_index_1[] = {
+    #embed 16384 16384 "sjis_index_ef.bin"
+};
+
+#pragma data( data )
+#endif
+#endif // JTXT_EASYFLASH
@@ -0,0 +1,655 @@
+/*
+ * C64 Japanese Kanji ROM - IME Search and Terminal Receive Benchmark
+ * Oscar64 EasyFlash Version
+ *
+ * Measures the dictionary lookups of the IME and the terminal's receive
+ * path (Telnet filter, ANSI parser, jtxt drawing) without keyboard input
+ * or a network connection, using CIA2 Timer A for cycle counting.
+ *
+ * Tests:
+ *  44. Pre-search lookups (verb + noun) for 16 readings in the dictionary
+ *  45. Same for 8 readings with no entry
+ *  46. 20 lines of plain SJIS text through term_recv_process
+ *  47. 20 lines with SGR colors, cursor moves, erase, BS erase patterns
+ *      and Telnet IAC NOP / IAC IAC
+ *
+ * The memory layout is the EasyFlash terminal's (code $0900-$5BFF, BSS
+ * $C000-$CFFF, fonts in banks 1-5, version 3 dictionary in banks 6-18),
+ * so the lookups see the same bank switching as in the terminal.
+ *
+ * Headless runs (make check-bench): every case writes its number to the
+ * tag port before it runs, see benchharness/bench_harness.py
+ */
+
+#include <c64/memmap.h>
+#include <c64/cia.h>
+#include <c64/vic.h>
+#include <c64/easyflash.h>
+#include <c64/keyboard.h>
+#include <string.h>
+#include "c64_oscar.h"
+#include "jtxt.h"
+#include "ime.h"
+#include "telnet.h"
+#include "term_recv.h"
+
+//=============================================================================
+// Harness tag port ($D7FE: SID register mirror, ignored by real hardware)
+//=============================================================================
+
+#define BENCH_TAG(id)   POKE(0xD7FE, (id))
+#define BENCH_TAG_DONE  0xFF
+
+//=============================================================================
+// Memory layout: same regions as the EasyFlash terminal (term_main.c)
+//=============================================================================
+
+#pragma region(main, 0x0900, 0x5C00, , , { code, data, stack, heap })
+#pragma region(extra, 0xC000, 0xD000, , , { bss })
+
+jtxt_state_t jtxt_state;
+
+//=============================================================================
+// CIA2 Timer A for cycle counting ($DD04/$DD05/$DD0E)
+//
+// One dictionary lookup can take longer than 65535 cycles, so Timer B
+// counts the Timer A underflows and the two make a 32-bit count. The
+// harness measures the Timer A start/stop interval itself.
+//=============================================================================
+
+// Start CIA2 Timer A counting down from $FFFF, Timer B counting its underflows
+static void timer_start(void)
+{
+    // Stop both timers first
+    *(volatile unsigned char *)0xDD0E &= 0xFE;
+    *(volatile unsigned char *)0xDD0F &= 0xFE;
+    // Set both latches to $FFFF
+    *(volatile unsigned char *)0xDD04 = 0xFF;
+    *(volatile unsigned char *)0xDD05 = 0xFF;
+    *(volatile unsigned char *)0xDD06 = 0xFF;
+    *(volatile unsigned char *)0xDD07 = 0xFF;
+    // Timer B: force load (bit4) + start (bit0), count Timer A underflows (bit6)
+    *(volatile unsigned char *)0xDD0F = 0x51;
+    // Timer A: force load (bit4) + start continuous (bit0), count PHI2
+    *(volatile unsigned char *)0xDD0E = 0x11;
+}
+
+// Stop both timers and return elapsed cycles
+static unsigned long timer_stop(void)
+{
+    unsigned char ahi, alo, bhi, blo;
+
+    // Stop Timer A first: Timer B no longer sees underflows
+    *(volatile unsigned char *)0xDD0E &= 0xFE;
+    *(volatile unsigned char *)0xDD0F &= 0xFE;
+    ahi = *(volatile unsigned char *)0xDD05;
+    alo = *(volatile unsigned char *)0xDD04;
+    bhi = *(volatile unsigned char *)0xDD07;
+    blo = *(volatile unsigned char *)0xDD06;
+    return ((unsigned long)(0xFFFFu - (((unsigned int)bhi << 8) | blo)) << 16) |
+           (0xFFFFu - (((unsigned int)ahi << 8) | alo));
+}
+
+//=============================================================================
+// Display utilities
+//=============================================================================
+
+// Display right-aligned 5-digit decimal number
+static void put_uint16(unsigned int num)
+{
+    char buf[6];
+    signed char i;
+    buf[5] = 0;
+
+    for (i = 4; i >= 0; i--) {
+        if (num > 0 || i == 4) {
+            buf[i] = '0' + (unsigned char)(num % 10);
+            num /= 10;
+        } else {
+            buf[i] = ' ';
+        }
+    }
+    jtxt_bputs(buf);
+}
+
+// Display right-aligned 9-digit decimal number (for 32-bit values)
+static void put_uint32(unsigned long num)
+{
+    char buf[10];
+    signed char i;
+    buf[9] = 0;
+
+    for (i = 8; i >= 0; i--) {
+        if (num > 0 || i == 8) {
+            buf[i] = '0' + (unsigned char)(num % 10);
+            num /= 10;
+        } else {
+            buf[i] = ' ';
+        }
+    }
+    jtxt_bputs(buf);
+}
+
+// Wait for SPACE key press and release
+static void wait_space(void)
+{
+    while (true) {
+        keyb_poll();
+        if (key_pressed(KSCAN_SPACE)) break;
+    }
+    while (true) {
+        keyb_poll();
+        if (!key_pressed(KSCAN_SPACE)) break;
+    }
+}
+
+//=============================================================================
+// IME lookup keys (Shift-JIS hiragana readings)
+//=============================================================================
+
+#define LOOKUP_WORDS   16
+#define LOOKUP_UNKNOWN 8
+
+// Readings with entries in dicconv/skkdic.txt (nouns, and verbs with okurigana)
+static const char * const lookup_words[LOOKUP_WORDS] = {
+    "\x82\xa9\x82\xf1\x82\xb6",                  // かんじ
+    "\x82\xd6\x82\xf1\x82\xa9\x82\xf1",          // へんかん
+    "\x82\xaa\x82\xc1\x82\xb1\x82\xa4",          // がっこう
+    "\x82\xc5\x82\xf1\x82\xb5\x82\xe1",          // でんしゃ
+    "\x82\xb9\x82\xf1\x82\xb9\x82\xa2",          // せんせい
+    "\x82\xa9\x82\xa2\x82\xb5\x82\xe1",          // かいしゃ
+    "\x82\xb6\x82\xb5\x82\xe5",                  // じしょ
+    "\x82\xc9\x82\xe3\x82\xa4\x82\xe8\x82\xe5\x82\xad", // にゅうりょく
+    "\x82\xd0\x82\xe7\x82\xaa\x82\xc8",          // ひらがな
+    "\x82\xb5\x82\xf1\x82\xd4\x82\xf1",          // しんぶん
+    "\x82\xc4\x82\xaa\x82\xdd",                  // てがみ
+    "\x82\xc5\x82\xf1\x82\xed",                  // でんわ
+    "\x82\xc4\x82\xa2\x82\xb5\x82\xe3\x82\xc2",  // ていしゅつ
+    "\x82\xa9\x82\xad",                          // かく
+    "\x82\xe6\x82\xde",                          // よむ
+    "\x82\xbd\x82\xd7\x82\xe9",                  // たべる
+};
+
+// Readings with no entry: the search runs to the end of the group
+static const char * const lookup_unknown[LOOKUP_UNKNOWN] = {
+    "\x82\xca\x82\xca\x82\xca\x82\xca\x82\xca",  // ぬぬぬぬぬ
+    "\x82\xdb\x82\xdb\x82\xdb\x82\xdb",          // ぽぽぽぽ
+    "\x82\xef\x82\xef\x82\xef",                  // ゑゑゑ
+    "\x82\xc0\x82\xc0\x82\xc0\x82\xc0",          // ぢぢぢぢ
+    "\x82\xd8\x82\xd8\x82\xd8\x82\xd8\x82\xd8",  // ぺぺぺぺぺ
+    "\x82\xd2\x82\xd2\x82\xd2\x82\xd2",          // ぴぴぴぴ
+    "\x82\xc3\x82\xc3\x82\xc3\x82\xc3",          // づづづづ
+    "\x82\xee\x82\xee\x82\xee\x82\xee",          // ゐゐゐゐ
+};
+
+//=============================================================================
+// Received data (Shift-JIS, CRLF line ends, as a BBS sends it)
+//=============================================================================
+
+// Plain text: kanji, kana, half-width kana and ASCII
+static const char recv_text[] =
+    // C64JP BBS  -  Welcome, guest!
+    "C64JP BBS  -  Welcome, guest!\x0d\x0a"
+    // 漢字の表示テストです。
+    "\x8a\xbf\x8e\x9a\x82\xcc\x95\x5c\x8e\xa6\x83" "e\x83X\x83g\x82"
+    "\xc5\x82\xb7\x81" "B\x0d\x0a"
+    // Today: 2026-10-16  Users online: 12
+    "Today: 2026-10-16  Users online: 12\x0d\x0a"
+    // 新着メッセージは３件あります。
+    "\x90V\x92\x85\x83\x81\x83" "b\x83Z\x81[\x83W\x82\xcd\x82R\x8c"
+    "\x8f\x82\xa0\x82\xe8\x82\xdc\x82\xb7\x81" "B\x0d\x0a"
+    // [1] 日本語入力について
+    "[1] \x93\xfa\x96{\x8c\xea\x93\xfc\x97\xcd\x82\xc9\x82\xc2\x82"
+    "\xa2\x82\xc4\x0d\x0a"
+    // [2] ファイル転送の使い方
+    "[2] \x83t\x83@\x83" "C\x83\x8b\x93]\x91\x97\x82\xcc\x8eg\x82"
+    "\xa2\x95\xfb\x0d\x0a"
+    // [3] 掲示板の規則
+    "[3] \x8c" "f\x8e\xa6\x94\xc2\x82\xcc\x8bK\x91\xa5\x0d\x0a"
+    // ------------------------------
+    "------------------------------\x0d\x0a"
+    // 本日の話題：ＸＭＯＤＥＭで送信
+    "\x96{\x93\xfa\x82\xcc\x98" "b\x91\xe8\x81" "F\x82w\x82l\x82n"
+    "\x82" "c\x82" "d\x82l\x82\xc5\x91\x97\x90M\x0d\x0a"
+    // The quick brown fox jumps over.
+    "The quick brown fox jumps over.\x0d\x0a"
+    // ひらがなとカタカナと漢字の混在
+    "\x82\xd0\x82\xe7\x82\xaa\x82\xc8\x82\xc6\x83J\x83^\x83J\x83i"
+    "\x82\xc6\x8a\xbf\x8e\x9a\x82\xcc\x8d\xac\x8d\xdd\x0d\x0a"
+    // ｶﾀｶﾅ(半角)も表示できます。
+    "\xb6\xc0\xb6\xc5(\x94\xbc\x8ap)\x82\xe0\x95\x5c\x8e\xa6\x82\xc5"
+    "\x82\xab\x82\xdc\x82\xb7\x81" "B\x0d\x0a"
+    // Reply: 返信は R キーで行います。
+    "Reply: \x95\xd4\x90M\x82\xcd R \x83L\x81[\x82\xc5\x8ds\x82\xa2"
+    "\x82\xdc\x82\xb7\x81" "B\x0d\x0a"
+    // Mail from sysop: 明日は休みです
+    "Mail from sysop: \x96\xbe\x93\xfa\x82\xcd\x8bx\x82\xdd\x82\xc5"
+    "\x82\xb7\x0d\x0a"
+    // 電子メールと掲示板とチャット
+    "\x93" "d\x8eq\x83\x81\x81[\x83\x8b\x82\xc6\x8c" "f\x8e\xa6\x94"
+    "\xc2\x82\xc6\x83`\x83\x83\x83" "b\x83g\x0d\x0a"
+    // 0123456789 ABCDEFGHIJ abcdefghij
+    "0123456789 ABCDEFGHIJ abcdefghij\x0d\x0a"
+    // 東京・大阪・名古屋・札幌・福岡
+    "\x93\x8c\x8b\x9e\x81" "E\x91\xe5\x8d\xe3\x81" "E\x96\xbc\x8c"
+    "\xc3\x89\xae\x81" "E\x8e" "D\x96y\x81" "E\x95\x9f\x89\xaa\x0d"
+    "\x0a"
+    // 変換候補を選んで確定します。
+    "\x95\xcf\x8a\xb7\x8c\xf3\x95\xe2\x82\xf0\x91I\x82\xf1\x82\xc5"
+    "\x8am\x92\xe8\x82\xb5\x82\xdc\x82\xb7\x81" "B\x0d\x0a"
+    // Press RETURN to continue...
+    "Press RETURN to continue...\x0d\x0a"
+    // 終了するには Q を押してください
+    "\x8fI\x97\xb9\x82\xb7\x82\xe9\x82\xc9\x82\xcd Q \x82\xf0\x89"
+    "\x9f\x82\xb5\x82\xc4\x82\xad\x82\xbe\x82\xb3\x82\xa2\x0d\x0a";
+
+// Escape sequences, BS erase patterns and Telnet commands mixed in
+static const char recv_ansi[] =
+    // ESC[1;32m[News]ESC[0m 新着メッセージ３件
+    "\x1b[1;32m[News]\x1b[0m \x90V\x92\x85\x83\x81\x83" "b\x83Z\x81"
+    "[\x83W\x82R\x8c\x8f\x0d\x0a"
+    // ESC[33mFrom:ESC[37m sysop ESC[36m(管理者)ESC[0m
+    "\x1b[33mFrom:\x1b[37m sysop \x1b[36m(\x8a\xc7\x97\x9d\x8e\xd2"
+    ")\x1b[0m\x0d\x0a"
+    // ESC[31m重要ESC[0m: 明日はメンテナンスですESC[K
+    "\x1b[31m\x8f" "d\x97v\x1b[0m: \x96\xbe\x93\xfa\x82\xcd\x83\x81"
+    "\x83\x93\x83" "e\x83i\x83\x93\x83X\x82\xc5\x82\xb7\x1b[K\x0d"
+    "\x0a"
+    // ESC[44;37m 掲示板一覧 ESC[0mESC[K
+    "\x1b[44;37m \x8c" "f\x8e\xa6\x94\xc2\x88\xea\x97\x97 \x1b[0m"
+    "\x1b[K\x0d\x0a"
+    // ESC[32m 1ESC[0m 雑談 ESC[32m 2ESC[0m 技術 ESC[32m 3ESC[0m 告知
+    "\x1b[32m 1\x1b[0m \x8eG\x92k \x1b[32m 2\x1b[0m \x8bZ\x8fp \x1b"
+    "[32m 3\x1b[0m \x8d\x90\x92m\x0d\x0a"
+    // Login: guestBS BSBS BSBS BSst
+    "Login: guest\x08 \x08\x08 \x08\x08 \x08st\x0d\x0a"
+    // 入力中BSBS  BSBSBSBS  BSBS完了
+    "\x93\xfc\x97\xcd\x92\x86\x08\x08  \x08\x08\x08\x08  \x08\x08"
+    "\x8a\xae\x97\xb9\x0d\x0a"
+    // IAC NOP ESC[35mIAC NOPESC[0m と IAC IAC の受信
+    "\xff\xf1\x1b[35mIAC NOP\x1b[0m \x82\xc6 \xff\xff \x82\xcc\x8e"
+    "\xf3\x90M\x0d\x0a"
+    // ESC[2C右へESC[1D左へESC[K
+    "\x1b[2C\x89" "E\x82\xd6\x1b[1D\x8d\xb6\x82\xd6\x1b[K\x0d\x0a"
+    // ESC[1;33m★ESC[0m 今日の一言：漢字は楽しい
+    "\x1b[1;33m\x81\x9a\x1b[0m \x8d\xa1\x93\xfa\x82\xcc\x88\xea\x8c"
+    "\xbe\x81" "F\x8a\xbf\x8e\x9a\x82\xcd\x8ay\x82\xb5\x82\xa2\x0d"
+    "\x0a"
+    // ESC[36m----------------------------ESC[0m
+    "\x1b[36m----------------------------\x1b[0m\x0d\x0a"
+    // ESC[37;41m ERROR ESC[0m 接続がタイムアウトしました
+    "\x1b[37;41m ERROR \x1b[0m \x90\xda\x91\xb1\x82\xaa\x83^\x83" "C"
+    "\x83\x80\x83" "A\x83" "E\x83g\x82\xb5\x82\xdc\x82\xb5\x82\xbd"
+    "\x0d\x0a"
+    // ESC[12;1HESC[KESC[32m>ESC[0m メニューを選んでください
+    "\x1b[12;1H\x1b[K\x1b[32m>\x1b[0m \x83\x81\x83j\x83\x85\x81[\x82"
+    "\xf0\x91I\x82\xf1\x82\xc5\x82\xad\x82\xbe\x82\xb3\x82\xa2\x0d"
+    "\x0a"
+    // ESC[34m[M]ESC[0mメール ESC[34m[B]ESC[0m掲示板 ESC[34m[Q]ESC[0m終了
+    "\x1b[34m[M]\x1b[0m\x83\x81\x81[\x83\x8b \x1b[34m[B]\x1b[0m\x8c"
+    "f\x8e\xa6\x94\xc2 \x1b[34m[Q]\x1b[0m\x8fI\x97\xb9\x0d\x0a"
+    // ESC[AESC[BESC[Kカーソル上下
+    "\x1b[A\x1b[B\x1b[K\x83J\x81[\x83\x5c\x83\x8b\x8f\xe3\x89\xba"
+    "\x0d\x0a"
+    // ESC[0;1;37m太字ESC[0m と 通常 の文字
+    "\x1b[0;1;37m\x91\xbe\x8e\x9a\x1b[0m \x82\xc6 \x92\xca\x8f\xed"
+    " \x82\xcc\x95\xb6\x8e\x9a\x0d\x0a"
+    // ESC[33m送信中ESC[0m........ ESC[32mOKESC[0m
+    "\x1b[33m\x91\x97\x90M\x92\x86\x1b[0m........ \x1b[32mOK\x1b["
+    "0m\x0d\x0a"
+    // ESC[31m赤ESC[32m緑ESC[33m黄ESC[34m青ESC[35m紫ESC[36m水ESC[37m白ESC[0m
+    "\x1b[31m\x90\xd4\x1b[32m\x97\xce\x1b[33m\x89\xa9\x1b[34m\x90"
+    "\xc2\x1b[35m\x8e\x87\x1b[36m\x90\x85\x1b[37m\x94\x92\x1b[0m\x0d"
+    "\x0a"
+    // ESC[40;37mESC[K状態: 接続中 (telnet)ESC[0m
+    "\x1b[40;37m\x1b[K\x8f\xf3\x91\xd4: \x90\xda\x91\xb1\x92\x86 "
+    "(telnet)\x1b[0m\x0d\x0a"
+    // ESC[1m>>ESC[0m 
+    "\x1b[1m>>\x1b[0m ";
+
+//=============================================================================
+// Benchmark functions
+//=============================================================================
+
+// Tests 44/45: one pre-search per key, accumulated in 32 bits
+static unsigned long bench_ime_lookup(const char * const *keys, unsigned char count,
+                                      unsigned char *found)
+{
+    unsigned long total = 0;
+    unsigned char i;
+    bool hit;
+
+    *found = 0;
+    for (i = 0; i < count; i++) {
+        uint8_t length = (uint8_t)strlen(keys[i]);
+        timer_start();
+        hit = ime_bench_lookup((const uint8_t *)keys[i], length);
+        total += timer_stop();
+        if (hit) {
+            (*found)++;
+        }
+    }
+    return total;
+}
+
+// Tests 46/47: feed the data one line per call, as separate socket reads
+// would deliver it, into the terminal window (rows 0-23)
+static unsigned long bench_recv(const char *data, int size)
+{
+    unsigned long total = 0;
+    int start = 0;
+    int end;
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    jtxt_bwindow(0, 23);
+    jtxt_bwindow_enable();
+    jtxt_bautowrap_enable();
+    jtxt_blocate(0, 0);
+    term_recv_init();
+
+    while (start < size) {
+        end = start;
+        while (end < size && data[end] != 0x0A) {
+            end++;
+        }
+        if (end < size) {
+            end++;
+        }
+        timer_start();
+        term_recv_process(&data[start], end - start);
+        total += timer_stop();
+        start = end;
+    }
+
+    jtxt_bwindow(0, 24);
+    jtxt_bwindow_disable();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    return total;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+int main(void)
+{
+    unsigned long r44, r45, r46, r47;
+    unsigned char found_words, found_unknown;
+
+    // Hardware initialization (EasyFlash: no KERNAL)
+    mmap_set(MMAP_ROM);
+    cia_init();
+    vic_setmode(VICM_TEXT, (char *)0x0400, (char *)0x1800);
+
+    // Initialize jtxt bitmap mode, the IME and the receive path
+    jtxt_init(JTXT_BITMAP_MODE);
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+    ime_init();
+    telnet_init(0);
+
+    // Title screen
+    jtxt_blocate(0, 0);
+    jtxt_bputs("C64JP IME/TERMINAL BENCHMARK V1");
+    jtxt_blocate(0, 1);
+    jtxt_bputs("===============================");
+    jtxt_blocate(0, 3);
+    jtxt_bputs("MEASURES DICTIONARY LOOKUP AND");
+    jtxt_blocate(0, 4);
+    jtxt_bputs("RECEIVE PARSER CYCLES");
+    jtxt_blocate(0, 6);
+    jtxt_bputs("PRESS SPACE TO START");
+
+    wait_space();
+
+    jtxt_bcls();
+    jtxt_blocate(0, 0);
+    jtxt_bputs("RUNNING BENCHMARKS...");
+
+    POKE(0xD020, COLOR_RED);    // Visual: red border during bench
+
+    BENCH_TAG(44);
+    r44 = bench_ime_lookup(lookup_words, LOOKUP_WORDS, &found_words);
+    BENCH_TAG(45);
+    r45 = bench_ime_lookup(lookup_unknown, LOOKUP_UNKNOWN, &found_unknown);
+    BENCH_TAG(46);
+    r46 = bench_recv(recv_text, sizeof(recv_text) - 1);
+    BENCH_TAG(47);
+    r47 = bench_recv(recv_ansi, sizeof(recv_ansi) - 1);
+
+    POKE(0xD020, COLOR_BLACK);
+
+    //=========================================================================
+    // Results
+    //=========================================================================
+
+    jtxt_bcls();
+    jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+
+    jtxt_blocate(0, 0);
+    jtxt_bputs("=== IME / TERMINAL (CYC) ===");
+
+    jtxt_blocate(0, 2);
+    jtxt_bputs("TEST           TOTAL   /KEY");
+
+    jtxt_blocate(0, 3);
+    jtxt_bputs("44 WORDS");
+    jtxt_blocate(11, 3);
+    put_uint32(r44);
+    jtxt_blocate(21, 3);
+    put_uint32(r44 / LOOKUP_WORDS);
+
+    jtxt_blocate(0, 4);
+    jtxt_bputs("45 UNKNOWN");
+    jtxt_blocate(11, 4);
+    put_uint32(r45);
+    jtxt_blocate(21, 4);
+    put_uint32(r45 / LOOKUP_UNKNOWN);
+
+    jtxt_blocate(0, 6);
+    jtxt_bputs("FOUND");
+    jtxt_blocate(11, 6);
+    put_uint16(found_words);
+    jtxt_bputs(" /16");
+    jtxt_blocate(0, 7);
+    jtxt_bputs("NOT FOUND");
+    jtxt_blocate(11, 7);
+    put_uint16(LOOKUP_UNKNOWN - found_unknown);
+    jtxt_bputs(" /8");
+
+    jtxt_blocate(0, 9);
+    jtxt_bputs("TEST           TOTAL  /BYTE");
+
+    jtxt_blocate(0, 10);
+    jtxt_bputs("46 TEXT");
+    jtxt_blocate(11, 10);
+    put_uint32(r46);
+    jtxt_blocate(21, 10);
+    put_uint32(r46 / (sizeof(recv_text) - 1));
+
+    jtxt_blocate(0, 11);
+    jtxt_bputs("47 ANSI");
+    jtxt_blocate(11, 11);
+    put_uint32(r47);
+    jtxt_blocate(21, 11);
+    put_uint32(r47 / (sizeof(recv_ansi) - 1));
+
+    jtxt_blocate(0, 24);
+    jtxt_bputs("BENCHMARK COMPLETE");
+    BENCH_TAG(BENCH_TAG_DONE);
+
+    // Halt
+    while (1) {}
+
+    return 0;
+}
+
+//=============================================================================
+// Bank 1: JIS X 0201 Half-width Font (2KB) + Misaki Gothic Part 1 (14KB)
+//=============================================================================
+
+#pragma section( data1, 0 )
+#pragma region(font1, 0x8000, 0xc000, , 1, { data1 })
+#pragma data( data1 )
+
+__export const unsigned char font_jisx0201[] = {
+    #embed "../../fontconv/font_jisx0201.bin"
+};
+
+__export const unsigned char font_gothic_0[] = {
+    #embed 14336 0 "../../fontconv/font_misaki_gothic.bin"
+};
+
+#pragma data( data )
+
+//=============================================================================
+// Banks 2-5: Misaki Gothic Parts 2-5
+//=============================================================================
+
+#pragma section( data2, 0 )
+#pragma region(font2, 0x8000, 0xc000, , 2, { data2 })
+#pragma data( data2 )
+
+__export const unsigned char font_gothic_1[] = {
+    #embed 16384 14336 "../../fontconv/font_misaki_gothic.bin"
+};
+
+#pragma data( data )
+
+#pragma section( data3, 0 )
+#pragma region(font3, 0x8000, 0xc000, , 3, { data3 })
+#pragma data( data3 )
+
+__export const unsigned char font_gothic_2[] = {
+    #embed 16384 30720 "../../fontconv/font_misaki_gothic.bin"
+};
+
+#pragma data( data )
+
+#pragma section( data4, 0 )
+#pragma region(font4, 0x8000, 0xc000, , 4, { data4 })
+#pragma data( data4 )
+
+__export const unsigned char font_gothic_3[] = {
+    #embed 16384 47104 "../../fontconv/font_misaki_gothic.bin"
+};
+
+#pragma data( data )
+
+#pragma section( data5, 0 )
+#pragma region(font5, 0x8000, 0xc000, , 5, { data5 })
+#pragma data( data5 )
+
+__export const unsigned char font_gothic_4[] = {
+    #embed 7200 63488 "../../fontconv/font_misaki_gothic.bin"
+};
+
+#pragma data( data )
+
+//=============================================================================
+// Banks 6-18: SKK dictionary, version 3 (bench_skkdic.bin, 199,666 bytes)
+//=============================================================================
+
+#pragma section( dic6, 0 )
+#pragma region(dict6, 0x8000, 0xc000, , 6, { dic6 })
+#pragma data( dic6 )
+__export const unsigned char dict_0[] = {
+    #embed 16384 0 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic7, 0 )
+#pragma region(dict7, 0x8000, 0xc000, , 7, { dic7 })
+#pragma data( dic7 )
+__export const unsigned char dict_1[] = {
+    #embed 16384 16384 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic8, 0 )
+#pragma region(dict8, 0x8000, 0xc000, , 8, { dic8 })
+#pragma data( dic8 )
+__export const unsigned char dict_2[] = {
+    #embed 16384 32768 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic9, 0 )
+#pragma region(dict9, 0x8000, 0xc000, , 9, { dic9 })
+#pragma data( dic9 )
+__export const unsigned char dict_3[] = {
+    #embed 16384 49152 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic10, 0 )
+#pragma region(dict10, 0x8000, 0xc000, , 10, { dic10 })
+#pragma data( dic10 )
+__export const unsigned char dict_4[] = {
+    #embed 16384 65536 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic11, 0 )
+#pragma region(dict11, 0x8000, 0xc000, , 11, { dic11 })
+#pragma data( dic11 )
+__export const unsigned char dict_5[] = {
+    #embed 16384 81920 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic12, 0 )
+#pragma region(dict12, 0x8000, 0xc000, , 12, { dic12 })
+#pragma data( dic12 )
+__export const unsigned char dict_6[] = {
+    #embed 16384 98304 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic13, 0 )
+#pragma region(dict13, 0x8000, 0xc000, , 13, { dic13 })
+#pragma data( dic13 )
+__export const unsigned char dict_7[] = {
+    #embed 16384 114688 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic14, 0 )
+#pragma region(dict14, 0x8000, 0xc000, , 14, { dic14 })
+#pragma data( dic14 )
+__export const unsigned char dict_8[] = {
+    #embed 16384 131072 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic15, 0 )
+#pragma region(dict15, 0x8000, 0xc000, , 15, { dic15 })
+#pragma data( dic15 )
+__export const unsigned char dict_9[] = {
+    #embed 16384 147456 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic16, 0 )
+#pragma region(dict16, 0x8000, 0xc000, , 16, { dic16 })
+#pragma data( dic16 )
+__export const unsigned char dict_10[] = {
+    #embed 16384 163840 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic17, 0 )
+#pragma region(dict17, 0x8000, 0xc000, , 17, { dic17 })
+#pragma data( dic17 )
+__export const unsigned char dict_11[] = {
+    #embed 16384 180224 "bench_skkdic.bin"
+};
+#pragma data( data )
+
+#pragma section( dic18, 0 )
+#pragma region(dict18, 0x8000, 0xc000, , 18, { dic18 })
+#pragma data( dic18 )
+__export const unsigned char dict_12[] = {
+    #embed 3058 196608 "bench_skkdic.bin"
+};
+#pragma data( data )
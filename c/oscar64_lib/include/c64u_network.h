@@ -54,6 +54,9 @@
 #define C64U_CONNECT_HOST_MAX  128
 #define C64U_WRITE_DATA_MAX    512
 
+// Output queue: c64u_socketread flushes bytes queued this long ago (jiffies)
+#define C64U_WRITE_QUEUE_JIFFIES  2
+
 // Global data buffers
 extern char c64u_status[STATUS_QUEUE_SZ];
 extern char c64u_data[DATA_QUEUE_SZ * 2];
@@ -87,9 +90,15 @@ unsigned char c64u_udpconnect(const char *host, unsigned short port);
 void c64u_socketclose(unsigned char socketid);
 int  c64u_socketread(unsigned char socketid, unsigned short length);
 void c64u_socketwrite(unsigned char socketid, const char *data);
+void c64u_socketwrite_len(unsigned char socketid, const char *data, int length);
 void c64u_socketwritechar(unsigned char socketid, char one_char);
 void c64u_socketwrite_ascii(unsigned char socketid, const char *data);
 
+// Output queue: bytes sent together in one write command
+void c64u_socketqueue(unsigned char socketid, const char *data, int length);
+void c64u_socketqueuechar(unsigned char socketid, char one_char);
+void c64u_socketflush(void);
+
 // Helper functions
 char c64u_tcp_nextchar(unsigned char socketid);
 int  c64u_tcp_nextline(unsigned char socketid, char *result);
@@ -17,18 +17,39 @@
 #define IME_DIC_EF_START_BANK 6
 #endif
 
-#define IME_EVENT_NONE            0
-#define IME_EVENT_CONFIRMED       1
-#define IME_EVENT_CANCELLED       2
-#define IME_EVENT_MODE_CHANGED    3
-#define IME_EVENT_DEACTIVATED     4
-#define IME_EVENT_KEY_PASSTHROUGH 5
+#define IME_EVENT_NONE             0
+#define IME_EVENT_CONFIRMED        1
+#define IME_EVENT_CANCELLED        2
+#define IME_EVENT_MODE_CHANGED     3
+#define IME_EVENT_DEACTIVATED      4
+#define IME_EVENT_KEY_PASSTHROUGH  5
+#define IME_EVENT_BUSY             6  // Conversion in progress, call again
+#define IME_EVENT_CANDIDATES_READY 7  // Conversion done, candidates shown
+
+// Conversion cache size (readings remembered with their last candidate)
+#ifndef IME_MRU_ENTRIES
+#define IME_MRU_ENTRIES 32
+#endif
+
+// Clauses per multi-clause conversion (see ime_set_multi_clause)
+#ifndef IME_CLAUSE_MAX
+#define IME_CLAUSE_MAX 8
+#endif
+
+// Dictionary lookups per ime_process call while a conversion is in
+// progress (see ime_set_lookup_budget); 0 finishes it in one call. A
+// version 0 lookup walks up to 32 entries of a group.
+#ifndef IME_LOOKUP_BUDGET
+#define IME_LOOKUP_BUDGET 2
+#endif
 
 #define IME_MODE_HIRAGANA   0
 #define IME_MODE_KATAKANA   1
 #define IME_MODE_FULLWIDTH  2
 
 void ime_init(void);
+// Input state only: the conversion cache is kept (overlay reloads)
+void ime_reset(void);
 void ime_toggle_mode(void);
 bool ime_is_active(void);
 void ime_set_hiragana_mode(void);
@@ -43,4 +64,23 @@ uint8_t ime_get_result_length(void);
 void ime_clear_output(void);
 uint8_t ime_get_passthrough_key(void);
 
+// Multi-clause conversion: SPACE splits the whole input into clauses
+// (indexed dictionaries only; off by default)
+void ime_set_multi_clause(bool enable);
+
+// Conversion work per ime_process call: SPACE (and a clause resize)
+// returns IME_EVENT_BUSY until the candidates are ready, so the caller can
+// poll its I/O in between. Keys wait in the keyboard buffer meanwhile.
+void ime_set_lookup_budget(uint8_t lookups);
+
+// Conversion cache file (PRG builds; the filename is up to 16 characters)
+bool ime_mru_save(uint8_t device, const char* filename);
+bool ime_mru_load(uint8_t device, const char* filename);
+
+#ifdef IME_BENCH
+// Benchmark entry point: the verb and noun lookups of the pre-search for a
+// Shift-JIS hiragana reading; true if either found an entry
+bool ime_bench_lookup(const uint8_t* key, uint8_t length);
+#endif
+
 #endif /* IME_H */
@@ -44,12 +44,96 @@
   #define JTXT_JISX0208_OFFSET  JTXT_JISX0201_SIZE
 #endif
 
+// Font bank layout: JIS X 0201 followed by JIS X 0208 (84 rows of 94)
+// as one image split across consecutive cartridge banks
+#define JTXT_FONT_IMAGE_SIZE  (JTXT_JISX0201_SIZE + 84U * 94U * 8U)
+#ifdef JTXT_EASYFLASH
+  #define JTXT_FONT_FIRST_BANK  1
+  #define JTXT_FONT_BANK_SIZE   16384U
+#else
+  #define JTXT_FONT_FIRST_BANK  (1 + JTXT_BANK_OFFSET)
+  #define JTXT_FONT_BANK_SIZE   8192U
+#endif
+
 // String resource constants
-#define JTXT_STRING_RESOURCE_BANK 36
+#ifndef JTXT_STRING_RESOURCE_BANK
+  #define JTXT_STRING_RESOURCE_BANK 36   // Bank after a version 0 dictionary
+#endif
 #define JTXT_STRING_RESOURCE_BASE JTXT_ROM_BASE
 #define JTXT_STRING_BUFFER    0x0340U
 #define JTXT_STRING_BUFFER_SIZE 191
 
+// Pre-rasterized string resources (optional): define JTXT_RASTER to draw
+// resources written by convert_string_resources.py --raster
+#ifdef JTXT_RASTER
+  #ifndef JTXT_RASTER_RESOURCE_BANK
+    #define JTXT_RASTER_RESOURCE_BANK 37   // Bank after the string resources
+  #endif
+  #define JTXT_RASTER_HEADER_SIZE     8
+  #define JTXT_RASTER_FLAG_NEWLINE    0x01
+  #define JTXT_RASTER_COLOR_CURRENT   0xFF
+#endif
+
+// Glyph cache (optional): define JTXT_GLYPH_CACHE to keep recently drawn
+// bitmap glyphs in RAM so repeated characters skip ROM bank switching
+#ifdef JTXT_GLYPH_CACHE
+  #ifndef JTXT_GLYPH_CACHE_SIZE
+    #define JTXT_GLYPH_CACHE_SIZE 64   // Entries (power of 2, 8-128), 14 bytes each
+  #endif
+#endif
+
+// SJIS glyph index (optional): define JTXT_SJIS_INDEX to resolve kanji
+// through the lead/trail table written by createcrt/create_crt.py
+#ifdef JTXT_SJIS_INDEX
+  #ifndef JTXT_SJIS_INDEX_BANK
+    #define JTXT_SJIS_INDEX_BANK 40    // create_crt.py --sjis-index-bank
+  #endif
+  #define JTXT_SJIS_INDEX_VERSION   1
+  #define JTXT_SJIS_INDEX_L1_BANK   0x10U   // Level 1: bank[128] by lead & 0x7F
+  #define JTXT_SJIS_INDEX_L1_LO     0x90U   // Level 1: block pointer low
+  #define JTXT_SJIS_INDEX_L1_HI     0x110U  // Level 1: block pointer high
+  #define JTXT_SJIS_INDEX_STRIDE    189     // Level 2: bank/lo/hi arrays per lead
+  #define JTXT_SJIS_INDEX_BANK_UNITS (JTXT_FONT_BANK_SIZE / 8192U)
+  #define JTXT_SJIS_INDEX_FONT_BANK  JTXT_FONT_FIRST_BANK
+#endif
+
+// REU font store (optional): define JTXT_REU to copy the font image into a
+// 1700/1750/1764 REU at jtxt_init and fetch glyphs by DMA
+#ifdef JTXT_REU
+  #ifdef JTXT_EASYFLASH
+    // The REU registers and the EasyFlash RAM both sit at $DF00 (IO2)
+    #error "JTXT_REU cannot be combined with JTXT_EASYFLASH; use a MagicDesk or PRG build"
+  #endif
+  #ifndef JTXT_REU_FONT_BANK
+    #define JTXT_REU_FONT_BANK 0       // 64KB REU bank holding the font image
+  #endif
+  #ifndef JTXT_REU_WORK_BANK
+    #define JTXT_REU_WORK_BANK 1       // 64KB REU bank for block moves/fills
+  #endif
+  #define JTXT_REU_FILL_ADDR    0x0000U   // Fill byte in the work bank
+  #define JTXT_REU_COPY_ADDR    0x0100U   // Block move buffer in the work bank
+  #define JTXT_REU_STATUS       0xDF00U
+  #define JTXT_REU_COMMAND      0xDF01U
+  #define JTXT_REU_C64_ADDR     0xDF02U   // Low, high
+  #define JTXT_REU_REU_ADDR     0xDF04U   // Low, high
+  #define JTXT_REU_REU_BANK     0xDF06U
+  #define JTXT_REU_LENGTH       0xDF07U   // Low, high (0 = 64KB)
+  #define JTXT_REU_ADDR_CTRL    0xDF0AU   // Bit 7: fix C64, bit 6: fix REU
+  #define JTXT_REU_CMD_STASH    0x90      // Execute now, C64 -> REU
+  #define JTXT_REU_CMD_FETCH    0x91      // Execute now, REU -> C64
+  #define JTXT_REU_CMD_AUTOLOAD 0x20      // Restore addresses/length afterwards
+#endif
+
+// Shadow cell buffer (optional): define JTXT_SHADOW to track the glyph and
+// color of every bitmap cell (3000 bytes) and enable the diff output API
+#ifdef JTXT_SHADOW
+// Staged line buffer for jtxt_bcommit_row (one entry per column)
+typedef struct {
+    uint16_t code[JTXT_CHAR_WIDTH];
+    uint8_t color[JTXT_CHAR_WIDTH];
+} jtxt_line_t;
+#endif
+
 // Library state
 typedef struct {
     uint8_t chr_start;
@@ -90,7 +174,9 @@ void jtxt_cls(void);
 void jtxt_locate(uint8_t x, uint8_t y);
 void jtxt_putc(uint8_t char_code);
 void jtxt_puts(const char* str);
+void jtxt_puts_fast(const char* str);
 void jtxt_newline(void);
+void jtxt_clear_line(uint8_t row);
 void jtxt_set_color(uint8_t color);
 void jtxt_set_bgcolor(uint8_t bgcolor, uint8_t bordercolor);
 
@@ -100,6 +186,7 @@ void jtxt_blocate(uint8_t x, uint8_t y);
 void jtxt_bputc(uint8_t char_code);
 void jtxt_bputs(const char* str);
 void jtxt_bputs_fast(const char* str);
+void jtxt_bputn(const char* data, uint16_t length);
 void jtxt_bnewline(void);
 void jtxt_bbackspace(void);
 void jtxt_bcolor(uint8_t fg, uint8_t bg);
@@ -110,12 +197,16 @@ void jtxt_bautowrap_enable(void);
 void jtxt_bautowrap_disable(void);
 void jtxt_bscroll_up(void);
 void jtxt_bclear_to_eol(void);
+void jtxt_bclear_chars(uint8_t count);
 void jtxt_bclear_line(uint8_t row);
 
 // String resource functions
 bool jtxt_load_string_resource(uint8_t resource_number);
 void jtxt_putr(uint8_t resource_number);
 void jtxt_bputr(uint8_t resource_number);
+#ifdef JTXT_RASTER
+bool jtxt_bputr_raster(uint8_t resource_number);
+#endif
 
 // Utility functions
 bool jtxt_is_firstsjis(uint8_t char_code);
@@ -123,6 +214,47 @@ void jtxt_bput_hex2(uint8_t value);
 void jtxt_bput_dec2(uint8_t value);
 void jtxt_bput_dec3(uint8_t value);
 
+#ifdef JTXT_SHADOW
+// Shadow buffer / diff output functions
+void jtxt_shadow_invalidate(void);
+void jtxt_shadow_invalidate_row(uint8_t row);
+void jtxt_bputc_diff(uint8_t char_code);
+void jtxt_bputs_diff(const char* str);
+void jtxt_bline_clear(jtxt_line_t *line, uint8_t color);
+uint8_t jtxt_bline_puts(jtxt_line_t *line, uint8_t x, const char* str, uint8_t color);
+void jtxt_bcommit_row(uint8_t row, const jtxt_line_t *line);
+#endif
+
+#ifdef JTXT_GLYPH_CACHE
+// Glyph cache functions
+void jtxt_glyph_cache_clear(void);
+void jtxt_glyph_cache_reset_stats(void);
+extern uint16_t jtxt_glyph_cache_hits;
+extern uint16_t jtxt_glyph_cache_misses;
+#endif
+
+#ifdef JTXT_SJIS_INDEX
+// SJIS glyph index functions
+bool jtxt_sjis_index_check(void);
+uint16_t jtxt_sjis_index_lookup(uint16_t sjis_code, uint8_t *bank);
+extern uint8_t jtxt_sjis_index_ready;
+#endif
+
+#ifdef JTXT_BANK_GROUP
+// Bank-grouped line compositor
+void jtxt_bputs_grouped(const char* str);
+#endif
+
+#ifdef JTXT_REU
+// REU font store functions
+bool jtxt_reu_init(void);
+void jtxt_reu_dma(uint8_t command, uint16_t c64_addr, uint16_t reu_addr, uint8_t reu_bank, uint16_t length);
+void jtxt_reu_fetch_glyph(uint16_t code, uint16_t dest_addr);
+void jtxt_reu_copy(uint16_t dest_addr, uint16_t src_addr, uint16_t length);
+void jtxt_reu_fill(uint16_t dest_addr, uint8_t value, uint16_t length);
+extern uint8_t jtxt_reu_ready;
+#endif
+
 // ROM access management functions
 void jtxt_rom_access_begin(void);
 void jtxt_rom_access_end(void);
@@ -134,6 +266,7 @@ void jtxt_define_font(uint16_t dest_addr, uint16_t code);
 void jtxt_define_jisx0201(uint8_t jisx0201_code);
 void jtxt_define_kanji(uint16_t sjis_code);
 uint16_t jtxt_sjis_to_offset(uint16_t sjis_code);
+uint16_t jtxt_font_offset(uint16_t code);
 void jtxt_draw_font_to_bitmap(uint16_t char_code);
 
 // Global state access
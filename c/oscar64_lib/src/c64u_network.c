@@ -59,10 +59,18 @@ int c64u_data_len;
 static unsigned char cur_target = TARGET_NETWORK;
 
 /* Static command construction buffers */
-static char onechar[2];
+static char onechar[1];
 static unsigned char conn_cmd[4 + C64U_CONNECT_HOST_MAX + 1];
 static unsigned char wr_cmd[3 + C64U_WRITE_DATA_MAX];
 
+/* Output queue: wr_cmd[3..] holds wr_queued bytes for wr_socket */
+static int wr_queued;
+static unsigned char wr_socket;
+static unsigned char wr_since;  /* Jiffy clock when the first byte was queued */
+
+/* Low byte of the KERNAL jiffy clock (1/60 s) */
+static volatile unsigned char * const jiffy_clock = (volatile unsigned char *)0xA2;
+
 /* ============================================================
  * Core hardware interface
  * ============================================================ */
@@ -166,6 +174,8 @@ void c64u_identify(void)
 	c64u_readdata();
 	c64u_readstatus();
 	c64u_accept();
+
+	wr_queued = 0;
 }
 
 /* ============================================================
@@ -257,6 +267,9 @@ void c64u_socketclose(unsigned char socketid)
 {
 	unsigned char prev = cur_target;
 	unsigned char cmd[3];
+
+	c64u_socketflush();
+
 	cmd[0] = 0x00;
 	cmd[1] = NET_CMD_SOCKET_CLOSE;
 	cmd[2] = socketid;
@@ -273,6 +286,12 @@ int c64u_socketread(unsigned char socketid, unsigned short length)
 {
 	unsigned char prev = cur_target;
 	unsigned char cmd[5];
+
+	/* A caller that only polls still sends what it queued */
+	if (wr_queued != 0 &&
+	    (unsigned char)(*jiffy_clock - wr_since) >= C64U_WRITE_QUEUE_JIFFIES)
+		c64u_socketflush();
+
 	cmd[0] = 0x00;
 	cmd[1] = NET_CMD_SOCKET_READ;
 	cmd[2] = socketid;
@@ -313,35 +332,17 @@ static char petscii_swap_case(char c)
 	return c;
 }
 
-/* Write data to socket, with optional PETSCII-ASCII conversion */
-static void socket_write_data(unsigned char socketid, const char *data,
-                               int convert)
+/* Send the count data bytes in wr_cmd as one socket write command */
+static void send_write(unsigned char socketid, int count)
 {
 	unsigned char prev = cur_target;
-	int dlen = strlen(data);
-	int i;
-	char c;
-
-	if (dlen > C64U_WRITE_DATA_MAX)
-		dlen = C64U_WRITE_DATA_MAX;
 
 	wr_cmd[0] = 0x00;
 	wr_cmd[1] = NET_CMD_SOCKET_WRITE;
 	wr_cmd[2] = socketid;
 
-	for (i = 0; i < dlen; i++) {
-		c = data[i];
-		if (convert) {
-			if (c == 0x0D)
-				c = 0x0A;
-			else
-				c = petscii_swap_case(c);
-		}
-		wr_cmd[3 + i] = c;
-	}
-
 	c64u_settarget(TARGET_NETWORK);
-	c64u_sendcommand(wr_cmd, 3 + dlen);
+	c64u_sendcommand(wr_cmd, 3 + count);
 	c64u_readdata();
 	c64u_readstatus();
 	c64u_accept();
@@ -351,21 +352,106 @@ static void socket_write_data(unsigned char socketid, const char *data,
 	c64u_data_len = 0;
 }
 
+/*
+ * Write data to socket, with optional PETSCII-ASCII conversion.
+ * Queued bytes go out first; data longer than C64U_WRITE_DATA_MAX is
+ * sent in several commands.
+ */
+static void socket_write_data(unsigned char socketid, const char *data,
+                               int length, int convert)
+{
+	int count;
+	int i;
+	char c;
+
+	c64u_socketflush();
+
+	while (length > 0) {
+		count = length;
+		if (count > C64U_WRITE_DATA_MAX)
+			count = C64U_WRITE_DATA_MAX;
+
+		for (i = 0; i < count; i++) {
+			c = data[i];
+			if (convert) {
+				if (c == 0x0D)
+					c = 0x0A;
+				else
+					c = petscii_swap_case(c);
+			}
+			wr_cmd[3 + i] = c;
+		}
+		send_write(socketid, count);
+
+		data += count;
+		length -= count;
+	}
+}
+
 void c64u_socketwrite(unsigned char socketid, const char *data)
 {
-	socket_write_data(socketid, data, 0);
+	socket_write_data(socketid, data, strlen(data), 0);
+}
+
+void c64u_socketwrite_len(unsigned char socketid, const char *data, int length)
+{
+	socket_write_data(socketid, data, length, 0);
 }
 
 void c64u_socketwrite_ascii(unsigned char socketid, const char *data)
 {
-	socket_write_data(socketid, data, 1);
+	socket_write_data(socketid, data, strlen(data), 1);
 }
 
 void c64u_socketwritechar(unsigned char socketid, char one_char)
 {
 	onechar[0] = one_char;
-	onechar[1] = 0;
-	c64u_socketwrite(socketid, onechar);
+	socket_write_data(socketid, onechar, 1, 0);
+}
+
+/* ============================================================
+ * Output queue
+ *
+ * Bytes queued for a socket are gathered in wr_cmd and sent as
+ * one NET_CMD_SOCKET_WRITE, instead of one command round trip
+ * per byte. The queue is flushed when it is full, when another
+ * socket is queued for, before a direct write or a close, by
+ * c64u_socketread once it is C64U_WRITE_QUEUE_JIFFIES old, and
+ * by the caller with c64u_socketflush (once per main loop pass).
+ * ============================================================ */
+
+void c64u_socketqueue(unsigned char socketid, const char *data, int length)
+{
+	int i;
+
+	if (wr_queued != 0 && socketid != wr_socket)
+		c64u_socketflush();
+
+	for (i = 0; i < length; i++) {
+		if (wr_queued == C64U_WRITE_DATA_MAX)
+			c64u_socketflush();
+		if (wr_queued == 0) {
+			wr_socket = socketid;
+			wr_since = *jiffy_clock;
+		}
+		wr_cmd[3 + wr_queued++] = data[i];
+	}
+}
+
+void c64u_socketqueuechar(unsigned char socketid, char one_char)
+{
+	onechar[0] = one_char;
+	c64u_socketqueue(socketid, onechar, 1);
+}
+
+void c64u_socketflush(void)
+{
+	int count = wr_queued;
+
+	if (count != 0) {
+		wr_queued = 0;
+		send_write(wr_socket, count);
+	}
 }
 
 /* ============================================================
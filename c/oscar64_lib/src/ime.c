@@ -1,6 +1,12 @@
 #include "ime.h"
 #include "jtxt.h"
+#ifdef IME_HOST
+// Native build for the host simulator (imesim): memory, GETIN and the
+// dictionary ROM come from its fake machine
+#include "ime_host.h"
+#else
 #include "c64_oscar.h"
+#endif
 
 #ifdef JTXT_MAGICDESK_CRT
 #pragma code(icode)
@@ -11,13 +17,26 @@
 #include <stdint.h>
 #include <string.h>
 #include <stddef.h>
+#include "romaji_table.h"
+#if !defined(JTXT_CRT) && !defined(IME_HOST)
+#include <c64/kernalio.h>
+#endif
 
 #define ROM_BASE 0x8000U
 #define BANK_REG 0xDE00U
 
+// Dictionary ROM window and byte reads (the simulator counts them)
+#ifndef DIC_ROM
+#define DIC_ROM ((const volatile uint8_t*)ROM_BASE)
+#endif
+#ifndef DIC_BYTE
+#define DIC_BYTE(ptr) (*(ptr))
+#endif
+
 #define CIA1_DATA_A 0xDC00U
 #define CIA1_DATA_B 0xDC01U
 
+#ifndef IME_HOST
 // KERNAL GETIN wrapper for Oscar64
 // Using global variable to work around inline assembly limitations
 static volatile uint8_t getin_result;
@@ -30,6 +49,7 @@ static uint8_t cbm_k_getin(void)
     }
     return getin_result;
 }
+#endif
 
 #define COLOR_DEFAULT_FG 1
 #define COLOR_DEFAULT_BG 0
@@ -51,17 +71,68 @@ static uint8_t cbm_k_getin(void)
 #define F5_BIT        0x40U
 
 #define IME_STATUS_WIDTH 4
+#define IME_LINE_CELLS   37    // Input line cells left of the mode label
 
-#define ROMAJI_BUFFER_SIZE    8
+#define ROMAJI_BUFFER_SIZE    8     // Keys of a romaji state (romajiconv.py allows 7) and terminator
 #define HIRAGANA_BUFFER_SIZE 64
 #define CONVERSION_KEY_SIZE   64
-#define CANDIDATE_BUFFER_SIZE 256
-#define MAX_CANDIDATES        16
+#define CANDIDATE_TEXT_SIZE   66    // 63-byte candidate, okurigana, terminator
+#define CANDIDATE_GROUPS      2     // Verb and noun entry
+#define CANDIDATE_CACHED      0xFF  // locate_candidate: the cached candidate
+#define CANDIDATE_READING     0xFE  // locate_candidate: the clause in kana
+#define CANDIDATE_NONE        0xFF
+#define CANDIDATE_NO_SKIP     0xFFFFU
 
 #define HIRAGANA_BUFFER_LIMIT (HIRAGANA_BUFFER_SIZE - 2)
 
+// Dictionary header (see dicconv/dicconv.py)
+#define DIC_NOUN_TABLE        4U
+#define DIC_VERB_TABLE        250U
+#define DIC_NOUN_INDEX_TABLE  496U
+#define DIC_VERB_INDEX_TABLE  742U
+#define DIC_TOKEN_TABLE       988U  // Version 3
+#define DIC_TOKEN_SIZE        4
+#define DIC_COMPRESSED        3     // Version with front-coded keys and tokens
+#define DIC_VERSION_MASK      0x7F
+#define DIC_ALIGNED           0x80  // Version flag: no entry crosses an 8KB bank
+#define DIC_SLOT_OTHER        83
+#define DIC_SLOT_SHORT        84
+#define DIC_DIRECTORY_END     0xFF
+#define DIC_SORTED_RUN_MIN    8     // Shorter runs are scanned linearly
+#define DIC_GROUP_WALK        32    // Version 0 entries per pre-search lookup
+
+// Pre-search states (see presearch_step)
+#define PRESEARCH_IDLE 0
+#define PRESEARCH_VERB 1
+#define PRESEARCH_NOUN 2
+#define PRESEARCH_DONE 3
+
+// Conversion steps (see convert_step)
+#define CONVERT_PRESEARCH 0
+#define CONVERT_SEGMENT   1
+#define CONVERT_FILL      2
+
+// Multi-clause conversion (see segment_step)
+#define CLAUSE_SPAN_MAX    40    // Bytes segmented per conversion (20 kana)
+#define CLAUSE_MATCHES     5     // Clause lengths tried per position
+#define CLAUSE_COST_WORD   2     // Clause found in the dictionary
+#define CLAUSE_COST_KANA   3     // Unknown clause; each further kana adds 1
+#define CLAUSE_TEXT_SIZE   128
+#define CLAUSE_LINE_WIDTH  28    // Columns left of the candidate number
+#define CLAUSE_NONE        0xFF
+
+// Conversion cache (see mru_lookup)
+#define MRU_READING_SIZE   16
+#define MRU_CANDIDATE_SIZE 24
+#define MRU_HASH_SIZE      16    // Power of two
+#define MRU_NONE           0xFF
+#define MRU_FILE_LFN       2
+#define MRU_FILENAME_MAX   16
+
+#ifndef IME_HOST
 #define PEEK(addr) (*(volatile uint8_t*)(addr))
 #define POKE(addr, val) (PEEK(addr) = (uint8_t)(val))
+#endif
 
 static uint16_t mkword(uint8_t hi, uint8_t lo) {
     return ((uint16_t)hi << 8) | lo;
@@ -75,50 +146,16 @@ static uint8_t lsb16(uint16_t value) {
     return (uint8_t)(value & 0xFF);
 }
 
-enum {
-    ROMAJI_EMPTY = 0,
-    ROMAJI_CONSONANT,
-    ROMAJI_N,
-    ROMAJI_SMALL_TSU,
-    ROMAJI_WAITING_2ND,
-    ROMAJI_X_PREFIX,
-    ROMAJI_Y_WAITING,
-    ROMAJI_SKIP_NEXT
-};
-
 enum {
     IME_STATE_INPUT = 0,
-    IME_STATE_CONVERTING = 1
-};
-
-static const uint16_t basic_hiragana[] = {
-    0x82A0, 0x82A2, 0x82A4, 0x82A6, 0x82A8,
-    0x82A9, 0x82AB, 0x82AD, 0x82AF, 0x82B1,
-    0x82B3, 0x82B5, 0x82B7, 0x82B9, 0x82BB,
-    0x82BD, 0x82BF, 0x82C2, 0x82C4, 0x82C6,
-    0x82C8, 0x82C9, 0x82CA, 0x82CB, 0x82CC,
-    0x82CD, 0x82D0, 0x82D3, 0x82D6, 0x82D9,
-    0x82DC, 0x82DD, 0x82DE, 0x82DF, 0x82E0,
-    0x82E2, 0x82E4, 0x82E6,
-    0x82E7, 0x82E8, 0x82E9, 0x82EA, 0x82EB,
-    0x82ED, 0x82F0, 0x82F1
-};
-
-static const uint16_t dakuten_hiragana[] = {
-    0x82AA, 0x82AC, 0x82AE, 0x82B0, 0x82B2,
-    0x82B4, 0x82B6, 0x82B8, 0x82BA, 0x82BC,
-    0x82BE, 0x82C0, 0x82C3, 0x82C5, 0x82C7,
-    0x82CE, 0x82D1, 0x82D4, 0x82D7, 0x82DA
-};
-
-static const uint16_t handakuten_hiragana[] = {
-    0x82CF, 0x82D2, 0x82D5, 0x82D8, 0x82DB
+    IME_STATE_CONVERTING = 1,
+    IME_STATE_SEARCHING = 2     // Conversion in progress (see convert_step)
 };
 
-static const uint16_t small_hiragana[] = {
-    0x829F, 0x82A1, 0x82A3, 0x82A5, 0x82A7,
-    0x82E1, 0x82E3, 0x82E5,
-    0x82C1
+// Second bytes of the one-kana particles a noun clause may end in:
+// は が を に で の へ と も
+static const uint8_t particle_hiragana[] = {
+    0xCD, 0xAA, 0xF0, 0xC9, 0xC5, 0xCC, 0xD6, 0xC6, 0xE0
 };
 
 static const uint8_t status_label_hiragana[] = { 0x5B, 0x82, 0xA0, 0x5D, 0x00 };
@@ -129,14 +166,11 @@ static bool ime_active = false;
 static bool prev_commodore_state = false;
 static bool prev_space_state = false;
 static bool ime_has_output = false;
-static bool is_verb_first = false;
 
 static uint8_t ime_input_mode = IME_MODE_HIRAGANA;
 static uint8_t ime_conversion_state = IME_STATE_INPUT;
 
-static uint8_t romaji_state = ROMAJI_EMPTY;
-static uint8_t last_consonant = 0;
-static uint8_t second_consonant = 0;
+static uint8_t romaji_state = 0;
 static uint8_t romaji_buffer[ROMAJI_BUFFER_SIZE];
 static uint8_t romaji_pos = 0;
 static uint8_t hiragana_buffer[HIRAGANA_BUFFER_SIZE];
@@ -150,18 +184,35 @@ static uint8_t saved_cursor_y = 0;
 static uint8_t saved_color = 0;
 static uint8_t passthrough_key = 0;
 
-static uint8_t candidates_buffer[CANDIDATE_BUFFER_SIZE];
-static uint8_t candidate_offsets[MAX_CANDIDATES];
-static uint8_t candidate_buffer_pos = 0;
+static uint8_t candidate_text[CANDIDATE_TEXT_SIZE];
+static uint8_t candidate_text_index = 0;
+static bool candidate_text_valid = false;
+static uint8_t candidate_groups = 0;
+static uint8_t group_bank[CANDIDATE_GROUPS];
+static uint16_t group_offset[CANDIDATE_GROUPS];
+static uint8_t group_size[CANDIDATE_GROUPS];
+static uint8_t group_length[CANDIDATE_GROUPS];
+static uint16_t group_okurigana[CANDIDATE_GROUPS];
+static uint8_t cached_candidate = 0;
+static uint16_t skip_position = CANDIDATE_NO_SKIP;
+static uint8_t stream_group = 0;
+static uint8_t stream_index = 0;
+static uint8_t stream_bank = 0;
+static uint16_t stream_offset = 0;
 static uint8_t candidate_count = 0;
 static uint8_t current_candidate = 0;
+static uint8_t reading_candidate = CANDIDATE_NONE;
 
 static uint8_t ime_output_buffer[128];
 static uint8_t ime_output_length = 0;
 
-static uint8_t prev_display_length = 0;
-static uint8_t prev_display_chars = 0;
-static uint8_t prev_romaji_pos = 0;
+// What the input line shows, so a redraw only draws the cells that changed
+static uint16_t line_code[IME_LINE_CELLS];
+static bool line_highlight[IME_LINE_CELLS];
+static uint8_t line_cells = 0;      // Cells drawn, the rest is blank
+static uint8_t line_pos = 0;
+static bool line_located = false;
+static bool line_highlighted = false;
 
 static uint8_t saved_bottom_row = 24;
 
@@ -169,46 +220,84 @@ static uint8_t current_entry_length = 0;
 
 static uint8_t current_bank = IME_DICTIONARY_START_BANK;
 static uint16_t current_offset = 0;
+static uint8_t dic_version = 0;
+static bool dic_aligned = false;
 
 static uint8_t verb_match_length = 0;
 static uint8_t verb_match_bank = 0;
 static uint16_t verb_match_offset = 0;
 static uint16_t verb_match_okurigana = 0;
-static uint8_t verb_candidate_count = 0;
 
 static uint8_t match_length = 0;
 static uint8_t match_bank = 0;
 static uint16_t match_offset = 0;
 static uint16_t match_okurigana = 0;
-static uint8_t match_candidate_count = 0;
+
+static uint8_t noun_match_length = 0;
+static uint8_t noun_match_bank = 0;
+static uint16_t noun_match_offset = 0;
+
+// Entries with keys of search_floor bytes or fewer are not searched
+static uint8_t search_floor = 0;
+
+// Version 0 group walk stopped after group_walk_limit entries (0: no
+// limit); the next search of the same kind resumes at the saved entry
+static uint8_t group_walk_limit = 0;
+static bool group_walk_pending = false;
+static uint8_t group_walk_bank = 0;
+static uint16_t group_walk_offset = 0;
+static uint16_t group_walk_skip = 0;
+
+static uint8_t presearch_state = PRESEARCH_IDLE;
+static bool presearch_dirty = false;
+static bool presearch_verb_found = false;
+static bool presearch_noun_found = false;
+static uint8_t presearch_verb_floor = 0;
+static uint8_t presearch_noun_floor = 0;
+
+static uint8_t convert_phase = CONVERT_PRESEARCH;
+static uint8_t convert_clause = 0;  // Clause shown when the conversion is done
+static uint8_t convert_cached = MRU_NONE;
+static uint8_t fill_next = 0;
+static uint8_t lookup_budget = IME_LOOKUP_BUDGET;
+static uint8_t lookup_count = 0;
+
+static bool multi_clause = false;
+static uint8_t clause_count = 0;    // 0: single-clause conversion
+static uint8_t current_clause = 0;
+static uint8_t clause_end = 0;
+static uint8_t clause_start[IME_CLAUSE_MAX + 1];
+static uint8_t clause_candidate[IME_CLAUSE_MAX];
+static bool clause_kana[IME_CLAUSE_MAX];
+static uint8_t clause_text[CLAUSE_TEXT_SIZE];
+static uint8_t clause_text_start[IME_CLAUSE_MAX + 1];
+static uint8_t segment_cost[CLAUSE_SPAN_MAX + 1];
+static uint8_t segment_prev[CLAUSE_SPAN_MAX + 1];
+static bool segment_word[CLAUSE_SPAN_MAX + 1];
+static uint8_t segment_clause = 0;
+static uint8_t segment_start = 0;
+static uint8_t segment_span = 0;
+static uint8_t segment_position = 0;
+static uint8_t segment_hint_noun = 0;
+static uint8_t segment_hint_verb = 0;
+static bool segment_hint_valid = false;
+
+static uint8_t mru_reading[IME_MRU_ENTRIES][MRU_READING_SIZE];
+static uint8_t mru_reading_length[IME_MRU_ENTRIES];
+static uint8_t mru_candidate[IME_MRU_ENTRIES][MRU_CANDIDATE_SIZE];
+static uint8_t mru_next[IME_MRU_ENTRIES];
+static uint8_t mru_order[IME_MRU_ENTRIES];
+static uint8_t mru_bucket[MRU_HASH_SIZE];
+static uint8_t mru_count = 0;
+static bool mru_dirty = false;
 
 static void clear_romaji_buffer(void);
 static void clear_hiragana_buffer(void);
 static bool input_romaji(uint8_t key);
-static bool handle_empty_state(uint8_t key);
-static bool handle_consonant_state(uint8_t key);
-static bool handle_n_state(uint8_t key);
-static bool handle_small_tsu_state(uint8_t key);
-static bool handle_waiting_2nd_state(uint8_t key);
-static bool handle_x_prefix_state(uint8_t key);
-static bool handle_y_waiting_state(uint8_t key);
-static bool handle_skip_next_state(uint8_t key);
-static void force_confirm_romaji(void);
 static bool backspace_romaji(void);
-static void recalculate_state(void);
 static void add_to_hiragana_buffer(uint16_t sjis_char);
-static void add_small_tsu(void);
-static void add_n(void);
-static uint8_t vowel_index(uint8_t ch);
-static uint8_t consonant_to_row(uint8_t ch);
-static uint16_t convert_special_2char(uint8_t ch1, uint8_t ch2);
-static uint16_t convert_special_1char(uint8_t consonant, uint8_t vowel);
-static uint16_t convert_basic(uint8_t consonant, uint8_t vowel);
-static uint16_t convert_dakuten(uint8_t consonant, uint8_t vowel);
-static uint16_t convert_handakuten(uint8_t consonant, uint8_t vowel);
-static uint16_t convert_small(uint8_t vowel_or_y);
-static uint16_t convert_youon(uint8_t consonant, uint8_t y_vowel);
-static uint16_t convert_special_youon(uint8_t ch1, uint8_t ch2, uint8_t y_vowel);
+static void add_romaji_output(uint8_t slot);
+static void set_romaji_state(uint8_t state);
 static void convert_to_katakana(uint8_t* target_ptr);
 static void convert_to_hiragana(uint8_t* target_ptr);
 static bool is_commodore_pressed(void);
@@ -232,20 +321,77 @@ static void display_conversion_candidates(void);
 static const uint8_t* get_ime_output_internal(void);
 static uint8_t get_ime_output_length_internal(void);
 static void clear_ime_output_internal(void);
-static void clear_ime_input_area(void);
 static void clear_conversion_key_buffer(void);
-static uint8_t bytes_to_chars(uint8_t byte_length);
-static void jtxt_bput_number(uint8_t value);
-static uint8_t read_rom_byte(uint8_t bank, uint16_t offset);
+static void line_begin(void);
+static void line_put(uint16_t code, bool highlight);
+static void line_put_text(const uint8_t* text, uint8_t length, bool highlight);
+static void line_put_number(uint8_t value);
+static void line_end(void);
 static uint8_t read_dic_byte(void);
+static uint8_t read_entry_byte(void);
 static uint8_t read_dic_string(uint8_t* buffer);
+static uint8_t read_candidate(uint8_t* buffer);
+static void dic_map(void);
+static void dic_open(uint8_t bank, uint16_t offset);
+static uint16_t dic_tell(void);
+static void dic_close(void);
+static void dic_skip(uint16_t size);
+static void dic_seek(uint8_t bank, uint16_t offset);
+static bool dic_read_address(uint8_t* bank, uint16_t* offset);
+static uint8_t dic_compare_key(const uint8_t* key_buffer, uint8_t key_length, uint8_t* same, uint8_t* last);
 static uint8_t hiragana_to_index(uint8_t first_byte, uint8_t second_byte);
 static bool check_okurigana_match(const uint8_t* okurigana_buffer, uint8_t verb_suffix);
 static bool search_noun_entries(const uint8_t* key_buffer, uint8_t key_length);
 static bool search_verb_entries(const uint8_t* key_buffer, uint8_t key_length);
 static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search);
-static void add_candidates(uint16_t okurigana);
+static bool search_indexed_entries(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search, uint8_t index);
+static bool search_run_list(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search, uint8_t key_start);
+static bool search_run(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                       uint8_t key_bytes, uint8_t count);
+static bool search_run_sorted(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                              uint8_t key_bytes, uint8_t count, uint8_t key_start);
+static int8_t compare_run_entry(uint8_t table_bank, uint16_t table_offset, uint8_t index,
+                                const uint8_t* key_buffer, uint8_t key_start, uint8_t stem_length);
+static void record_match(const uint8_t* key_buffer, uint8_t key_length, uint8_t entry_key_length, bool is_verb_search);
+static void add_candidates(uint16_t okurigana, uint8_t entry_length);
+static bool check_dictionary(void);
+static void presearch_step(void);
+static void mru_clear(void);
+static uint8_t mru_hash(uint8_t hash, uint8_t value);
+static void mru_link(uint8_t entry);
+static void mru_unlink(uint8_t entry);
+static void mru_touch(uint8_t entry);
+static uint8_t mru_lookup(const uint8_t* key_buffer, uint8_t key_length, bool exact);
+static void mru_store(const uint8_t* reading, uint8_t reading_length, const uint8_t* candidate);
+static void promote_candidate(uint8_t entry);
+static uint8_t locate_candidate(uint8_t index, uint8_t* group_index);
+static void fetch_candidate(uint8_t index);
+static void skip_dic_string(void);
+static bool match_dic_string(const uint8_t* text, uint16_t okurigana);
+static void reset_candidates(void);
+static uint16_t count_candidates(void);
+static void consume_hiragana(uint8_t length);
+static uint8_t char_bytes(uint8_t position);
+static bool is_particle(uint8_t position);
+static void start_clause_conversion(bool noun_found, bool verb_found);
+static uint8_t clause_matches(uint8_t position, uint8_t rest, uint8_t* lengths);
+static uint8_t clause_add_noun(uint8_t position, uint8_t rest, uint8_t noun, uint8_t* lengths, uint8_t count);
+static void segment_relax(uint8_t position, uint8_t from, uint8_t cost, bool word);
+static void segment_begin(uint8_t clause, uint8_t start);
+static bool segment_step(void);
+static bool segment_end(void);
+static void fill_begin(uint8_t clause);
+static void load_clause(uint8_t clause);
+static void set_clause_text(uint8_t clause, const uint8_t* text);
+static void update_clause_text(void);
+static void resize_clause(bool longer);
+static void confirm_clauses(void);
+static void display_clauses(void);
 static bool start_conversion(void);
+static void convert_matches(void);
+static void convert_failed(void);
+static void convert_step(void);
+static uint8_t convert_run(void);
 static void next_candidate(void);
 static void prev_candidate(void);
 static uint8_t* get_current_candidate(void);
@@ -255,267 +401,6 @@ static void backup_cursor(void);
 static void restore_cursor(void);
 static uint8_t check_mode_keys(void);
 static uint8_t petscii_to_ascii(uint8_t key);
-static uint8_t vowel_index(uint8_t ch) {
-    switch (ch) {
-        case 'a': return 0;
-        case 'i': return 1;
-        case 'u': return 2;
-        case 'e': return 3;
-        case 'o': return 4;
-        default:  return 0xFF;
-    }
-}
-
-static uint8_t consonant_to_row(uint8_t ch) {
-    switch (ch) {
-        case 'k': return 1;
-        case 's': return 2;
-        case 't':
-        case 'c': return 3;
-        case 'n': return 4;
-        case 'h':
-        case 'f': return 5;
-        case 'm': return 6;
-        case 'y': return 7;
-        case 'r': return 8;
-        case 'w': return 9;
-        default:  return 0xFF;
-    }
-}
-
-static uint16_t convert_special_2char(uint8_t ch1, uint8_t ch2) {
-    if (ch1 == 's' && ch2 == 'h') {
-        return 0x82B5;
-    }
-    if (ch1 == 'c' && ch2 == 'h') {
-        return 0x82BF;
-    }
-    if (ch1 == 't' && ch2 == 's') {
-        return 0x82C2;
-    }
-    return 0;
-}
-
-static uint16_t convert_special_1char(uint8_t consonant, uint8_t vowel) {
-    switch (consonant) {
-        case 's':
-            if (vowel == 'i') {
-                return 0x82B5;
-            }
-            break;
-        case 't':
-            if (vowel == 'i') {
-                return 0x82BF;
-            }
-            if (vowel == 'u') {
-                return 0x82C2;
-            }
-            break;
-        case 'h':
-            if (vowel == 'u') {
-                return 0x82D3;
-            }
-            break;
-        case 'f':
-            switch (vowel) {
-                case 'a':
-                    add_to_hiragana_buffer(0x82D3);
-                    add_to_hiragana_buffer(0x829F);
-                    return 0xFFFF;
-                case 'i':
-                    add_to_hiragana_buffer(0x82D3);
-                    add_to_hiragana_buffer(0x82A1);
-                    return 0xFFFF;
-                case 'u':
-                    return 0x82D3;
-                case 'e':
-                    add_to_hiragana_buffer(0x82D3);
-                    add_to_hiragana_buffer(0x82A5);
-                    return 0xFFFF;
-                case 'o':
-                    add_to_hiragana_buffer(0x82D3);
-                    add_to_hiragana_buffer(0x82A7);
-                    return 0xFFFF;
-                default:
-                    break;
-            }
-            break;
-        default:
-            break;
-    }
-    return 0;
-}
-
-static uint16_t convert_basic(uint8_t consonant, uint8_t vowel) {
-    uint8_t row = consonant_to_row(consonant);
-    uint8_t vol = vowel_index(vowel);
-
-    if (row == 0xFF || vol == 0xFF) {
-        return 0;
-    }
-
-    if (row == 7) {
-        switch (vol) {
-            case 0: return basic_hiragana[35];
-            case 2: return basic_hiragana[36];
-            case 4: return basic_hiragana[37];
-            default: return 0;
-        }
-    }
-
-    if (row == 9) {
-        switch (vol) {
-            case 0:
-                return basic_hiragana[43];
-            case 1:
-                add_to_hiragana_buffer(0x82A4);
-                add_to_hiragana_buffer(0x82A1);
-                return 0xFFFF;
-            case 3:
-                add_to_hiragana_buffer(0x82A4);
-                add_to_hiragana_buffer(0x82A5);
-                return 0xFFFF;
-            case 4:
-                return basic_hiragana[44];
-            default:
-                return 0;
-        }
-    }
-
-    if (row >= 1 && row <= 8 && row != 7) {
-        uint8_t index;
-        if (row < 7) {
-            index = (uint8_t)((row - 1) * 5 + 5 + vol);
-        } else {
-            index = (uint8_t)(38 + vol);
-        }
-        return basic_hiragana[index];
-    }
-
-    return 0;
-}
-
-static uint16_t convert_dakuten(uint8_t consonant, uint8_t vowel) {
-    uint8_t vol = vowel_index(vowel);
-    uint8_t base = 0xFF;
-
-    if (vol > 4) {
-        return 0;
-    }
-    switch (consonant) {
-        case 'g': base = 0; break;
-        case 'z': base = 5; break;
-        case 'd': base = 10; break;
-        case 'b': base = 15; break;
-        default: break;
-    }
-
-    if (base == 0xFF) {
-        return 0;
-    }
-    return dakuten_hiragana[base + vol];
-}
-
-static uint16_t convert_handakuten(uint8_t consonant, uint8_t vowel) {
-    uint8_t vol;
-
-    if (consonant == 'p') {
-        vol = vowel_index(vowel);
-        if (vol <= 4) {
-            return handakuten_hiragana[vol];
-        }
-    }
-    return 0;
-}
-
-static uint16_t convert_small(uint8_t vowel_or_y) {
-    switch (vowel_or_y) {
-        case 'a': return small_hiragana[0];
-        case 'i': return small_hiragana[1];
-        case 'u': return small_hiragana[2];
-        case 'e': return small_hiragana[3];
-        case 'o': return small_hiragana[4];
-        case 'y': return small_hiragana[5];
-        default:  return 0;
-    }
-}
-
-static uint16_t convert_youon(uint8_t consonant, uint8_t y_vowel) {
-    uint16_t base_i = 0;
-    uint16_t small_ya = 0;
-    uint8_t base_index = 0;
-
-    switch (consonant) {
-        case 'k': base_index = 6; break;
-        case 's': base_index = 11; break;
-        case 't': base_index = 16; break;
-        case 'n': base_index = 21; break;
-        case 'h': base_index = 26; break;
-        case 'f': base_index = 27; break;
-        case 'm': base_index = 31; break;
-        case 'r': base_index = 39; break;
-        case 'g': base_index = (uint8_t)(1 | 0x40); break;
-        case 'z': base_index = (uint8_t)(6 | 0x40); break;
-        case 'j': base_index = (uint8_t)(6 | 0x40); break;
-        case 'd': base_index = (uint8_t)(11 | 0x40); break;
-        case 'b': base_index = (uint8_t)(16 | 0x40); break;
-        case 'p': base_index = (uint8_t)(1 | 0x80); break;
-        default: return 0;
-    }
-
-    switch (base_index & 0xC0) {
-        case 0x00:
-            base_i = basic_hiragana[base_index & 0x3F];
-            break;
-        case 0x40:
-            base_i = dakuten_hiragana[base_index & 0x3F];
-            break;
-        case 0x80:
-            base_i = handakuten_hiragana[base_index & 0x3F];
-            break;
-        default:
-            base_i = 0;
-            break;
-    }
-
-    if (base_i == 0) {
-        return 0;
-    }
-    switch (y_vowel) {
-        case 'a': small_ya = small_hiragana[5]; break;
-        case 'u': small_ya = small_hiragana[6]; break;
-        case 'o': small_ya = small_hiragana[7]; break;
-        default: return 0;
-    }
-
-    add_to_hiragana_buffer(base_i);
-    add_to_hiragana_buffer(small_ya);
-    return 0xFFFF;
-}
-
-static uint16_t convert_special_youon(uint8_t ch1, uint8_t ch2, uint8_t y_vowel) {
-    uint16_t base = 0;
-    uint16_t small_ya = 0;
-
-    if (ch1 == 'c' && ch2 == 'h') {
-        base = 0x82BF;
-    } else if (ch1 == 's' && ch2 == 'h') {
-        base = 0x82B5;
-    } else {
-        return 0;
-    }
-    switch (y_vowel) {
-        case 'a': small_ya = small_hiragana[5]; break;
-        case 'u': small_ya = small_hiragana[6]; break;
-        case 'o': small_ya = small_hiragana[7]; break;
-        default: return 0;
-    }
-
-    add_to_hiragana_buffer(base);
-    add_to_hiragana_buffer(small_ya);
-    return 0xFFFF;
-}
-
 static void add_to_hiragana_buffer(uint16_t sjis_char) {
     uint8_t high;
     uint8_t low;
@@ -541,534 +426,163 @@ static void add_to_hiragana_buffer(uint16_t sjis_char) {
     hiragana_buffer[hiragana_pos] = high;
     hiragana_buffer[hiragana_pos + 1] = low;
     hiragana_pos = (uint8_t)(hiragana_pos + 2);
+    presearch_dirty = true;
 }
 
-static void add_small_tsu(void) {
-    add_to_hiragana_buffer(small_hiragana[8]);
+static void add_romaji_output(uint8_t slot) {
+    uint16_t i = romaji_output[slot];
+
+    while (romaji_kana[i] != 0) {
+        add_to_hiragana_buffer(mkword(romaji_kana[i], romaji_kana[i + 1]));
+        i = (uint16_t)(i + 2);
+    }
 }
 
-static void add_n(void) {
-    add_to_hiragana_buffer(basic_hiragana[45]);
+// Enter a romaji state and spell its keys into the romaji buffer
+static void set_romaji_state(uint8_t state) {
+    uint8_t pos = romaji_depth[state];
+
+    romaji_state = state;
+    romaji_pos = pos;
+    romaji_buffer[pos] = 0;
+    while (pos > 0) {
+        romaji_buffer[--pos] = romaji_key[state];
+        state = romaji_parent[state];
+    }
 }
+
 static void clear_romaji_buffer(void) {
     romaji_pos = 0;
-    romaji_state = ROMAJI_EMPTY;
-    last_consonant = 0;
-    second_consonant = 0;
+    romaji_state = 0;
     memset(romaji_buffer, 0, sizeof(romaji_buffer));
 }
 
 static void clear_hiragana_buffer(void) {
     hiragana_pos = 0;
     memset(hiragana_buffer, 0, sizeof(hiragana_buffer));
+    presearch_dirty = true;
 }
 
 static void clear_conversion_key_buffer(void) {
     memset(conversion_key_buffer, 0, sizeof(conversion_key_buffer));
 }
-static void debug_print_state(uint8_t key) {
-    (void)key;
-}
 static bool input_romaji(uint8_t key) {
-    if (key < 32 || key > 126) {
-        return false;
-    }
-
-    if (romaji_pos >= ROMAJI_BUFFER_SIZE - 1) {
-        force_confirm_romaji();
-    }
-
-    romaji_buffer[romaji_pos++] = key;
-
-    debug_print_state(key);
-
-    switch (romaji_state) {
-        case ROMAJI_EMPTY:
-            return handle_empty_state(key);
-        case ROMAJI_CONSONANT:
-            return handle_consonant_state(key);
-        case ROMAJI_N:
-            return handle_n_state(key);
-        case ROMAJI_SMALL_TSU:
-            return handle_small_tsu_state(key);
-        case ROMAJI_WAITING_2ND:
-            return handle_waiting_2nd_state(key);
-        case ROMAJI_X_PREFIX:
-            return handle_x_prefix_state(key);
-        case ROMAJI_Y_WAITING:
-            return handle_y_waiting_state(key);
-        case ROMAJI_SKIP_NEXT:
-            return handle_skip_next_state(key);
-        default:
-            clear_romaji_buffer();
-            return false;
-    }
-}
-static bool handle_empty_state(uint8_t key) {
-    uint8_t vol;
-    uint8_t row;
-
-    switch (key) {
-        case '-':
-            add_to_hiragana_buffer(0x815B);
-            clear_romaji_buffer();
-            return true;
-        case ',':
-            add_to_hiragana_buffer(0x8141);
-            clear_romaji_buffer();
-            return true;
-        case '.':
-            add_to_hiragana_buffer(0x8142);
-            clear_romaji_buffer();
-            return true;
-        default:
-            break;
-    }
-
-    vol = vowel_index(key);
-    if (vol != 0xFF) {
-        add_to_hiragana_buffer(basic_hiragana[vol]);
-        clear_romaji_buffer();
-        return true;
-    }
-
-    if (key == 'n') {
-        romaji_state = ROMAJI_N;
-        last_consonant = 'n';
-        return true;
-    }
-
-    if (key == 'x') {
-        romaji_state = ROMAJI_X_PREFIX;
-        return true;
-    }
-
-    row = consonant_to_row(key);
-    if (row != 0xFF || key == 'g' || key == 'z' || key == 'd' ||
-        key == 'b' || key == 'p' || key == 'j') {
-        if (key == 's' || key == 'c' || key == 't' || key == 'f' || key == 'd') {
-            romaji_state = ROMAJI_WAITING_2ND;
-            last_consonant = key;
+    uint8_t state = romaji_state;
+    uint16_t i;
+
+    if (key >= ROMAJI_KEY_FIRST && key <= ROMAJI_KEY_LAST) {
+        i = (uint16_t)(romaji_base[state] + (uint8_t)(key - ROMAJI_KEY_FIRST));
+        if (romaji_check[i] == state) {
+            add_romaji_output(romaji_out[i]);
+            set_romaji_state(romaji_next[i]);
             return true;
         }
-
-        romaji_state = ROMAJI_CONSONANT;
-        last_consonant = key;
-        return true;
     }
 
+    // No rule continues here: the key is dropped with the romaji buffer
     clear_romaji_buffer();
     return false;
 }
-static bool handle_consonant_state(uint8_t key) {
-    uint8_t vol;
-    uint16_t result = 0;
-
-    if (key == last_consonant && key != 'n') {
-        add_small_tsu();
-        romaji_state = ROMAJI_CONSONANT;
-        return true;
-    }
 
-    if (last_consonant == 'j') {
-        if (key == 'i') {
-            add_to_hiragana_buffer(0x82B6);
-            clear_romaji_buffer();
-            return true;
-        }
-        if (key == 'a' || key == 'u' || key == 'o') {
-            add_to_hiragana_buffer(0x82B6);
-            switch (key) {
-                case 'a': add_to_hiragana_buffer(0x82E1); break;
-                case 'u': add_to_hiragana_buffer(0x82E3); break;
-                case 'o': add_to_hiragana_buffer(0x82E5); break;
-            }
-            clear_romaji_buffer();
-            return true;
-        }
-        if (key == 'e') {
-            add_to_hiragana_buffer(0x82B6);
-            add_to_hiragana_buffer(0x82A5);
-            clear_romaji_buffer();
-            return true;
-        }
-        if (key == 'y') {
-            romaji_state = ROMAJI_Y_WAITING;
+static bool backspace_romaji(void) {
+    if (romaji_pos == 0) {
+        if (hiragana_pos >= 2) {
+            hiragana_pos = (uint8_t)(hiragana_pos - 2);
+            hiragana_buffer[hiragana_pos] = 0;
+            hiragana_buffer[hiragana_pos + 1] = 0;
+            presearch_dirty = true;
             return true;
         }
-        clear_romaji_buffer();
         return false;
     }
 
-    vol = vowel_index(key);
-    if (vol != 0xFF) {
-        result = convert_special_1char(last_consonant, key);
-        if (result == 0) {
-            result = convert_dakuten(last_consonant, key);
-            if (result == 0) {
-                result = convert_handakuten(last_consonant, key);
-                if (result == 0) {
-                    result = convert_basic(last_consonant, key);
-                }
-            }
+    set_romaji_state(romaji_parent[romaji_state]);
+    return true;
+}
+static void convert_to_katakana(uint8_t* target_ptr) {
+    uint8_t i = 0;
+    uint8_t ch;
+    while (target_ptr[i] != 0) {
+        if (target_ptr[i] < 0x80) {
+            ++i;
+            continue;
         }
-
-        if (result != 0) {
-            if (result != 0xFFFF) {
-                add_to_hiragana_buffer(result);
+        ch = target_ptr[i + 1];
+        if (target_ptr[i] >= 0x82 && ch >= 0x9F && ch <= 0xF1) {
+            target_ptr[i] = 0x83;
+            if (ch <= 0xDD) {
+                target_ptr[i + 1] = (uint8_t)(ch - 0x5F);
+            } else {
+                target_ptr[i + 1] = (uint8_t)(ch - 0x5E);
             }
-            clear_romaji_buffer();
-            return true;
         }
+        i = (uint8_t)(i + 2);
     }
+}
 
-    if (key == 'y') {
-        romaji_state = ROMAJI_Y_WAITING;
-        return true;
+static void convert_to_hiragana(uint8_t* target_ptr) {
+    uint8_t i = 0;
+    uint8_t ch;
+    while (target_ptr[i] != 0) {
+        if (target_ptr[i] < 0x80) {
+            ++i;
+            continue;
+        }
+        ch = target_ptr[i + 1];
+        if (target_ptr[i] == 0x83 && ch >= 0x40 && ch <= 0x93) {
+            target_ptr[i] = 0x82;
+            if (ch <= 0x7E) {
+                target_ptr[i + 1] = (uint8_t)(ch + 0x5F);
+            } else {
+                target_ptr[i + 1] = (uint8_t)(ch + 0x5E);
+            }
+        }
+        i = (uint8_t)(i + 2);
     }
+}
+static bool is_commodore_pressed(void) {
+    uint8_t result;
 
-    clear_romaji_buffer();
-    return false;
+    POKE(CIA1_DATA_A, COMMODORE_ROW);
+    result = PEEK(CIA1_DATA_B);
+    return (result & COMMODORE_BIT) == 0;
 }
-static bool handle_n_state(uint8_t key) {
-    uint8_t row;
-    uint8_t vol;
-    uint16_t result;
 
-    if (key == 'n') {
-        add_n();
-        clear_romaji_buffer();
-        return true;
-    }
+static bool is_space_pressed(void) {
+    uint8_t result;
 
-    row = consonant_to_row(key);
-    if (row != 0xFF && key != 'y') {
-        add_n();
-        clear_romaji_buffer();
-        return input_romaji(key);
-    }
+    POKE(CIA1_DATA_A, SPACE_ROW);
+    result = PEEK(CIA1_DATA_B);
+    return (result & SPACE_BIT) == 0;
+}
 
-    if (key == 'j' || key == 'g' || key == 'z' || key == 'd' || key == 'b' || key == 'p') {
-        add_n();
-        clear_romaji_buffer();
-        return input_romaji(key);
-    }
+static bool is_f1_pressed(void) {
+    uint8_t result;
 
-    vol = vowel_index(key);
-    if (vol != 0xFF) {
-        result = convert_basic('n', key);
-        if (result != 0) {
-            if (result != 0xFFFF) {
-                add_to_hiragana_buffer(result);
-            }
-            clear_romaji_buffer();
-            return true;
-        }
-    }
+    POKE(CIA1_DATA_A, FKEY_ROW);
+    result = PEEK(CIA1_DATA_B);
+    return (result & F1_BIT) == 0;
+}
 
-    if (key == 'y') {
-        romaji_state = ROMAJI_Y_WAITING;
-        return true;
-    }
+static bool is_f3_pressed(void) {
+    uint8_t result;
 
-    clear_romaji_buffer();
-    return false;
-}
-static bool handle_small_tsu_state(uint8_t key) {
-    clear_romaji_buffer();
-    return input_romaji(key);
+    POKE(CIA1_DATA_A, FKEY_ROW);
+    result = PEEK(CIA1_DATA_B);
+    return (result & F3_BIT) == 0;
 }
-static bool handle_waiting_2nd_state(uint8_t key) {
-    if (key == last_consonant) {
-        add_small_tsu();
-        return true;
-    }
-
-    if (key == 'h') {
-        second_consonant = key;
-        romaji_state = ROMAJI_Y_WAITING;
-        return true;
-    }
 
-    if (last_consonant == 't' && key == 's') {
-        add_to_hiragana_buffer(0x82C2);
-        clear_romaji_buffer();
-        romaji_state = ROMAJI_SKIP_NEXT;
-        return true;
-    }
+static bool is_f5_pressed(void) {
+    uint8_t result;
 
-    romaji_state = ROMAJI_CONSONANT;
-    return handle_consonant_state(key);
+    POKE(CIA1_DATA_A, FKEY_ROW);
+    result = PEEK(CIA1_DATA_B);
+    return (result & F5_BIT) == 0;
 }
 
-static bool handle_x_prefix_state(uint8_t key) {
-    uint16_t result = convert_small(key);
-    if (result != 0) {
-        add_to_hiragana_buffer(result);
-        clear_romaji_buffer();
-        return true;
-    }
-
-    clear_romaji_buffer();
-    return false;
-}
-static bool handle_y_waiting_state(uint8_t key) {
-    uint8_t vol;
-    uint16_t result;
-
-    result = 0;
-
-    if (second_consonant == 'h') {
-        vol = vowel_index(key);
-        if (vol != 0xFF) {
-            switch (key) {
-                case 'i':
-                    if (last_consonant == 'd') {
-                        add_to_hiragana_buffer(0x82C5);
-                        add_to_hiragana_buffer(0x82A1);
-                        clear_romaji_buffer();
-                        return true;
-                    }
-                    result = convert_special_2char(last_consonant, second_consonant);
-                    if (result != 0) {
-                        add_to_hiragana_buffer(result);
-                        clear_romaji_buffer();
-                        return true;
-                    }
-                    break;
-                case 'a':
-                case 'u':
-                case 'o':
-                    if (last_consonant == 'd') {
-                        add_to_hiragana_buffer(0x82C5);
-                        if (key == 'a') {
-                            add_to_hiragana_buffer(0x82E1);
-                        } else if (key == 'u') {
-                            add_to_hiragana_buffer(0x82E3);
-                        } else {
-                            add_to_hiragana_buffer(0x82E5);
-                        }
-                        clear_romaji_buffer();
-                        return true;
-                    }
-                    result = convert_special_youon(last_consonant, second_consonant, key);
-                    if (result != 0) {
-                        clear_romaji_buffer();
-                        return true;
-                    }
-                    break;
-                case 'e':
-                    if (last_consonant == 'd') {
-                        add_to_hiragana_buffer(0x82C5);
-                        add_to_hiragana_buffer(0x82A5);
-                        clear_romaji_buffer();
-                        return true;
-                    }
-                    break;
-                default:
-                    break;
-            }
-        }
-    } else {
-        if (key == 'a' || key == 'u' || key == 'o') {
-            result = convert_youon(last_consonant, key);
-            if (result != 0) {
-                clear_romaji_buffer();
-                return true;
-            }
-        }
-    }
-
-    clear_romaji_buffer();
-    return false;
-}
-
-static bool handle_skip_next_state(uint8_t key) {
-    (void)key;
-    clear_romaji_buffer();
-    return true;
-}
-static void force_confirm_romaji(void) {
-    if (romaji_state == ROMAJI_N) {
-        add_n();
-    }
-    clear_romaji_buffer();
-}
-
-static bool backspace_romaji(void) {
-    if (romaji_pos == 0) {
-        if (hiragana_pos >= 2) {
-            hiragana_pos = (uint8_t)(hiragana_pos - 2);
-            hiragana_buffer[hiragana_pos] = 0;
-            hiragana_buffer[hiragana_pos + 1] = 0;
-            return true;
-        }
-        return false;
-    }
-
-    if (romaji_pos > 0) {
-        romaji_buffer[--romaji_pos] = 0;
-        recalculate_state();
-        return true;
-    }
-
-    return false;
-}
-
-static void recalculate_state(void) {
-    uint8_t last_char;
-    uint8_t saved_char;
-
-    if (romaji_pos == 0) {
-        clear_romaji_buffer();
-        return;
-    }
-
-    last_char = romaji_buffer[romaji_pos - 1];
-
-    if (romaji_pos == 1) {
-        if (last_char == 'n') {
-            romaji_state = ROMAJI_N;
-            last_consonant = 'n';
-        } else if (last_char == 'x') {
-            romaji_state = ROMAJI_X_PREFIX;
-            last_consonant = 0;
-            second_consonant = 0;
-        } else if (last_char == 's' || last_char == 'c' || last_char == 't' ||
-                   last_char == 'f' || last_char == 'd') {
-            romaji_state = ROMAJI_WAITING_2ND;
-            last_consonant = last_char;
-            second_consonant = 0;
-        } else {
-            uint8_t row = consonant_to_row(last_char);
-            if (row != 0xFF || last_char == 'g' || last_char == 'z' ||
-                last_char == 'd' || last_char == 'b' || last_char == 'p' ||
-                last_char == 'j') {
-                romaji_state = ROMAJI_CONSONANT;
-                last_consonant = last_char;
-                second_consonant = 0;
-            } else {
-                clear_romaji_buffer();
-            }
-        }
-        return;
-    }
-
-    if (romaji_pos == 2) {
-        uint8_t first_char = romaji_buffer[0];
-
-        if ((first_char == 's' && last_char == 'h') ||
-            (first_char == 'c' && last_char == 'h') ||
-            (first_char == 't' && last_char == 's')) {
-            romaji_state = ROMAJI_Y_WAITING;
-            last_consonant = first_char;
-            second_consonant = last_char;
-            return;
-        }
-
-        if (last_char == 'y') {
-            romaji_state = ROMAJI_Y_WAITING;
-            last_consonant = first_char;
-            second_consonant = 0;
-            return;
-        }
-
-        romaji_state = ROMAJI_CONSONANT;
-        last_consonant = first_char;
-        second_consonant = 0;
-        return;
-    }
-
-    saved_char = last_char;
-    clear_romaji_buffer();
-    romaji_buffer[0] = saved_char;
-    romaji_pos = 1;
-    recalculate_state();
-}
-static void convert_to_katakana(uint8_t* target_ptr) {
-    uint8_t i = 0;
-    uint8_t ch;
-    while (target_ptr[i] != 0) {
-        if (target_ptr[i] < 0x80) {
-            ++i;
-            continue;
-        }
-        ch = target_ptr[i + 1];
-        if (target_ptr[i] >= 0x82 && ch >= 0x9F && ch <= 0xF1) {
-            target_ptr[i] = 0x83;
-            if (ch <= 0xDD) {
-                target_ptr[i + 1] = (uint8_t)(ch - 0x5F);
-            } else {
-                target_ptr[i + 1] = (uint8_t)(ch - 0x5E);
-            }
-        }
-        i = (uint8_t)(i + 2);
-    }
-}
-
-static void convert_to_hiragana(uint8_t* target_ptr) {
-    uint8_t i = 0;
-    uint8_t ch;
-    while (target_ptr[i] != 0) {
-        if (target_ptr[i] < 0x80) {
-            ++i;
-            continue;
-        }
-        ch = target_ptr[i + 1];
-        if (target_ptr[i] == 0x83 && ch >= 0x40 && ch <= 0x93) {
-            target_ptr[i] = 0x82;
-            if (ch <= 0x7E) {
-                target_ptr[i + 1] = (uint8_t)(ch + 0x5F);
-            } else {
-                target_ptr[i + 1] = (uint8_t)(ch + 0x5E);
-            }
-        }
-        i = (uint8_t)(i + 2);
-    }
-}
-static bool is_commodore_pressed(void) {
-    uint8_t result;
-
-    POKE(CIA1_DATA_A, COMMODORE_ROW);
-    result = PEEK(CIA1_DATA_B);
-    return (result & COMMODORE_BIT) == 0;
-}
-
-static bool is_space_pressed(void) {
-    uint8_t result;
-
-    POKE(CIA1_DATA_A, SPACE_ROW);
-    result = PEEK(CIA1_DATA_B);
-    return (result & SPACE_BIT) == 0;
-}
-
-static bool is_f1_pressed(void) {
-    uint8_t result;
-
-    POKE(CIA1_DATA_A, FKEY_ROW);
-    result = PEEK(CIA1_DATA_B);
-    return (result & F1_BIT) == 0;
-}
-
-static bool is_f3_pressed(void) {
-    uint8_t result;
-
-    POKE(CIA1_DATA_A, FKEY_ROW);
-    result = PEEK(CIA1_DATA_B);
-    return (result & F3_BIT) == 0;
-}
-
-static bool is_f5_pressed(void) {
-    uint8_t result;
-
-    POKE(CIA1_DATA_A, FKEY_ROW);
-    result = PEEK(CIA1_DATA_B);
-    return (result & F5_BIT) == 0;
-}
-
-static bool check_commodore_space(void) {
-    bool current_commodore = is_commodore_pressed();
-    bool current_space = is_space_pressed();
+static bool check_commodore_space(void) {
+    bool current_commodore = is_commodore_pressed();
+    bool current_space = is_space_pressed();
 
     bool trigger = false;
     if (current_commodore && current_space && !prev_space_state) {
@@ -1084,16 +598,8 @@ static void clear_ime_input_line(void) {
     jtxt_bwindow_disable();
     jtxt_bcolor(COLOR_DEFAULT_FG, COLOR_DEFAULT_BG);
     jtxt_blocate(0, 24);
-    {
-        uint8_t i;
-        for (i = 0; i < 40; ++i) {
-            jtxt_bputc(32);
-        }
-    }
-
-    prev_display_length = 0;
-    prev_display_chars = 0;
-    prev_romaji_pos = 0;
+    jtxt_bclear_to_eol();
+    line_cells = 0;
 
     if (ime_active) {
         jtxt_bwindow_enable();
@@ -1142,53 +648,14 @@ static void deactivate_ime_input_internal(void) {
     ime_conversion_state = IME_STATE_INPUT;
     candidate_count = 0;
     current_candidate = 0;
+    clause_count = 0;
     conversion_key_length = 0;
-    candidate_buffer_pos = 0;
-    verb_candidate_count = 0;
-    match_candidate_count = 0;
     passthrough_key = 0;
 
     jtxt_bwindow(jtxt_state.bitmap_top_row, saved_bottom_row);
     jtxt_bwindow_enable();
 }
 
-static void clear_ime_input_area(void) {
-    jtxt_bwindow_disable();
-    jtxt_bcolor(COLOR_DEFAULT_FG, COLOR_DEFAULT_BG);
-    jtxt_blocate(0, 24);
-    {
-        uint8_t i;
-        for (i = 0; i < 37; ++i) {
-            jtxt_bputc(32);
-        }
-    }
-    if (ime_active) {
-        jtxt_bwindow_enable();
-    }
-}
-
-static uint8_t bytes_to_chars(uint8_t byte_length) {
-    uint8_t char_count;
-    uint8_t i;
-
-    if (byte_length == 0) {
-        return 0;
-    }
-
-    char_count = 0;
-    i = 0;
-    while (i < byte_length) {
-        if (jtxt_is_firstsjis(hiragana_buffer[i])) {
-            ++char_count;
-            i = (uint8_t)(i + 2);
-        } else {
-            ++char_count;
-            ++i;
-        }
-    }
-
-    return char_count;
-}
 static const uint8_t* get_ime_output_internal(void) {
     return ime_has_output ? ime_output_buffer : NULL;
 }
@@ -1202,6 +669,11 @@ static void clear_ime_output_internal(void) {
     ime_output_length = 0;
 }
 static void update_ime_display(void) {
+    // The line keeps its text until the conversion is done
+    if (ime_conversion_state == IME_STATE_SEARCHING) {
+        return;
+    }
+
     jtxt_bwindow_disable();
     jtxt_bcolor(COLOR_DEFAULT_FG, COLOR_DEFAULT_BG);
 
@@ -1214,63 +686,91 @@ static void update_ime_display(void) {
     jtxt_bwindow_enable();
 }
 static void display_input_text(void) {
-    uint8_t current_length = hiragana_pos;
-    uint8_t current_chars = bytes_to_chars(current_length);
-    uint8_t current_romaji = romaji_pos;
-    uint8_t total_chars = (uint8_t)(current_chars + current_romaji);
-    uint8_t prev_total_chars = (uint8_t)(prev_display_chars + prev_romaji_pos);
+    line_begin();
+    line_put_text(hiragana_buffer, hiragana_pos, false);
+    line_put_text(romaji_buffer, romaji_pos, false);
+    line_end();
+}
 
-    bool needs_update = (current_length != prev_display_length) ||
-                        (current_romaji != prev_romaji_pos);
+static void line_begin(void) {
+    line_pos = 0;
+    line_located = false;
+    line_highlighted = false;
+}
 
-    if (!needs_update) {
+// Draw a cell unless the screen already shows it. The caller has set the
+// default color
+static void line_put(uint16_t code, bool highlight) {
+    if (line_pos >= IME_LINE_CELLS) {
+        return;
+    }
+    if (line_pos < line_cells && line_code[line_pos] == code &&
+        line_highlight[line_pos] == highlight) {
+        ++line_pos;
+        line_located = false;
         return;
     }
 
-    if (total_chars < 37) {
-        uint8_t i;
-
-        jtxt_blocate(0, 24);
-
-        for (i = 0; i < current_length; ++i) {
-            jtxt_bputc(hiragana_buffer[i]);
+    if (!line_located) {
+        jtxt_blocate(line_pos, 24);
+        line_located = true;
+    }
+    if (highlight != line_highlighted) {
+        if (highlight) {
+            jtxt_bcolor(COLOR_STATUS_FG, COLOR_STATUS_BG);
+        } else {
+            jtxt_bcolor(COLOR_DEFAULT_FG, COLOR_DEFAULT_BG);
         }
+        line_highlighted = highlight;
+    }
+    if (code > 0xFF) {
+        jtxt_bputc(msb16(code));
+        jtxt_bputc(lsb16(code));
+    } else {
+        jtxt_bputc((uint8_t)code);
+    }
 
-        for (i = 0; i < current_romaji; ++i) {
-            jtxt_bputc(romaji_buffer[i]);
-        }
+    line_code[line_pos] = code;
+    line_highlight[line_pos] = highlight;
+    ++line_pos;
+}
 
-        if (total_chars < prev_total_chars) {
-            for (i = total_chars; i < prev_total_chars; ++i) {
-                jtxt_bputc(32);
-            }
+static void line_put_text(const uint8_t* text, uint8_t length, bool highlight) {
+    uint8_t i = 0;
+
+    while (i < length) {
+        if (jtxt_is_firstsjis(text[i]) && (uint8_t)(i + 1) < length) {
+            line_put(mkword(text[i], text[i + 1]), highlight);
+            i = (uint8_t)(i + 2);
+        } else {
+            line_put(text[i], highlight);
+            ++i;
         }
     }
-
-    prev_display_length = current_length;
-    prev_display_chars = current_chars;
-    prev_romaji_pos = current_romaji;
 }
-static void jtxt_bput_number(uint8_t value) {
-    char buffer[4];
-    uint8_t pos = 0;
 
+static void line_put_number(uint8_t value) {
     if (value >= 100) {
-        buffer[pos++] = (char)('0' + (value / 100));
+        line_put((uint8_t)('0' + value / 100), false);
         value %= 100;
+        line_put((uint8_t)('0' + value / 10), false);
+    } else if (value >= 10) {
+        line_put((uint8_t)('0' + value / 10), false);
     }
-    if (value >= 10 || pos > 0) {
-        buffer[pos++] = (char)('0' + (value / 10));
-        value %= 10;
-    }
-    buffer[pos++] = (char)('0' + value);
+    line_put((uint8_t)('0' + value % 10), false);
+}
 
-    {
-        uint8_t i;
-        for (i = 0; i < pos; ++i) {
-            jtxt_bputc((uint8_t)buffer[i]);
-        }
+// Blank the cells the previous line had beyond this one, in one block fill
+static void line_end(void) {
+    if (line_highlighted) {
+        jtxt_bcolor(COLOR_DEFAULT_FG, COLOR_DEFAULT_BG);
+        line_highlighted = false;
+    }
+    if (line_pos < line_cells) {
+        jtxt_blocate(line_pos, 24);
+        jtxt_bclear_chars((uint8_t)(line_cells - line_pos));
     }
+    line_cells = line_pos;
 }
 static void display_conversion_candidates(void) {
     uint8_t* candidate_str;
@@ -1278,44 +778,96 @@ static void display_conversion_candidates(void) {
     uint8_t col;
     uint8_t ch;
 
-    clear_ime_input_area();
-
-    if (candidate_count == 0) {
+    if (clause_count != 0) {
+        display_clauses();
         return;
     }
 
-    jtxt_bwindow_disable();
-    jtxt_blocate(0, 24);
+    line_begin();
 
-    candidate_str = get_current_candidate();
-    if (candidate_str != NULL) {
-        i = 0;
-        col = 0;
-        while (candidate_str[i] != 0 && col < 20) {
-            ch = candidate_str[i];
-            jtxt_bputc(ch);
-            if (jtxt_is_firstsjis(ch)) {
-                ++i;
-                if (candidate_str[i] != 0) {
-                    jtxt_bputc(candidate_str[i]);
+    if (candidate_count != 0) {
+        candidate_str = get_current_candidate();
+        if (candidate_str != NULL) {
+            i = 0;
+            col = 0;
+            while (candidate_str[i] != 0 && col < 20) {
+                ch = candidate_str[i];
+                if (jtxt_is_firstsjis(ch) && candidate_str[i + 1] != 0) {
+                    line_put(mkword(ch, candidate_str[i + 1]), false);
+                    ++i;
+                    col = (uint8_t)(col + 2);
+                } else {
+                    line_put(ch, false);
+                    col = (uint8_t)(col + 1);
                 }
-                col = (uint8_t)(col + 2);
+                ++i;
+            }
+        }
+
+        line_put(' ', false);
+        line_put_number((uint8_t)(current_candidate + 1));
+        line_put('/', false);
+        line_put_number(candidate_count);
+    }
+
+    line_end();
+}
+// All clauses with the current one highlighted, then the kana left over.
+// Leading clauses scroll off when the current one would not fit.
+static void display_clauses(void) {
+    uint8_t first = 0;
+    uint8_t clause;
+    uint8_t i;
+    uint8_t end;
+    uint8_t step;
+    uint8_t col = 0;
+    bool highlight;
+
+    line_begin();
+
+    while (first < current_clause &&
+           (uint8_t)(clause_text_start[current_clause + 1] - clause_text_start[first]) > CLAUSE_LINE_WIDTH) {
+        ++first;
+    }
+
+    for (clause = first; clause < clause_count; ++clause) {
+        highlight = clause == current_clause;
+        end = clause_text_start[clause + 1];
+        for (i = clause_text_start[clause]; i < end; i = (uint8_t)(i + step)) {
+            step = jtxt_is_firstsjis(clause_text[i]) ? 2 : 1;
+            if ((uint8_t)(col + step) > CLAUSE_LINE_WIDTH) {
+                break;
+            }
+            if (step == 2) {
+                line_put(mkword(clause_text[i], clause_text[i + 1]), highlight);
             } else {
-                col = (uint8_t)(col + 1);
+                line_put(clause_text[i], highlight);
             }
-            ++i;
+            col = (uint8_t)(col + step);
+        }
+    }
+
+    for (i = clause_start[clause_count]; i < hiragana_pos; i = (uint8_t)(i + step)) {
+        step = char_bytes(i);
+        if ((uint8_t)(col + step) > CLAUSE_LINE_WIDTH) {
+            break;
+        }
+        if (step == 2) {
+            line_put(mkword(hiragana_buffer[i], hiragana_buffer[i + 1]), false);
+        } else {
+            line_put(hiragana_buffer[i], false);
         }
+        col = (uint8_t)(col + step);
     }
 
-    jtxt_bputc(' ');
-    jtxt_bput_number((uint8_t)(current_candidate + 1));
-    jtxt_bputc('/');
-    jtxt_bput_number(candidate_count);
+    line_put(' ', false);
+    line_put_number((uint8_t)(current_candidate + 1));
+    line_put('/', false);
+    line_put_number(candidate_count);
 
-    prev_display_length = 0;
-    prev_display_chars = 0;
-    prev_romaji_pos = 0;
+    line_end();
 }
+
 static void input_ime_char(uint8_t key) {
     uint8_t processed_key = key;
     if (key >= 'A' && key <= 'Z') {
@@ -1354,11 +906,6 @@ static void confirm_ime_input(void) {
     clear_romaji_buffer();
     clear_hiragana_buffer();
 
-    prev_display_length = 0;
-    prev_display_chars = 0;
-    prev_romaji_pos = 0;
-
-    clear_ime_input_area();
     update_ime_display();
 }
 
@@ -1366,10 +913,6 @@ static void cancel_ime_input_internal(void) {
     clear_romaji_buffer();
     clear_hiragana_buffer();
 
-    prev_display_length = 0;
-    prev_display_chars = 0;
-    prev_romaji_pos = 0;
-
     update_ime_display();
 }
 static bool process_ime_key(uint8_t key) {
@@ -1420,9 +963,8 @@ static bool process_ime_key(uint8_t key) {
                 input_ime_char(KEY_SPACE);
             } else {
                 if (ime_conversion_state == IME_STATE_INPUT) {
-                    if (start_conversion()) {
-                        update_ime_display();
-                    } else {
+                    // The conversion itself runs from ime_process
+                    if (!start_conversion()) {
                         input_ime_char(KEY_SPACE);
                     }
                 } else {
@@ -1439,6 +981,27 @@ static bool process_ime_key(uint8_t key) {
                 return true;
             }
             return false;
+        case 0x1D:
+        case 0x9D:
+        case 0x11:
+        case 0x91:
+            // Cursor right/left: next/previous clause, down/up: longer/shorter clause
+            if (ime_conversion_state == IME_STATE_CONVERTING && clause_count != 0) {
+                if (key == 0x1D) {
+                    if ((uint8_t)(current_clause + 1) < clause_count) {
+                        load_clause((uint8_t)(current_clause + 1));
+                    }
+                } else if (key == 0x9D) {
+                    if (current_clause > 0) {
+                        load_clause((uint8_t)(current_clause - 1));
+                    }
+                } else {
+                    resize_clause(key == 0x11);
+                }
+                update_ime_display();
+                return true;
+            }
+            return false;
         default:
             if (key >= 32 && key <= 126) {
                 if (ime_conversion_state == IME_STATE_INPUT) {
@@ -1455,7 +1018,7 @@ static bool process_ime_key(uint8_t key) {
 
     return false;
 }
-void ime_init(void) {
+void ime_reset(void) {
     ime_active = false;
     ime_input_mode = IME_MODE_HIRAGANA;
 
@@ -1465,23 +1028,31 @@ void ime_init(void) {
 
     prev_commodore_state = false;
     prev_space_state = false;
-    prev_display_length = 0;
-    prev_display_chars = 0;
-    prev_romaji_pos = 0;
     ime_has_output = false;
     ime_output_length = 0;
 
     ime_conversion_state = IME_STATE_INPUT;
     candidate_count = 0;
     current_candidate = 0;
+    reading_candidate = CANDIDATE_NONE;
     conversion_key_length = 0;
-    candidate_buffer_pos = 0;
-    verb_candidate_count = 0;
-    match_candidate_count = 0;
     passthrough_key = 0;
+
+    multi_clause = false;
+    clause_count = 0;
+
+    presearch_state = PRESEARCH_IDLE;
+    presearch_dirty = false;
+    group_walk_pending = false;
+    lookup_budget = IME_LOOKUP_BUDGET;
 }
 
-void ime_toggle_mode(void) {
+void ime_init(void) {
+    ime_reset();
+    mru_clear();
+}
+
+void ime_toggle_mode(void) {
     ime_active = !ime_active;
     if (ime_active) {
         activate_ime_input();
@@ -1498,9 +1069,7 @@ void ime_set_hiragana_mode(void) {
     ime_input_mode = IME_MODE_HIRAGANA;
     if (hiragana_pos > 0) {
         convert_to_hiragana(hiragana_buffer);
-        prev_display_chars = 0;
-        prev_display_length = 0;
-        prev_romaji_pos = 0;
+        presearch_dirty = true;
         update_ime_display();
     }
     if (ime_active) {
@@ -1512,9 +1081,7 @@ void ime_set_katakana_mode(void) {
     ime_input_mode = IME_MODE_KATAKANA;
     if (hiragana_pos > 0) {
         convert_to_katakana(hiragana_buffer);
-        prev_display_chars = 0;
-        prev_display_length = 0;
-        prev_romaji_pos = 0;
+        presearch_dirty = true;
         update_ime_display();
     }
     if (ime_active) {
@@ -1529,6 +1096,14 @@ void ime_set_alphanumeric_mode(void) {
     }
 }
 
+void ime_set_multi_clause(bool enable) {
+    multi_clause = enable;
+}
+
+void ime_set_lookup_budget(uint8_t lookups) {
+    lookup_budget = lookups;
+}
+
 uint8_t ime_get_input_mode(void) {
     return ime_input_mode;
 }
@@ -1558,6 +1133,7 @@ static void restore_cursor(void) {
 uint8_t ime_process(void) {
     uint8_t key;
     uint8_t mode_event;
+    uint8_t event;
     bool handled;
     const uint8_t* output;
     uint8_t length;
@@ -1578,8 +1154,20 @@ uint8_t ime_process(void) {
         return IME_EVENT_NONE;
     }
 
+    // Keys wait in the keyboard buffer until the conversion is done
+    if (ime_conversion_state == IME_STATE_SEARCHING) {
+        backup_cursor();
+        event = convert_run();
+        restore_cursor();
+        return event;
+    }
+
     key = (uint8_t)cbm_k_getin();
     if (key == 0) {
+        // Idle: advance the dictionary pre-search by one step
+        if (ime_conversion_state == IME_STATE_INPUT) {
+            presearch_step();
+        }
         return IME_EVENT_NONE;
     }
 
@@ -1608,6 +1196,11 @@ uint8_t ime_process(void) {
     }
 
     handled = process_ime_key(key);
+    if (ime_conversion_state == IME_STATE_SEARCHING) {
+        event = convert_run();
+        restore_cursor();
+        return event;
+    }
     if (handled) {
         output = get_ime_output_internal();
         if (output != NULL) {
@@ -1655,6 +1248,11 @@ static uint8_t check_mode_keys(void) {
 static uint8_t petscii_to_ascii(uint8_t key) {
     uint8_t ascii = key;
 
+    // Cursor left/up keep the shift bit that tells them from right/down
+    if (key == 0x9D || key == 0x91) {
+        return key;
+    }
+
     if (ascii >= 128) {
         ascii &= 0x7F;
     }
@@ -1673,43 +1271,105 @@ static uint8_t petscii_to_ascii(uint8_t key) {
     return ascii;
 }
 
-static uint8_t read_rom_byte(uint8_t bank, uint16_t offset) {
-    uint8_t saved_01;
-    uint8_t value;
-
+//=============================================================================
+// Dictionary cursor
+//
+// dic_open maps the 8KB dictionary bank holding (current_bank,
+// current_offset) once and leaves the ROM window open; reads and skips then
+// walk a pointer through the window and only touch $DE00 when it crosses
+// an 8KB boundary. Keys are compared in place, so nothing is copied out of
+// ROM until candidates are collected. dic_close writes the position back to
+// current_bank/current_offset and restores $01.
+//
+// In a bank-aligned dictionary (DIC_ALIGNED) no entry crosses a bank, so
+// bytes inside an entry are read without the boundary check.
+//=============================================================================
+
+static uint8_t dic_saved_01;
+static const volatile uint8_t* dic_ptr;
+static const volatile uint8_t* dic_window;  // ROM address of offset 0 in current_bank
+
+static void dic_map(void) {
 #ifdef JTXT_EASYFLASH
-    // EasyFlash: map virtual 8KB banks to physical 16KB banks
-    // Virtual banks 10-27 → Physical banks 6-14 (2 virtual per 1 physical)
-    uint8_t virt = (uint8_t)(bank - IME_DICTIONARY_START_BANK);
-    uint8_t phys_bank = (uint8_t)(virt / 2 + IME_DIC_EF_START_BANK);
-    uint16_t phys_offset = (uint16_t)((virt & 1) * 0x2000 + offset);
+    // EasyFlash: two virtual 8KB banks per physical 16KB bank
+    uint8_t virt = (uint8_t)(current_bank - IME_DICTIONARY_START_BANK);
+    POKE(BANK_REG, (uint8_t)(virt / 2 + IME_DIC_EF_START_BANK));
+    dic_window = DIC_ROM + (uint16_t)(virt & 1) * 0x2000U;
 #else
-    uint8_t phys_bank = bank;
-    uint16_t phys_offset = offset;
+    POKE(BANK_REG, current_bank);
+    dic_window = DIC_ROM;
 #endif
+    dic_ptr = dic_window + current_offset;
+}
+
+static void dic_open(uint8_t bank, uint16_t offset) {
+    dic_saved_01 = PEEK(0x01);
+    POKE(0x01, dic_saved_01 | 0x01);
+    dic_seek(bank, offset);
+}
+
+// Cursor position as an offset within current_bank
+static uint16_t dic_tell(void) {
+    return (uint16_t)(dic_ptr - dic_window);
+}
 
-    saved_01 = PEEK(0x01);
-    POKE(0x01, saved_01 | 0x01);
-    POKE(BANK_REG, phys_bank);
-    value = PEEK(ROM_BASE + phys_offset);
-    POKE(0x01, saved_01);
-    return value;
+static void dic_close(void) {
+    current_offset = dic_tell();
+    POKE(0x01, dic_saved_01);
 }
 
 static uint8_t read_dic_byte(void) {
-    uint8_t data = read_rom_byte(current_bank, current_offset);
-    ++current_offset;
-    if (current_offset >= 8192) {
-        current_offset = 0;
+    uint8_t data = DIC_BYTE(dic_ptr++);
+    if (dic_ptr == dic_window + 8192U) {
         ++current_bank;
+        current_offset = 0;
+        dic_map();
     }
     return data;
 }
 
+// Read a byte of the entry at the cursor
+static uint8_t read_entry_byte(void) {
+    if (dic_aligned) {
+        return DIC_BYTE(dic_ptr++);
+    }
+    return read_dic_byte();
+}
+
+// Jump over size bytes without reading them
+static void dic_skip(uint16_t size) {
+    uint16_t offset = dic_tell() + size;
+    if (offset >= 8192U) {
+        current_bank = (uint8_t)(current_bank + offset / 8192U);
+        current_offset = offset % 8192U;
+        dic_map();
+    } else {
+        dic_ptr = dic_window + offset;
+    }
+}
+
+// Move the cursor; offset may run past the end of bank
+static void dic_seek(uint8_t bank, uint16_t offset) {
+    current_bank = (uint8_t)(bank + offset / 8192U);
+    current_offset = offset % 8192U;
+    dic_map();
+}
+
+// Read an L M H dictionary address at the cursor; false if it is zero
+static bool dic_read_address(uint8_t* bank, uint16_t* offset) {
+    uint8_t offset_low = read_dic_byte();
+    uint8_t offset_high = read_dic_byte();
+    uint8_t offset_bank = read_dic_byte();
+
+    *bank = (uint8_t)(IME_DICTIONARY_START_BANK + offset_bank);
+    *offset = mkword(offset_high, offset_low);
+    return offset_low != 0 || offset_high != 0 || offset_bank != 0;
+}
+
 static uint8_t read_dic_string(uint8_t* buffer) {
     uint8_t length = 0;
     while (length < 63) {
-        uint8_t ch = read_dic_byte();
+        uint8_t ch = read_entry_byte();
         buffer[length] = ch;
         if (ch == 0) {
             return length;
@@ -1720,6 +1380,75 @@ static uint8_t read_dic_string(uint8_t* buffer) {
     return length;
 }
 
+// Read a candidate string, expanding version 3 tokens: a byte in
+// 0x01-0x1F or 0xA0-0xDF where a character starts stands for a record of
+// the token table. Tokens are read from ROM, so nothing is kept in RAM.
+static uint8_t read_candidate(uint8_t* buffer) {
+    uint8_t length = 0;
+    uint8_t ch;
+
+    if (dic_version < DIC_COMPRESSED) {
+        return read_dic_string(buffer);
+    }
+
+    while ((ch = read_entry_byte()) != 0) {
+        if (ch < 0x20 || (ch >= 0xA0 && ch < 0xE0)) {
+            uint8_t bank = current_bank;
+            uint16_t offset = dic_tell();
+            uint8_t token = ch < 0x20 ? (uint8_t)(ch - 0x01) : (uint8_t)(ch - 0xA0 + 0x1F);
+            uint8_t i;
+
+            dic_seek(IME_DICTIONARY_START_BANK, (uint16_t)(DIC_TOKEN_TABLE + (uint16_t)token * DIC_TOKEN_SIZE));
+            for (i = 0; i < DIC_TOKEN_SIZE; ++i) {
+                ch = read_dic_byte();
+                if (ch == 0) {
+                    break;
+                }
+                if (length < 63) {
+                    buffer[length++] = ch;
+                }
+            }
+            dic_seek(bank, offset);
+        } else {
+            if (length < 63) {
+                buffer[length++] = ch;
+            }
+            // Lead byte: the trail byte is never a token
+            if (ch >= 0x81 && (ch < 0xA0 || (ch >= 0xE0 && ch <= 0xFC))) {
+                ch = read_entry_byte();
+                if (length < 63) {
+                    buffer[length++] = ch;
+                }
+            }
+        }
+    }
+    buffer[length] = 0;
+    return length;
+}
+
+// Compare the entry key at the cursor with key_buffer in place and move
+// past its terminator. Returns the key length; *same gets the number of
+// leading bytes equal to key_buffer, *last the final key byte.
+static uint8_t dic_compare_key(const uint8_t* key_buffer, uint8_t key_length,
+                               uint8_t* same, uint8_t* last) {
+    uint8_t length = 0;
+    uint8_t equal = 0;
+    uint8_t prev = 0;
+    uint8_t ch;
+
+    while ((ch = read_entry_byte()) != 0) {
+        if (equal == length && length < key_length && key_buffer[length] == ch) {
+            ++equal;
+        }
+        prev = ch;
+        ++length;
+    }
+
+    *same = equal;
+    *last = prev;
+    return length;
+}
+
 
 static uint8_t hiragana_to_index(uint8_t first_byte, uint8_t second_byte) {
     uint16_t ch = mkword(first_byte, second_byte);
@@ -1786,10 +1515,11 @@ static bool check_okurigana_match(const uint8_t* okurigana_buffer, uint8_t verb_
 }
 static bool search_noun_entries(const uint8_t* key_buffer, uint8_t key_length) {
     uint8_t index;
-    uint8_t offset_low;
-    uint8_t offset_high;
-    uint8_t offset_bank;
+    uint8_t group_bank;
+    uint16_t group_offset;
+    bool found = false;
 
+    ++lookup_count;
     if (key_length < 2) {
         return false;
     }
@@ -1799,28 +1529,31 @@ static bool search_noun_entries(const uint8_t* key_buffer, uint8_t key_length) {
         return false;
     }
 
-    current_bank = IME_DICTIONARY_START_BANK;
-    current_offset = (uint16_t)(4 + (uint16_t)index * 3U);
-
-    offset_low = read_dic_byte();
-    offset_high = read_dic_byte();
-    offset_bank = read_dic_byte();
-
-    if (offset_low == 0 && offset_high == 0 && offset_bank == 0) {
-        return false;
+    if (dic_version != 0) {
+        return search_indexed_entries(key_buffer, key_length, false, index);
     }
 
-    current_bank = (uint8_t)(IME_DICTIONARY_START_BANK + offset_bank);
-    current_offset = mkword(offset_high, offset_low);
-    return search_entries_in_group(key_buffer, key_length, false);
+    if (group_walk_pending) {
+        dic_open(group_walk_bank, group_walk_offset);
+        found = search_entries_in_group(key_buffer, key_length, false);
+    } else {
+        dic_open(IME_DICTIONARY_START_BANK, (uint16_t)(DIC_NOUN_TABLE + (uint16_t)index * 3U));
+        if (dic_read_address(&group_bank, &group_offset)) {
+            dic_seek(group_bank, group_offset);
+            found = search_entries_in_group(key_buffer, key_length, false);
+        }
+    }
+    dic_close();
+    return found;
 }
 
 static bool search_verb_entries(const uint8_t* key_buffer, uint8_t key_length) {
     uint8_t index;
-    uint8_t offset_low;
-    uint8_t offset_high;
-    uint8_t offset_bank;
+    uint8_t group_bank;
+    uint16_t group_offset;
+    bool found = false;
 
+    ++lookup_count;
     if (key_length < 2) {
         return false;
     }
@@ -1830,113 +1563,73 @@ static bool search_verb_entries(const uint8_t* key_buffer, uint8_t key_length) {
         return false;
     }
 
-    current_bank = IME_DICTIONARY_START_BANK;
-    current_offset = (uint16_t)(250 + (uint16_t)index * 3U);
-
-    offset_low = read_dic_byte();
-    offset_high = read_dic_byte();
-    offset_bank = read_dic_byte();
-
-    if (offset_low == 0 && offset_high == 0 && offset_bank == 0) {
-        return false;
+    if (dic_version != 0) {
+        return search_indexed_entries(key_buffer, key_length, true, index);
     }
 
-    current_bank = (uint8_t)(IME_DICTIONARY_START_BANK + offset_bank);
-    current_offset = mkword(offset_high, offset_low);
-    return search_entries_in_group(key_buffer, key_length, true);
+    if (group_walk_pending) {
+        dic_open(group_walk_bank, group_walk_offset);
+        found = search_entries_in_group(key_buffer, key_length, true);
+    } else {
+        dic_open(IME_DICTIONARY_START_BANK, (uint16_t)(DIC_VERB_TABLE + (uint16_t)index * 3U));
+        if (dic_read_address(&group_bank, &group_offset)) {
+            dic_seek(group_bank, group_offset);
+            found = search_entries_in_group(key_buffer, key_length, true);
+        }
+    }
+    dic_close();
+    return found;
 }
 static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search) {
     uint8_t skip_low;
     uint8_t skip_high;
     uint16_t skip_size;
-    uint8_t prev_skip_high;
+    uint8_t entries = 0;
 
     candidate_count = 0;
 
-    skip_low = read_dic_byte();
-    skip_high = read_dic_byte();
-    skip_size = (uint16_t)(mkword(skip_high, skip_low) & 0x7FFFU);
+    if (group_walk_pending) {
+        // The cursor is at the key of the saved entry
+        group_walk_pending = false;
+        skip_size = group_walk_skip;
+    } else {
+        skip_low = read_dic_byte();
+        skip_high = read_dic_byte();
+        skip_size = (uint16_t)(mkword(skip_high, skip_low) & 0x7FFFU);
+    }
 
     for (;;) {
-        uint8_t entry_key_buffer[64];
         uint8_t entry_key_length;
-        bool should_check;
-        bool match;
-        uint8_t compare_length;
+        uint8_t same;
         uint8_t last_char;
+        bool match = false;
 
-        entry_key_length = read_dic_string(entry_key_buffer);
+        entry_key_length = dic_compare_key(key_buffer, key_length, &same, &last_char);
 
-        should_check = false;
-        if (is_verb_search) {
-            if (entry_key_length > 0 && entry_key_buffer[entry_key_length - 1] < 128) {
-                if (key_length >= (uint8_t)(entry_key_length - 1)) {
-                    should_check = true;
-                }
-            }
-        } else if (entry_key_length > 0 && key_length >= entry_key_length) {
-            should_check = true;
+        // Longest keys come first: the rest are all at or below the floor
+        if (search_floor != 0 && entry_key_length <= search_floor) {
+            break;
         }
 
-        if (should_check) {
-            uint8_t okurigana_high = 0;
-            uint8_t okurigana_low = 0;
-
-
-            match = true;
-            compare_length = entry_key_length;
-
+        if (entry_key_length > 0) {
             if (is_verb_search) {
-                compare_length = (uint8_t)(entry_key_length - 1);
-            }
-
-            {
-                uint8_t i;
-                for (i = 0; i < compare_length; ++i) {
-                    if (key_buffer[i] != entry_key_buffer[i]) {
-                        match = false;
-                        break;
-                    }
-                }
-            }
-
-            if (is_verb_search && match) {
-                last_char = entry_key_buffer[compare_length];
-                if (last_char < 128) {
+                // Kana stem must match; the final ASCII byte names the okurigana row
+                uint8_t compare_length = (uint8_t)(entry_key_length - 1);
+                if (last_char < 128 && key_length >= compare_length && same >= compare_length) {
                     match = check_okurigana_match(&key_buffer[compare_length], last_char);
-                    entry_key_length = (uint8_t)(compare_length + 1);
-                } else {
-                    match = false;
-                }
-            }
-
-            if (match) {
-                match_length = entry_key_length;
-                match_bank = current_bank;
-                match_offset = current_offset;
-                match_okurigana = 0;
-
-                current_entry_length = entry_key_length;
-                if (is_verb_search) {
-                    ++current_entry_length;
-                    if (key_length > (uint8_t)(entry_key_length - 1) && key_length > entry_key_length) {
-                        okurigana_high = key_buffer[entry_key_length - 1];
-                        okurigana_low = key_buffer[entry_key_length];
-                        match_okurigana = mkword(okurigana_high, okurigana_low);
-                    }
                 }
-
-                return true;
+            } else if (key_length >= entry_key_length && same == entry_key_length) {
+                match = true;
             }
         }
 
-        {
-            uint16_t i;
-            for (i = 0; i < skip_size; ++i) {
-                (void)read_dic_byte();
-            }
+        if (match) {
+            record_match(key_buffer, key_length, entry_key_length, is_verb_search);
+            return true;
         }
 
+        dic_skip(skip_size);
+
         skip_low = read_dic_byte();
         skip_high = read_dic_byte();
         skip_size = (uint16_t)(mkword(skip_high, skip_low) & 0x7FFFU);
@@ -1944,231 +1637,1499 @@ static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_lengt
         if ((skip_high & 0x80U) != 0U) {
             break;
         }
+
+        if (group_walk_limit != 0 && ++entries >= group_walk_limit) {
+            group_walk_pending = true;
+            group_walk_bank = current_bank;
+            group_walk_offset = dic_tell();
+            group_walk_skip = skip_size;
+            break;
+        }
     }
 
     return false;
 }
-static void add_candidates(uint16_t okurigana) {
-    uint8_t num_candidates = read_dic_byte();
 
-    {
-        uint8_t i;
-        for (i = 0; i < num_candidates; ++i) {
-            uint8_t candidate_length;
+//=============================================================================
+// Second-level index (dictionary version 1 to 3)
+//
+// Each group has a directory of [slot, L, M, H] records ending in 0xFF. The
+// slot is the index of the second kana (DIC_SLOT_OTHER for other
+// characters, DIC_SLOT_SHORT for one-kana keys and stems); the one-kana
+// slot comes first and the rest ascend. Every directory record points at a
+// list of [key bytes, count, L, M, H] runs ending in 0, longest keys first.
+// A run is a block of entries sharing the first two characters and the key
+// length, sorted by key bytes, so a lookup only reads the runs of its own
+// second kana followed by the one-kana keys.
+//
+// Version 3 entries leave out the key bytes the run implies: the group's
+// kana, plus the slot's kana for second-kana slots (key_start 2 or 4).
+//=============================================================================
+
+static bool search_indexed_entries(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search, uint8_t index) {
+    uint8_t slot = DIC_SLOT_SHORT;
+    uint8_t entry_slot;
+    uint8_t list_bank[2];
+    uint16_t list_offset[2];
+    uint8_t list_key_start[2];
+    uint8_t lists = 0;
+    bool found = false;
 
-            if (candidate_count >= MAX_CANDIDATES) {
-                break;
-            }
+    candidate_count = 0;
 
-            if (candidate_buffer_pos >= CANDIDATE_BUFFER_SIZE - 1) {
-                break;
-            }
+    if (key_length >= 4) {
+        slot = hiragana_to_index(key_buffer[2], key_buffer[3]);
+        if (slot == 0xFF) {
+            slot = DIC_SLOT_OTHER;
+        }
+    }
 
-            candidate_offsets[candidate_count] = candidate_buffer_pos;
-            candidate_length = read_dic_string(&candidates_buffer[candidate_buffer_pos]);
-            candidate_buffer_pos = (uint8_t)(candidate_buffer_pos + candidate_length + 1);
+    dic_open(IME_DICTIONARY_START_BANK,
+             (uint16_t)((is_verb_search ? DIC_VERB_INDEX_TABLE : DIC_NOUN_INDEX_TABLE) + (uint16_t)index * 3U));
+    if (dic_read_address(&list_bank[0], &list_offset[0])) {
+        dic_seek(list_bank[0], list_offset[0]);
 
-            if (okurigana != 0) {
-                if (candidate_buffer_pos >= CANDIDATE_BUFFER_SIZE - 2) {
-                    candidates_buffer[CANDIDATE_BUFFER_SIZE - 1] = 0;
-                    break;
-                }
-                --candidate_buffer_pos;
-                candidates_buffer[candidate_buffer_pos++] = msb16(okurigana);
-                candidates_buffer[candidate_buffer_pos++] = lsb16(okurigana);
-                candidates_buffer[candidate_buffer_pos++] = 0;
+        while ((entry_slot = read_dic_byte()) != DIC_DIRECTORY_END) {
+            if (entry_slot == slot || entry_slot == DIC_SLOT_SHORT) {
+                (void)dic_read_address(&list_bank[lists], &list_offset[lists]);
+                list_key_start[lists] = entry_slot < DIC_SLOT_OTHER ? 4 : 2;
+                ++lists;
+            } else {
+                dic_skip(3);
+            }
+            if (entry_slot == slot || (entry_slot != DIC_SLOT_SHORT && entry_slot > slot)) {
+                break;
             }
+        }
 
-            ++candidate_count;
+        // Second-kana runs hold the longer keys, so they go before the one-kana slot
+        while (lists != 0 && !found) {
+            --lists;
+            dic_seek(list_bank[lists], list_offset[lists]);
+            found = search_run_list(key_buffer, key_length, is_verb_search, list_key_start[lists]);
         }
     }
+    dic_close();
+    return found;
 }
-static bool start_conversion(void) {
-    bool found = false;
-    bool verb_found = false;
-    bool noun_found = false;
-    uint8_t magic0;
-    uint8_t magic1;
-    uint8_t magic2;
 
-    if (hiragana_pos == 0) {
-        return false;
-    }
+static bool search_run_list(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search, uint8_t key_start) {
+    uint8_t key_bytes;
 
-    conversion_key_length = hiragana_pos;
-    if (conversion_key_length > sizeof(conversion_key_buffer)) {
-        conversion_key_length = sizeof(conversion_key_buffer);
-    }
-    memcpy(conversion_key_buffer, hiragana_buffer, conversion_key_length);
+    while ((key_bytes = read_dic_byte()) != 0) {
+        uint8_t count;
+        uint8_t entry_bank;
+        uint16_t entry_offset;
+        uint8_t list_bank;
+        uint16_t list_offset;
 
-    current_bank = IME_DICTIONARY_START_BANK;
-    current_offset = 0;
-    magic0 = read_rom_byte(IME_DICTIONARY_START_BANK, 0);
-    magic1 = read_rom_byte(IME_DICTIONARY_START_BANK, 1);
-    magic2 = read_rom_byte(IME_DICTIONARY_START_BANK, 2);
+        // Runs are longest first, so the rest are at or below the floor too
+        if (key_bytes <= search_floor) {
+            return false;
+        }
 
-    if (magic0 != 'D' || magic1 != 'I' || magic2 != 'C') {
-        return false;
+        // Keys (verb stems) longer than the input cannot match
+        if ((is_verb_search ? (uint8_t)(key_bytes - 1) : key_bytes) > key_length) {
+            dic_skip(4);
+            continue;
+        }
+
+        count = read_dic_byte();
+        (void)dic_read_address(&entry_bank, &entry_offset);
+        list_bank = current_bank;
+        list_offset = dic_tell();
+
+        dic_seek(entry_bank, entry_offset);
+        if (dic_version >= 2) {
+            if (search_run_sorted(key_buffer, key_length, is_verb_search, key_bytes, count, key_start)) {
+                return true;
+            }
+        } else if (search_run(key_buffer, key_length, is_verb_search, key_bytes, count)) {
+            return true;
+        }
+        dic_seek(list_bank, list_offset);
     }
 
+    return false;
+}
 
-    candidate_buffer_pos = 0;
-    candidate_count = 0;
-    current_candidate = 0;
-    candidates_buffer[0] = 0;
-    verb_candidate_count = 0;
-    match_candidate_count = 0;
-    is_verb_first = false;
+// Every key in a run is key_bytes long and the run is sorted, so a key is
+// dropped at its first differing byte and the run ends at the first key
+// that sorts after key_buffer.
+static bool search_run(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                       uint8_t key_bytes, uint8_t count) {
+    uint8_t stem_length = is_verb_search ? (uint8_t)(key_bytes - 1) : key_bytes;
 
-    found = search_verb_entries(conversion_key_buffer, conversion_key_length);
-    verb_found = found;
+    while (count != 0) {
+        uint8_t skip_low;
+        uint8_t skip_high;
+        uint16_t skip_size;
+        uint8_t ch = 0;
+        uint8_t i;
 
-    if (verb_found) {
-        verb_match_length = match_length;
-        verb_match_bank = match_bank;
-        verb_match_offset = match_offset;
-        verb_match_okurigana = match_okurigana;
-    }
+        --count;
+        skip_low = read_dic_byte();
+        skip_high = read_dic_byte();
+        skip_size = (uint16_t)(mkword(skip_high, skip_low) & 0x7FFFU);
 
-    noun_found = search_noun_entries(conversion_key_buffer, conversion_key_length);
+        for (i = 0; i < stem_length; ++i) {
+            ch = read_dic_byte();
+            if (ch != key_buffer[i]) {
+                break;
+            }
+        }
 
-    if (noun_found && verb_found) {
-        is_verb_first = verb_match_length > match_length;
-        if (is_verb_first) {
-            current_bank = verb_match_bank;
-            current_offset = verb_match_offset;
-            add_candidates(verb_match_okurigana);
-            verb_candidate_count = candidate_count;
+        if (i < stem_length) {
+            if (ch > key_buffer[i]) {
+                return false;
+            }
+            // Rest of the key, its terminator and the candidates
+            dic_skip((uint16_t)(key_bytes - i) + skip_size);
+            continue;
+        }
 
-            current_bank = match_bank;
-            current_offset = match_offset;
-            add_candidates(0);
-            match_candidate_count = candidate_count - verb_candidate_count;
+        if (is_verb_search) {
+            uint8_t verb_suffix = read_dic_byte();
+            (void)read_dic_byte();
+            if (!check_okurigana_match(&key_buffer[stem_length], verb_suffix)) {
+                dic_skip(skip_size);
+                continue;
+            }
         } else {
-            current_bank = match_bank;
-            current_offset = match_offset;
-            add_candidates(0);
-            match_candidate_count = candidate_count;
-
-            current_bank = verb_match_bank;
-            current_offset = verb_match_offset;
-            add_candidates(verb_match_okurigana);
-            verb_candidate_count = (uint8_t)(candidate_count - match_candidate_count);
+            (void)read_dic_byte();
         }
-    } else if (noun_found) {
-        current_bank = match_bank;
-        current_offset = match_offset;
-        add_candidates(0);
-        match_candidate_count = candidate_count;
-    } else if (verb_found) {
-        is_verb_first = true;
-        current_bank = verb_match_bank;
-        current_offset = verb_match_offset;
-        add_candidates(verb_match_okurigana);
-        verb_candidate_count = candidate_count;
-    }
 
-    if (noun_found || verb_found) {
-        ime_conversion_state = IME_STATE_CONVERTING;
-        current_candidate = 0;
-        return candidate_count > 0;
+        record_match(key_buffer, key_length, key_bytes, is_verb_search);
+        return true;
     }
 
     return false;
 }
-static void next_candidate(void) {
-    if (ime_conversion_state == IME_STATE_CONVERTING && candidate_count > 0) {
-        ++current_candidate;
-        if (current_candidate >= candidate_count) {
-            current_candidate = 0;
-        }
-    }
-}
 
-static void prev_candidate(void) {
-    if (ime_conversion_state == IME_STATE_CONVERTING && candidate_count > 0) {
-        if (current_candidate == 0) {
-            current_candidate = (uint8_t)(candidate_count - 1);
+// Version 2 run addresses point into the group's pointer table (3-byte
+// entry addresses in entry order). Binary search for the first key whose
+// stem is not below key_buffer, then walk forward while the stem matches:
+// nouns match on the first hit, verbs try each okurigana row in turn.
+// Version 3 has no entry chain, so short runs are binary searched too.
+static bool search_run_sorted(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                              uint8_t key_bytes, uint8_t count, uint8_t key_start) {
+    uint8_t table_bank = current_bank;
+    uint16_t table_offset = dic_tell();
+    uint8_t stem_length = is_verb_search ? (uint8_t)(key_bytes - 1) : key_bytes;
+    uint8_t low = 0;
+    uint8_t high = count;
+
+    if (count < DIC_SORTED_RUN_MIN && dic_version < DIC_COMPRESSED) {
+        // Short runs: walk the entry chain from the first pointer
+        uint8_t entry_bank;
+        uint16_t entry_offset;
+        (void)dic_read_address(&entry_bank, &entry_offset);
+        dic_seek(entry_bank, entry_offset);
+        return search_run(key_buffer, key_length, is_verb_search, key_bytes, count);
+    }
+
+    while (low < high) {
+        uint8_t mid = (uint8_t)(((uint16_t)low + high) / 2U);
+        if (compare_run_entry(table_bank, table_offset, mid, key_buffer, key_start, stem_length) < 0) {
+            low = (uint8_t)(mid + 1);
         } else {
-            --current_candidate;
+            high = mid;
         }
     }
-}
 
-static uint8_t* get_current_candidate(void) {
-    if (ime_conversion_state == IME_STATE_CONVERTING && candidate_count > 0 &&
-        current_candidate < candidate_count) {
-        return &candidates_buffer[candidate_offsets[current_candidate]];
+    for (; low < count; ++low) {
+        if (compare_run_entry(table_bank, table_offset, low, key_buffer, key_start, stem_length) != 0) {
+            break;
+        }
+        if (is_verb_search) {
+            uint8_t verb_suffix = read_dic_byte();
+            if (dic_version < DIC_COMPRESSED) {
+                (void)read_dic_byte();
+            }
+            if (!check_okurigana_match(&key_buffer[stem_length], verb_suffix)) {
+                continue;
+            }
+        } else if (dic_version < DIC_COMPRESSED) {
+            (void)read_dic_byte();
+        }
+
+        record_match(key_buffer, key_length, key_bytes, is_verb_search);
+        return true;
     }
-    return NULL;
+
+    return false;
 }
-static void confirm_conversion(void) {
-    if (ime_conversion_state == IME_STATE_CONVERTING) {
-        uint8_t* candidate_str = get_current_candidate();
-        if (candidate_str != NULL) {
-            uint8_t i;
-            uint8_t entry_length;
-            uint8_t remaining;
 
-            ime_output_length = 0;
-            i = 0;
-            while (candidate_str[i] != 0 && ime_output_length < sizeof(ime_output_buffer)) {
-                ime_output_buffer[ime_output_length++] = candidate_str[i++];
-            }
-            if (ime_output_length < sizeof(ime_output_buffer)) {
-                ime_output_buffer[ime_output_length] = 0;
-            }
+// Compare the first stem_length key bytes of run entry index with
+// key_buffer. On equality the cursor is left just after them.
+static int8_t compare_run_entry(uint8_t table_bank, uint16_t table_offset, uint8_t index,
+                                const uint8_t* key_buffer, uint8_t key_start, uint8_t stem_length) {
+    uint8_t entry_bank;
+    uint16_t entry_offset;
+    uint8_t i;
 
-            entry_length = 0;
-            if (is_verb_first) {
-                if (current_candidate < verb_candidate_count) {
-                    entry_length = (uint8_t)(verb_match_length + 1);
-                } else {
-                    entry_length = match_length;
-                }
-            } else {
-                if (current_candidate < match_candidate_count) {
-                    entry_length = match_length;
-                } else {
-                    entry_length = (uint8_t)(verb_match_length + 1);
-                }
-            }
+    dic_seek(table_bank, (uint16_t)(table_offset + (uint16_t)index * 3U));
+    (void)dic_read_address(&entry_bank, &entry_offset);
+    if (dic_version >= DIC_COMPRESSED) {
+        // Key starts right away, without the bytes the run implies
+        dic_seek(entry_bank, entry_offset);
+        i = key_start;
+    } else {
+        // Skip the entry size
+        dic_seek(entry_bank, (uint16_t)(entry_offset + 2U));
+        i = 0;
+    }
 
-            if (entry_length > hiragana_pos) {
-                entry_length = hiragana_pos;
-            }
+    if (dic_aligned) {
+        // The key is within the window: index it directly
+        const volatile uint8_t* entry_key = dic_ptr;
+        const uint8_t* key = key_buffer + i;
+        uint8_t length = i < stem_length ? (uint8_t)(stem_length - i) : 0;
 
-            if (entry_length > 0) {
-                remaining = (uint8_t)(hiragana_pos - entry_length);
-                memmove(hiragana_buffer, &hiragana_buffer[entry_length], remaining);
-                hiragana_pos = remaining;
-                if (hiragana_pos < HIRAGANA_BUFFER_SIZE) {
-                    memset(&hiragana_buffer[hiragana_pos], 0, HIRAGANA_BUFFER_SIZE - hiragana_pos);
-                }
+        for (i = 0; i < length; ++i) {
+            uint8_t ch = DIC_BYTE(entry_key + i);
+            if (ch != key[i]) {
+                return ch < key[i] ? -1 : 1;
             }
+        }
+        dic_ptr = entry_key + length;
+        return 0;
+    }
 
-            clear_ime_input_area();
-            ime_has_output = true;
+    for (; i < stem_length; ++i) {
+        uint8_t ch = read_dic_byte();
+        if (ch != key_buffer[i]) {
+            return ch < key_buffer[i] ? -1 : 1;
         }
     }
+    return 0;
+}
 
-    cancel_conversion();
+// Remember the entry whose candidate count is at the cursor
+static void record_match(const uint8_t* key_buffer, uint8_t key_length, uint8_t entry_key_length, bool is_verb_search) {
+    match_length = entry_key_length;
+    match_bank = current_bank;
+    match_offset = dic_tell();
+    match_okurigana = 0;
+
+    current_entry_length = entry_key_length;
+    if (is_verb_search) {
+        ++current_entry_length;
+        if (key_length > (uint8_t)(entry_key_length - 1) && key_length > entry_key_length) {
+            match_okurigana = mkword(key_buffer[entry_key_length - 1], key_buffer[entry_key_length]);
+        }
+    }
+}
+
+// Register the candidate list of the entry at current_bank/current_offset;
+// the strings stay in ROM until fetch_candidate needs one
+static void add_candidates(uint16_t okurigana, uint8_t entry_length) {
+    uint8_t group = candidate_groups;
+
+    if (group >= CANDIDATE_GROUPS) {
+        return;
+    }
+
+    dic_open(current_bank, current_offset);
+    group_size[group] = read_dic_byte();
+    dic_close();
+
+    group_bank[group] = current_bank;
+    group_offset[group] = current_offset;
+    group_length[group] = entry_length;
+    group_okurigana[group] = okurigana;
+    ++candidate_groups;
+}
+
+static void skip_dic_string(void) {
+    while (read_entry_byte() != 0) {
+    }
+}
+
+// Compare the candidate string at the cursor (plus okurigana) with text and
+// move past its terminator. Decodes through candidate_text.
+static bool match_dic_string(const uint8_t* text, uint16_t okurigana) {
+    uint8_t length = read_candidate(candidate_text);
+
+    if (strncmp((const char*)candidate_text, (const char*)text, length) != 0) {
+        return false;
+    }
+    if (okurigana != 0) {
+        if (text[length] != msb16(okurigana) || text[length + 1] != lsb16(okurigana)) {
+            return false;
+        }
+        length = (uint8_t)(length + 2);
+    }
+    return text[length] == 0;
+}
+
+// Candidate order is the cached candidate (if any), then every group in
+// turn with the cached candidate's duplicate left out. A clause also has
+// its kana at reading_candidate. Returns the group (or CANDIDATE_CACHED,
+// CANDIDATE_READING) and the index within it.
+static uint8_t locate_candidate(uint8_t index, uint8_t* group_index) {
+    uint16_t position = index;
+
+    if (reading_candidate != CANDIDATE_NONE) {
+        if (index == reading_candidate) {
+            return CANDIDATE_READING;
+        }
+        if (index > reading_candidate) {
+            --position;
+        }
+    }
+    if (cached_candidate != MRU_NONE) {
+        if (position == 0) {
+            return CANDIDATE_CACHED;
+        }
+        --position;
+        if (position >= skip_position) {
+            ++position;
+        }
+    }
+    if (position < group_size[0]) {
+        *group_index = (uint8_t)position;
+        return 0;
+    }
+    *group_index = (uint8_t)(position - group_size[0]);
+    return 1;
+}
+
+// Read one candidate into candidate_text. Stepping forward continues from
+// where the previous fetch stopped; anything else walks the group from its
+// first string.
+static void fetch_candidate(uint8_t index) {
+    uint8_t group;
+    uint8_t group_index;
+    uint8_t length;
+    uint8_t i;
+
+    group = locate_candidate(index, &group_index);
+    if (group == CANDIDATE_CACHED) {
+        strcpy((char*)candidate_text, (const char*)mru_candidate[cached_candidate]);
+        return;
+    }
+    if (group == CANDIDATE_READING) {
+        length = (uint8_t)(clause_start[current_clause + 1] - clause_start[current_clause]);
+        memcpy(candidate_text, &hiragana_buffer[clause_start[current_clause]], length);
+        candidate_text[length] = 0;
+        return;
+    }
+
+    if (stream_group == group && stream_index <= group_index) {
+        dic_open(stream_bank, stream_offset);
+        i = stream_index;
+    } else {
+        dic_open(group_bank[group], group_offset[group]);
+        i = 0;
+    }
+    for (; i < group_index; ++i) {
+        skip_dic_string();
+    }
+
+    length = read_candidate(candidate_text);
+    if (group_okurigana[group] != 0) {
+        candidate_text[length++] = msb16(group_okurigana[group]);
+        candidate_text[length++] = lsb16(group_okurigana[group]);
+        candidate_text[length] = 0;
+    }
+    dic_close();
+
+    stream_group = group;
+    stream_index = (uint8_t)(group_index + 1);
+    stream_bank = current_bank;
+    stream_offset = current_offset;
+}
+
+static bool check_dictionary(void) {
+    uint8_t magic0;
+    uint8_t magic1;
+    uint8_t magic2;
+    uint8_t version;
+
+    dic_open(IME_DICTIONARY_START_BANK, 0);
+    magic0 = read_dic_byte();
+    magic1 = read_dic_byte();
+    magic2 = read_dic_byte();
+    version = read_dic_byte();
+    dic_close();
+
+    if (magic0 != 'D' || magic1 != 'I' || magic2 != 'C') {
+        return false;
+    }
+    // 0: first-kana tables only, 1: second-level index follows them,
+    // 2: runs also have a sorted pointer table, 3: compressed entries.
+    // Bit 7: bank-aligned entries
+    dic_version = version & DIC_VERSION_MASK;
+    dic_aligned = (version & DIC_ALIGNED) != 0;
+    return true;
+}
+
+//=============================================================================
+// Pre-search
+//
+// While kana are typed, ime_process advances the dictionary lookup by one
+// step per idle call: the first step snapshots hiragana_buffer into
+// conversion_key_buffer and runs the verb search, the second the noun
+// search. Each step is a single indexed lookup, so the caller's loop is
+// never held up for long. Any edit of hiragana_buffer sets presearch_dirty
+// and the lookup restarts; SPACE only finishes the remaining steps and
+// collects the candidates. Results live in verb_match_* and match_*.
+//
+// Typing more kana only extends the key. Every entry matching the old key
+// still matches, and a longer match needs a key longer than the old one,
+// so a finished step keeps its result and searches above the old length
+// only (the floor). Backspace and other edits restart from scratch.
+//
+// A version 0 group is a linear chain, so a step walks DIC_GROUP_WALK
+// entries of it at most and the next step of the same search goes on
+// from there (group_walk_*).
+//=============================================================================
+
+static void presearch_step(void) {
+    bool found;
+
+    if (presearch_dirty) {
+        uint8_t length = hiragana_pos;
+        bool extends;
+
+        presearch_dirty = false;
+        group_walk_pending = false;
+        if (length > sizeof(conversion_key_buffer)) {
+            length = sizeof(conversion_key_buffer);
+        }
+        extends = presearch_state != PRESEARCH_IDLE && length > conversion_key_length &&
+                  memcmp(conversion_key_buffer, hiragana_buffer, conversion_key_length) == 0;
+        presearch_verb_floor = 0;
+        presearch_noun_floor = 0;
+        if (extends) {
+            // The verb step is done from PRESEARCH_NOUN on, the noun step at PRESEARCH_DONE
+            if (presearch_state != PRESEARCH_VERB) {
+                presearch_verb_floor = conversion_key_length;
+            }
+            if (presearch_state == PRESEARCH_DONE) {
+                presearch_noun_floor = conversion_key_length;
+            }
+        }
+        presearch_state = PRESEARCH_IDLE;
+        if (hiragana_pos == 0 || !check_dictionary()) {
+            return;
+        }
+
+        conversion_key_length = length;
+        // Zero the tail: the verb search reads the okurigana past the key,
+        // and a shorter key must not see kana left over from a longer one
+        memcpy(conversion_key_buffer, hiragana_buffer, conversion_key_length);
+        memset(&conversion_key_buffer[conversion_key_length], 0,
+               sizeof(conversion_key_buffer) - conversion_key_length);
+        presearch_state = PRESEARCH_VERB;
+    }
+
+    switch (presearch_state) {
+        case PRESEARCH_VERB:
+            search_floor = presearch_verb_floor;
+            group_walk_limit = DIC_GROUP_WALK;
+            found = search_verb_entries(conversion_key_buffer, conversion_key_length);
+            search_floor = 0;
+            group_walk_limit = 0;
+            if (group_walk_pending) {
+                break;
+            }
+            if (found) {
+                presearch_verb_found = true;
+                verb_match_length = match_length;
+                verb_match_bank = match_bank;
+                verb_match_offset = match_offset;
+                verb_match_okurigana = match_okurigana;
+            } else if (presearch_verb_floor == 0) {
+                presearch_verb_found = false;
+            }
+            presearch_state = PRESEARCH_NOUN;
+            break;
+        case PRESEARCH_NOUN:
+            search_floor = presearch_noun_floor;
+            group_walk_limit = DIC_GROUP_WALK;
+            found = search_noun_entries(conversion_key_buffer, conversion_key_length);
+            search_floor = 0;
+            group_walk_limit = 0;
+            if (group_walk_pending) {
+                break;
+            }
+            if (found) {
+                presearch_noun_found = true;
+                noun_match_length = match_length;
+                noun_match_bank = match_bank;
+                noun_match_offset = match_offset;
+            } else if (presearch_noun_floor == 0) {
+                presearch_noun_found = false;
+            } else if (presearch_noun_found) {
+                // The verb step may have overwritten match_*
+                match_length = noun_match_length;
+                match_bank = noun_match_bank;
+                match_offset = noun_match_offset;
+                match_okurigana = 0;
+            }
+            presearch_state = PRESEARCH_DONE;
+            break;
+        default:
+            break;
+    }
+}
+
+#ifdef IME_BENCH
+// The lookups of one pre-search (verb, then noun) for a fixed reading, so a
+// benchmark can time the dictionary search without keyboard input
+bool ime_bench_lookup(const uint8_t* key, uint8_t length) {
+    bool verb_found;
+
+    if (length == 0 || length > sizeof(conversion_key_buffer) || !check_dictionary()) {
+        return false;
+    }
+    memcpy(conversion_key_buffer, key, length);
+    memset(&conversion_key_buffer[length], 0, sizeof(conversion_key_buffer) - length);
+    verb_found = search_verb_entries(conversion_key_buffer, length);
+    return search_noun_entries(conversion_key_buffer, length) || verb_found;
+}
+#endif
+
+//=============================================================================
+// Conversion cache
+//
+// A small RAM table of reading -> last confirmed candidate. Entries hang off
+// mru_bucket[] by a hash of the reading (chained through mru_next[]) and
+// mru_order[] keeps them most recently used first, so the last slot is the
+// one evicted when the table is full. start_conversion looks up the longest
+// cached prefix of the input and promote_candidate moves that candidate to
+// position 0. ime_mru_save/ime_mru_load keep the table in a disk file.
+//=============================================================================
+
+static void mru_clear(void) {
+    mru_count = 0;
+    mru_dirty = false;
+    memset(mru_bucket, MRU_NONE, sizeof(mru_bucket));
+}
+
+static uint8_t mru_hash(uint8_t hash, uint8_t value) {
+    return (uint8_t)(((hash << 3) | (hash >> 5)) ^ value);
+}
+
+static void mru_link(uint8_t entry) {
+    uint8_t hash;
+    uint8_t i;
+
+    hash = 0;
+    for (i = 0; i < mru_reading_length[entry]; ++i) {
+        hash = mru_hash(hash, mru_reading[entry][i]);
+    }
+    hash &= MRU_HASH_SIZE - 1;
+    mru_next[entry] = mru_bucket[hash];
+    mru_bucket[hash] = entry;
+}
+
+static void mru_unlink(uint8_t entry) {
+    uint8_t hash;
+    uint8_t i;
+
+    hash = 0;
+    for (i = 0; i < mru_reading_length[entry]; ++i) {
+        hash = mru_hash(hash, mru_reading[entry][i]);
+    }
+    hash &= MRU_HASH_SIZE - 1;
+
+    if (mru_bucket[hash] == entry) {
+        mru_bucket[hash] = mru_next[entry];
+        return;
+    }
+    i = mru_bucket[hash];
+    while (i != MRU_NONE) {
+        if (mru_next[i] == entry) {
+            mru_next[i] = mru_next[entry];
+            return;
+        }
+        i = mru_next[i];
+    }
+}
+
+static void mru_touch(uint8_t entry) {
+    uint8_t i;
+
+    i = 0;
+    while (i < mru_count && mru_order[i] != entry) {
+        ++i;
+    }
+    while (i > 0) {
+        mru_order[i] = mru_order[i - 1];
+        --i;
+    }
+    mru_order[0] = entry;
+}
+
+// Returns the entry whose reading is key_buffer itself (exact) or its
+// longest prefix, or MRU_NONE
+static uint8_t mru_lookup(const uint8_t* key_buffer, uint8_t key_length, bool exact) {
+    uint8_t hash;
+    uint8_t length;
+    uint8_t entry;
+    uint8_t found;
+
+    if (key_length > MRU_READING_SIZE) {
+        if (exact) {
+            return MRU_NONE;
+        }
+        key_length = MRU_READING_SIZE;
+    }
+
+    found = MRU_NONE;
+    hash = 0;
+    for (length = 1; length <= key_length; ++length) {
+        hash = mru_hash(hash, key_buffer[length - 1]);
+        if (exact && length != key_length) {
+            continue;
+        }
+        entry = mru_bucket[hash & (MRU_HASH_SIZE - 1)];
+        while (entry != MRU_NONE) {
+            if (mru_reading_length[entry] == length &&
+                memcmp(mru_reading[entry], key_buffer, length) == 0) {
+                found = entry;
+                break;
+            }
+            entry = mru_next[entry];
+        }
+    }
+    return found;
+}
+
+static void mru_store(const uint8_t* reading, uint8_t reading_length, const uint8_t* candidate) {
+    uint8_t entry;
+    size_t candidate_length;
+
+    candidate_length = strlen((const char*)candidate);
+    if (reading_length == 0 || reading_length > MRU_READING_SIZE ||
+        candidate_length >= MRU_CANDIDATE_SIZE) {
+        return;
+    }
+
+    entry = mru_lookup(reading, reading_length, true);
+    if (entry == MRU_NONE) {
+        if (mru_count < IME_MRU_ENTRIES) {
+            entry = mru_count;
+            mru_order[mru_count++] = entry;
+        } else {
+            entry = mru_order[IME_MRU_ENTRIES - 1];
+            mru_unlink(entry);
+        }
+        memcpy(mru_reading[entry], reading, reading_length);
+        mru_reading_length[entry] = reading_length;
+        mru_link(entry);
+    } else if (mru_order[0] == entry &&
+               memcmp(mru_candidate[entry], candidate, candidate_length + 1) == 0) {
+        return;
+    }
+
+    memcpy(mru_candidate[entry], candidate, candidate_length + 1);
+    mru_touch(entry);
+    mru_dirty = true;
+}
+
+// Shows the cached candidate at position 0 and hides its copy in the
+// dictionary groups, if there is one
+static void promote_candidate(uint8_t entry) {
+    uint16_t position;
+    uint8_t group;
+    uint8_t i;
+
+    cached_candidate = entry;
+    position = 0;
+    for (group = 0; group < candidate_groups; ++group) {
+        if (group_length[group] == mru_reading_length[entry]) {
+            dic_open(group_bank[group], group_offset[group]);
+            for (i = 0; i < group_size[group]; ++i) {
+                if (match_dic_string(mru_candidate[entry], group_okurigana[group])) {
+                    skip_position = (uint16_t)(position + i);
+                    break;
+                }
+            }
+            dic_close();
+            if (skip_position != CANDIDATE_NO_SKIP) {
+                return;
+            }
+        }
+        position = (uint16_t)(position + group_size[group]);
+    }
+}
+
+#ifndef JTXT_CRT
+// SEQ file layout: "MRU", IME_MRU_ENTRIES, MRU_READING_SIZE,
+// MRU_CANDIDATE_SIZE, entry count, then per entry (most recent first) the
+// reading length, reading and candidate as fixed-size fields.
+// CRT builds have no KERNAL file I/O and keep the table for the session only.
+bool ime_mru_save(uint8_t device, const char* filename) {
+    char command[MRU_FILENAME_MAX + 8];
+    uint8_t header[7];
+    uint8_t i;
+    uint8_t entry;
+    bool ok;
+
+    if (!mru_dirty) {
+        return true;
+    }
+    if (strlen(filename) > MRU_FILENAME_MAX) {
+        return false;
+    }
+
+    // Scratch the old file first, as the drive will not overwrite it
+    strcpy(command, "s:");
+    strcat(command, filename);
+    krnio_setnam(command);
+    if (krnio_open(15, device, 15)) {
+        krnio_close(15);
+    }
+
+    strcpy(command, filename);
+    strcat(command, ",s,w");
+    krnio_setnam(command);
+    if (!krnio_open(MRU_FILE_LFN, device, 1)) {
+        return false;
+    }
+
+    header[0] = 'M';
+    header[1] = 'R';
+    header[2] = 'U';
+    header[3] = IME_MRU_ENTRIES;
+    header[4] = MRU_READING_SIZE;
+    header[5] = MRU_CANDIDATE_SIZE;
+    header[6] = mru_count;
+    ok = krnio_write(MRU_FILE_LFN, (const char*)header, sizeof(header)) == sizeof(header);
+
+    for (i = 0; ok && i < mru_count; ++i) {
+        entry = mru_order[i];
+        ok = krnio_write(MRU_FILE_LFN, (const char*)&mru_reading_length[entry], 1) == 1 &&
+             krnio_write(MRU_FILE_LFN, (const char*)mru_reading[entry], MRU_READING_SIZE) == MRU_READING_SIZE &&
+             krnio_write(MRU_FILE_LFN, (const char*)mru_candidate[entry], MRU_CANDIDATE_SIZE) == MRU_CANDIDATE_SIZE;
+    }
+
+    krnio_close(MRU_FILE_LFN);
+    if (ok) {
+        mru_dirty = false;
+    }
+    return ok;
+}
+
+bool ime_mru_load(uint8_t device, const char* filename) {
+    char command[MRU_FILENAME_MAX + 8];
+    uint8_t header[7];
+    uint8_t count;
+    uint8_t entry;
+    bool ok;
+
+    if (strlen(filename) > MRU_FILENAME_MAX) {
+        return false;
+    }
+    strcpy(command, filename);
+    strcat(command, ",s");
+    krnio_setnam(command);
+    if (!krnio_open(MRU_FILE_LFN, device, 0)) {
+        return false;
+    }
+
+    ok = krnio_read(MRU_FILE_LFN, (char*)header, sizeof(header)) == sizeof(header) &&
+         header[0] == 'M' && header[1] == 'R' && header[2] == 'U' &&
+         header[3] == IME_MRU_ENTRIES && header[4] == MRU_READING_SIZE &&
+         header[5] == MRU_CANDIDATE_SIZE && header[6] <= IME_MRU_ENTRIES;
+
+    mru_clear();
+    count = ok ? header[6] : 0;
+    for (entry = 0; entry < count; ++entry) {
+        ok = krnio_read(MRU_FILE_LFN, (char*)&mru_reading_length[entry], 1) == 1 &&
+             krnio_read(MRU_FILE_LFN, (char*)mru_reading[entry], MRU_READING_SIZE) == MRU_READING_SIZE &&
+             krnio_read(MRU_FILE_LFN, (char*)mru_candidate[entry], MRU_CANDIDATE_SIZE) == MRU_CANDIDATE_SIZE;
+        if (!ok || mru_reading_length[entry] == 0 || mru_reading_length[entry] > MRU_READING_SIZE) {
+            ok = false;
+            break;
+        }
+        mru_candidate[entry][MRU_CANDIDATE_SIZE - 1] = 0;
+        mru_order[entry] = entry;
+        mru_link(entry);
+        ++mru_count;
+    }
+
+    krnio_close(MRU_FILE_LFN);
+    return ok;
+}
+#endif
+
+static void reset_candidates(void) {
+    candidate_count = 0;
+    current_candidate = 0;
+    candidate_groups = 0;
+    group_size[0] = 0;
+    group_size[1] = 0;
+    cached_candidate = MRU_NONE;
+    skip_position = CANDIDATE_NO_SKIP;
+    stream_group = CANDIDATE_CACHED;
+    reading_candidate = CANDIDATE_NONE;
+    candidate_text_valid = false;
+}
+
+static uint16_t count_candidates(void) {
+    uint16_t total = (uint16_t)group_size[0] + group_size[1];
+
+    if (cached_candidate != MRU_NONE) {
+        ++total;
+        if (skip_position != CANDIDATE_NO_SKIP) {
+            --total;
+        }
+    }
+    return total;
+}
+
+// Drop the first length bytes of hiragana_buffer
+static void consume_hiragana(uint8_t length) {
+    uint8_t remaining;
+
+    if (length > hiragana_pos) {
+        length = hiragana_pos;
+    }
+    remaining = (uint8_t)(hiragana_pos - length);
+    memmove(hiragana_buffer, &hiragana_buffer[length], remaining);
+    hiragana_pos = remaining;
+    if (hiragana_pos < HIRAGANA_BUFFER_SIZE) {
+        memset(&hiragana_buffer[hiragana_pos], 0, HIRAGANA_BUFFER_SIZE - hiragana_pos);
+    }
+}
+
+static uint8_t char_bytes(uint8_t position) {
+    return jtxt_is_firstsjis(hiragana_buffer[position]) ? 2 : 1;
+}
+
+static bool is_particle(uint8_t position) {
+    uint8_t i;
+
+    if (hiragana_buffer[position] != 0x82) {
+        return false;
+    }
+    for (i = 0; i < sizeof(particle_hiragana); ++i) {
+        if (hiragana_buffer[position + 1] == particle_hiragana[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//=============================================================================
+// Multi-clause conversion
+//
+// SPACE splits the first CLAUSE_SPAN_MAX bytes of hiragana_buffer into
+// clauses with the fewest-clauses method: segment_step visits the kana
+// positions one per step, asks the indexed noun and verb searches for the prefix
+// matches starting there (the longest noun, the longest verb and the next
+// shorter noun) and keeps the cheapest way to reach every position. A
+// noun clause may take the one-kana particle after it (私は, 学校に). A
+// dictionary clause costs CLAUSE_COST_WORD; kana no entry covers are
+// gathered into one unknown clause that costs more, so the split with the
+// fewest and longest words wins. The work is at most three lookups per
+// kana and the tables are CLAUSE_SPAN_MAX + 1 bytes each.
+//
+// Only the current clause has its candidate list loaded (the same groups
+// as a single-clause conversion, plus the clause in kana); the chosen text
+// of every clause is kept in clause_text. Cursor left/right moves between
+// clauses, cursor down/up makes the current clause one kana longer or
+// shorter and splits the rest again.
+//=============================================================================
+
+static void start_clause_conversion(bool noun_found, bool verb_found) {
+    uint8_t position = 0;
+    uint8_t step;
+
+    // Whole characters only; the rest is left for the next conversion
+    while (position < hiragana_pos) {
+        step = char_bytes(position);
+        if ((uint8_t)(position + step) > CLAUSE_SPAN_MAX) {
+            break;
+        }
+        position = (uint8_t)(position + step);
+    }
+    clause_end = position;
+
+    // The pre-search already looked up the first position
+    segment_hint_valid = conversion_key_length == clause_end;
+    segment_hint_noun = noun_found ? match_length : 0;
+    segment_hint_verb = verb_found ? (uint8_t)(verb_match_length + 1) : 0;
+
+    clause_count = 0;
+    clause_text_start[0] = 0;
+    segment_begin(0, 0);
+}
+
+// Lengths (bytes) of the dictionary entries that match at position
+static uint8_t clause_matches(uint8_t position, uint8_t rest, uint8_t* lengths) {
+    const uint8_t* key = &hiragana_buffer[position];
+    uint8_t noun = 0;
+    uint8_t verb = 0;
+    uint8_t count = 0;
+
+    if (position == 0 && segment_hint_valid) {
+        noun = segment_hint_noun;
+        verb = segment_hint_verb;
+    } else {
+        if (search_noun_entries(key, rest)) {
+            noun = match_length;
+        }
+        if (search_verb_entries(key, rest)) {
+            verb = (uint8_t)(match_length + 1);
+        }
+    }
+    // The okurigana of a verb may lie past the span
+    if (verb > rest) {
+        verb = 0;
+    }
+
+    if (verb != 0) {
+        lengths[count++] = verb;
+    }
+    if (noun != 0) {
+        count = clause_add_noun(position, rest, noun, lengths, count);
+
+        // The next shorter noun, so a long word cannot hide a better split
+        if (noun > 2 && search_noun_entries(key, (uint8_t)(noun - 1))) {
+            count = clause_add_noun(position, rest, match_length, lengths, count);
+        }
+    }
+    return count;
+}
+
+// A noun clause, and the same noun with the particle after it
+static uint8_t clause_add_noun(uint8_t position, uint8_t rest, uint8_t noun, uint8_t* lengths, uint8_t count) {
+    lengths[count++] = noun;
+    if ((uint8_t)(noun + 2) <= rest && is_particle((uint8_t)(position + noun))) {
+        lengths[count++] = (uint8_t)(noun + 2);
+    }
+    return count;
+}
+
+// Ties go to the later clause start, so earlier clauses stay long
+static void segment_relax(uint8_t position, uint8_t from, uint8_t cost, bool word) {
+    if (cost <= segment_cost[position]) {
+        segment_cost[position] = cost;
+        segment_prev[position] = from;
+        segment_word[position] = word;
+    }
+}
+
+// Start splitting hiragana_buffer from start to clause_end into clauses
+// clause, clause + 1, ... (at most IME_CLAUSE_MAX in all; kana past the
+// last one stay unconverted)
+static void segment_begin(uint8_t clause, uint8_t start) {
+    uint8_t position;
+
+    segment_clause = clause;
+    segment_start = start;
+    segment_span = (uint8_t)(clause_end - start);
+    segment_position = 0;
+
+    for (position = 1; position <= segment_span; ++position) {
+        segment_cost[position] = CLAUSE_NONE;
+    }
+    segment_cost[0] = 0;
+    segment_prev[0] = 0;
+    segment_word[0] = true;
+    convert_phase = CONVERT_SEGMENT;
+}
+
+// Look up the matches at the next position a clause reaches. Returns
+// false when the span is done.
+static bool segment_step(void) {
+    uint8_t lengths[CLAUSE_MATCHES];
+    uint8_t position;
+    uint8_t cost;
+    uint8_t count;
+    uint8_t i;
+
+    while (segment_position < segment_span) {
+        position = segment_position;
+        segment_position = (uint8_t)(position + char_bytes((uint8_t)(segment_start + position)));
+        cost = segment_cost[position];
+        if (cost == CLAUSE_NONE) {
+            continue;
+        }
+
+        // An unknown kana joins the unknown clause ending here
+        if (segment_word[position]) {
+            segment_relax(segment_position, position, (uint8_t)(cost + CLAUSE_COST_KANA), false);
+        } else {
+            segment_relax(segment_position, segment_prev[position], (uint8_t)(cost + 1), false);
+        }
+
+        count = clause_matches((uint8_t)(segment_start + position), (uint8_t)(segment_span - position), lengths);
+        for (i = 0; i < count; ++i) {
+            segment_relax((uint8_t)(position + lengths[i]), position,
+                          (uint8_t)(cost + CLAUSE_COST_WORD), true);
+        }
+        return true;
+    }
+    return false;
+}
+
+// Set the clauses from the cheapest split. Returns whether any clause is
+// a dictionary word.
+static bool segment_end(void) {
+    uint8_t position;
+    uint8_t next;
+    uint8_t from;
+    uint8_t count;
+    bool word;
+
+    // Turn the links back from the end into links forward from start
+    position = segment_span;
+    next = CLAUSE_NONE;
+    word = false;
+    while (position != 0) {
+        if (segment_word[position]) {
+            word = true;
+        }
+        from = segment_prev[position];
+        segment_prev[position] = next;
+        next = position;
+        position = from;
+    }
+
+    count = segment_clause;
+    while (next != CLAUSE_NONE && count < IME_CLAUSE_MAX) {
+        clause_start[count++] = (uint8_t)(segment_start + position);
+        position = next;
+        next = segment_prev[next];
+    }
+    clause_start[count] = (uint8_t)(segment_start + position);
+    clause_count = count;
+    return word;
+}
+
+// Give clause and the ones after it their first candidate, one clause per
+// step (see convert_step)
+static void fill_begin(uint8_t clause) {
+    uint8_t i;
+
+    for (i = (uint8_t)(clause + 1); i <= clause_count; ++i) {
+        clause_text_start[i] = clause_text_start[clause];
+    }
+    fill_next = clause;
+    convert_phase = CONVERT_FILL;
+}
+
+// Collect the entries whose reading is exactly the clause: a noun (or a
+// noun and a particle), a verb stem with its okurigana, and a cached
+// candidate
+static void load_clause(uint8_t clause) {
+    uint8_t start = clause_start[clause];
+    uint8_t length = (uint8_t)(clause_start[clause + 1] - start);
+    uint8_t cached;
+    uint16_t total;
+
+    current_clause = clause;
+    reset_candidates();
+
+    // A copy ending in 0, so no verb takes its okurigana from the next clause
+    memcpy(conversion_key_buffer, &hiragana_buffer[start], length);
+    conversion_key_buffer[length] = 0;
+
+    if (search_noun_entries(conversion_key_buffer, length)) {
+        current_bank = match_bank;
+        current_offset = match_offset;
+        if (match_length == length) {
+            add_candidates(0, length);
+        } else if ((uint8_t)(match_length + 2) == length && is_particle((uint8_t)(start + match_length))) {
+            // Noun and particle: the particle follows every candidate
+            add_candidates(mkword(0x82, hiragana_buffer[start + length - 1]), length);
+        }
+    }
+    if (search_verb_entries(conversion_key_buffer, length) && (uint8_t)(match_length + 1) == length) {
+        current_bank = match_bank;
+        current_offset = match_offset;
+        add_candidates(match_okurigana, length);
+    }
+    cached = mru_lookup(conversion_key_buffer, length, true);
+    if (cached != MRU_NONE) {
+        promote_candidate(cached);
+    }
+
+    // The kana come first for one-kana clauses (mostly particles) and
+    // unknown ones, last otherwise
+    total = count_candidates();
+    if (total > 254) {
+        total = 254;
+    }
+    reading_candidate = (length <= 2 || total == 0) ? 0 : (uint8_t)total;
+    candidate_count = (uint8_t)(total + 1);
+
+    current_candidate = clause_candidate[clause];
+    if (current_candidate >= candidate_count) {
+        current_candidate = 0;
+    }
+}
+
+// Replace the text of clause in clause_text
+static void set_clause_text(uint8_t clause, const uint8_t* text) {
+    uint8_t start = clause_text_start[clause];
+    uint8_t end = clause_text_start[clause + 1];
+    uint8_t tail = (uint8_t)(clause_text_start[clause_count] - end);
+    uint8_t room = (uint8_t)(CLAUSE_TEXT_SIZE - start - tail);
+    uint8_t length = 0;
+    uint8_t step;
+    uint8_t i;
+
+    // Whole characters only when the phrase is full
+    while (text[length] != 0) {
+        step = jtxt_is_firstsjis(text[length]) ? 2 : 1;
+        if ((uint8_t)(length + step) > room) {
+            break;
+        }
+        length = (uint8_t)(length + step);
+    }
+
+    memmove(&clause_text[start + length], &clause_text[end], tail);
+    memcpy(&clause_text[start], text, length);
+    for (i = (uint8_t)(clause + 1); i <= clause_count; ++i) {
+        clause_text_start[i] = (uint8_t)(clause_text_start[i] - end + start + length);
+    }
+}
+
+static void update_clause_text(void) {
+    uint8_t* text = get_current_candidate();
+    uint8_t group_index;
+
+    if (text == NULL) {
+        return;
+    }
+    clause_kana[current_clause] = locate_candidate(current_candidate, &group_index) == CANDIDATE_READING;
+    clause_candidate[current_clause] = current_candidate;
+    set_clause_text(current_clause, text);
+}
+
+static void resize_clause(bool longer) {
+    uint8_t clause = current_clause;
+    uint8_t start = clause_start[clause];
+    uint8_t end = clause_start[clause + 1];
+    uint8_t position;
+
+    if (longer) {
+        if (end >= clause_end) {
+            return;
+        }
+        end = (uint8_t)(end + char_bytes(end));
+    } else {
+        // Back to the character boundary before end
+        position = (uint8_t)(start + char_bytes(start));
+        if (position >= end) {
+            return;
+        }
+        while ((uint8_t)(position + char_bytes(position)) < end) {
+            position = (uint8_t)(position + char_bytes(position));
+        }
+        end = position;
+    }
+
+    // The clauses after it are split again in steps (see convert_step)
+    ime_conversion_state = IME_STATE_SEARCHING;
+    convert_clause = clause;
+    if ((uint8_t)(clause + 1) < IME_CLAUSE_MAX && end < clause_end) {
+        segment_begin((uint8_t)(clause + 1), end);
+    } else {
+        clause_count = (uint8_t)(clause + 1);
+        clause_start[clause + 1] = end;
+        fill_begin(clause);
+    }
+}
+
+static void confirm_clauses(void) {
+    uint8_t i;
+    uint8_t length;
+
+    ime_output_length = clause_text_start[clause_count];
+    memcpy(ime_output_buffer, clause_text, ime_output_length);
+    if (ime_output_length < sizeof(ime_output_buffer)) {
+        ime_output_buffer[ime_output_length] = 0;
+    }
+
+    // Cache the clauses the dictionary converted
+    for (i = 0; i < clause_count; ++i) {
+        length = (uint8_t)(clause_text_start[i + 1] - clause_text_start[i]);
+        if (!clause_kana[i] && length < MRU_CANDIDATE_SIZE) {
+            memcpy(candidate_text, &clause_text[clause_text_start[i]], length);
+            candidate_text[length] = 0;
+            mru_store(&hiragana_buffer[clause_start[i]],
+                      (uint8_t)(clause_start[i + 1] - clause_start[i]), candidate_text);
+        }
+    }
+
+    consume_hiragana(clause_start[clause_count]);
+    ime_has_output = true;
+}
+
+//=============================================================================
+// Stepped conversion
+//
+// SPACE only starts a conversion: ime_process then runs convert_step until
+// the candidates are ready, and returns IME_EVENT_BUSY when a call has
+// made lookup_budget dictionary lookups before that. The steps are the
+// pre-search lookups, one kana position of the clause split and one clause
+// given its first candidate, each a few indexed lookups (or up to
+// DIC_GROUP_WALK version 0 entries). A clause resize splits the
+// clauses after it again the same way. The input line is left as it is
+// until the conversion is done.
+//=============================================================================
+
+static bool start_conversion(void) {
+    if (hiragana_pos == 0) {
+        return false;
+    }
+
+    // Longest reading the user already converted; a hit lets the
+    // conversion go ahead even without a dictionary
+    convert_cached = mru_lookup(hiragana_buffer, hiragana_pos, false);
+
+    // Restart unless the pre-search belongs to the current buffer
+    if (presearch_state == PRESEARCH_IDLE || conversion_key_length != hiragana_pos ||
+        memcmp(conversion_key_buffer, hiragana_buffer, hiragana_pos) != 0) {
+        presearch_dirty = true;
+    }
+
+    ime_conversion_state = IME_STATE_SEARCHING;
+    convert_phase = CONVERT_PRESEARCH;
+    convert_clause = 0;
+    return true;
+}
+
+static void convert_step(void) {
+    switch (convert_phase) {
+        case CONVERT_PRESEARCH:
+            presearch_step();
+            if (presearch_state != PRESEARCH_VERB && presearch_state != PRESEARCH_NOUN) {
+                convert_matches();
+            }
+            break;
+        case CONVERT_SEGMENT:
+            if (segment_step()) {
+                break;
+            }
+            if (!segment_end() && segment_clause == 0) {
+                // No dictionary word anywhere
+                segment_hint_valid = false;
+                clause_count = 0;
+                convert_failed();
+                break;
+            }
+            segment_hint_valid = false;
+            fill_begin(convert_clause);
+            break;
+        case CONVERT_FILL:
+            if (fill_next < clause_count) {
+                clause_candidate[fill_next] = 0;
+                load_clause(fill_next);
+                update_clause_text();
+                ++fill_next;
+                break;
+            }
+            load_clause(convert_clause);
+            ime_conversion_state = IME_STATE_CONVERTING;
+            break;
+        default:
+            break;
+    }
+}
+
+// Advance the conversion until it is done or this call has made
+// lookup_budget lookups
+static uint8_t convert_run(void) {
+    lookup_count = 0;
+    while (ime_conversion_state == IME_STATE_SEARCHING) {
+        if (lookup_budget != 0 && lookup_count >= lookup_budget) {
+            return IME_EVENT_BUSY;
+        }
+        convert_step();
+    }
+
+    if (ime_conversion_state != IME_STATE_CONVERTING) {
+        return IME_EVENT_NONE;
+    }
+    update_ime_display();
+    return IME_EVENT_CANDIDATES_READY;
+}
+
+// Nothing to convert: SPACE is typed as usual
+static void convert_failed(void) {
+    ime_conversion_state = IME_STATE_INPUT;
+    input_ime_char(KEY_SPACE);
+}
+
+// The pre-search is done: split the input into clauses, or collect the
+// candidates of the longest match
+static void convert_matches(void) {
+    bool verb_found;
+    bool noun_found;
+    bool searched;
+    uint8_t verb_length;
+    uint8_t longest;
+    uint16_t total;
+
+    verb_found = false;
+    noun_found = false;
+    searched = presearch_state == PRESEARCH_DONE;
+    if (searched) {
+        verb_found = presearch_verb_found;
+        noun_found = presearch_noun_found;
+    }
+    presearch_state = PRESEARCH_IDLE;
+
+    // Linear (version 0) dictionaries are too slow to segment
+    if (multi_clause && searched && dic_version != 0) {
+        start_clause_conversion(noun_found, verb_found);
+        return;
+    }
+
+    if (!noun_found && !verb_found && convert_cached == MRU_NONE) {
+        convert_failed();
+        return;
+    }
+
+    reset_candidates();
+    verb_length = (uint8_t)(verb_match_length + 1);
+    longest = 0;
+
+    if (noun_found && verb_found) {
+        if (verb_match_length > match_length) {
+            current_bank = verb_match_bank;
+            current_offset = verb_match_offset;
+            add_candidates(verb_match_okurigana, verb_length);
+
+            current_bank = match_bank;
+            current_offset = match_offset;
+            add_candidates(0, match_length);
+        } else {
+            current_bank = match_bank;
+            current_offset = match_offset;
+            add_candidates(0, match_length);
+
+            current_bank = verb_match_bank;
+            current_offset = verb_match_offset;
+            add_candidates(verb_match_okurigana, verb_length);
+        }
+    } else if (noun_found) {
+        current_bank = match_bank;
+        current_offset = match_offset;
+        add_candidates(0, match_length);
+    } else if (verb_found) {
+        current_bank = verb_match_bank;
+        current_offset = verb_match_offset;
+        add_candidates(verb_match_okurigana, verb_length);
+    }
+    if (noun_found) {
+        longest = match_length;
+    }
+    if (verb_found && verb_length > longest) {
+        longest = verb_length;
+    }
+
+    // A cached reading only wins when it is at least as long as what the
+    // dictionary matched; otherwise the user is typing a longer word
+    if (convert_cached != MRU_NONE && mru_reading_length[convert_cached] >= longest) {
+        promote_candidate(convert_cached);
+    }
+
+    total = count_candidates();
+    candidate_count = total > 255 ? 255 : (uint8_t)total;
+
+    if (candidate_count > 0) {
+        ime_conversion_state = IME_STATE_CONVERTING;
+        current_candidate = 0;
+        return;
+    }
+
+    convert_failed();
+}
+static void next_candidate(void) {
+    if (ime_conversion_state == IME_STATE_CONVERTING && candidate_count > 0) {
+        ++current_candidate;
+        if (current_candidate >= candidate_count) {
+            current_candidate = 0;
+        }
+        if (clause_count != 0) {
+            update_clause_text();
+        }
+    }
+}
+
+static void prev_candidate(void) {
+    if (ime_conversion_state == IME_STATE_CONVERTING && candidate_count > 0) {
+        if (current_candidate == 0) {
+            current_candidate = (uint8_t)(candidate_count - 1);
+        } else {
+            --current_candidate;
+        }
+        if (clause_count != 0) {
+            update_clause_text();
+        }
+    }
+}
+
+static uint8_t* get_current_candidate(void) {
+    if (ime_conversion_state != IME_STATE_INPUT && candidate_count > 0 &&
+        current_candidate < candidate_count) {
+        if (!candidate_text_valid || candidate_text_index != current_candidate) {
+            fetch_candidate(current_candidate);
+            candidate_text_index = current_candidate;
+            candidate_text_valid = true;
+        }
+        return candidate_text;
+    }
+    return NULL;
+}
+static void confirm_conversion(void) {
+    if (ime_conversion_state == IME_STATE_CONVERTING && clause_count != 0) {
+        confirm_clauses();
+    } else if (ime_conversion_state == IME_STATE_CONVERTING) {
+        uint8_t* candidate_str = get_current_candidate();
+        if (candidate_str != NULL) {
+            uint8_t i;
+            uint8_t group;
+            uint8_t entry_length;
+
+            ime_output_length = 0;
+            i = 0;
+            while (candidate_str[i] != 0 && ime_output_length < sizeof(ime_output_buffer)) {
+                ime_output_buffer[ime_output_length++] = candidate_str[i++];
+            }
+            if (ime_output_length < sizeof(ime_output_buffer)) {
+                ime_output_buffer[ime_output_length] = 0;
+            }
+
+            group = locate_candidate(current_candidate, &i);
+            if (group == CANDIDATE_CACHED) {
+                entry_length = mru_reading_length[cached_candidate];
+            } else {
+                entry_length = group_length[group];
+            }
+            if (entry_length > hiragana_pos) {
+                entry_length = hiragana_pos;
+            }
+            mru_store(hiragana_buffer, entry_length, candidate_str);
+            consume_hiragana(entry_length);
+
+            ime_has_output = true;
+        }
+    }
+
+    cancel_conversion();
 }
 static void cancel_conversion(void) {
     ime_conversion_state = IME_STATE_INPUT;
+    presearch_dirty = true;
     candidate_count = 0;
     current_candidate = 0;
-    candidate_buffer_pos = 0;
+    reading_candidate = CANDIDATE_NONE;
+    clause_count = 0;
     conversion_key_length = 0;
-    verb_candidate_count = 0;
-    match_candidate_count = 0;
     clear_conversion_key_buffer();
 
-    prev_display_length = 0;
-    prev_display_chars = 0;
-    prev_romaji_pos = 0;
-
-    clear_ime_input_area();
     update_ime_display();
 
     jtxt_bwindow_disable();
@@ -33,6 +33,138 @@ jtxt_state_t jtxt_state = {.chr_start = 128,
 // ROM access management
 static uint8_t saved_01_register = 0;
 
+#ifdef JTXT_SLOT_DEDUP
+//=============================================================================
+// Text-mode slot allocator: one charset slot per distinct glyph
+//
+// A hashed SJIS -> slot map lets repeated characters share a slot, and a
+// per-slot reference count (number of screen cells showing it) lets
+// jtxt_cls / jtxt_clear_line / overwrites release slots. Only cells drawn
+// by jtxt hold a reference (one ownership bit per cell), so screen codes
+// written with POKE or KERNAL output never change the counts. Released slots
+// keep their glyph and map entry until reallocated, so a character that
+// comes back before then needs no ROM fetch either.
+//=============================================================================
+
+#define SLOT_NIL      0xFF
+#define SLOT_BUCKETS  32
+
+static uint16_t slot_code[255];          // 0 = never assigned
+static uint8_t  slot_refs[255];
+static uint8_t  slot_next[255];          // Hash chain
+static uint8_t  slot_bucket[SLOT_BUCKETS];
+static uint8_t  slot_owned[125];         // 1 bit per screen cell drawn by jtxt
+static uint8_t  slot_cursor;             // Next slot to try on allocation
+static bool     slot_fresh;              // Last acquire needs a glyph define
+
+static inline uint8_t slot_hash(uint16_t code) {
+  return ((uint8_t)code ^ (uint8_t)(code >> 8)) & (SLOT_BUCKETS - 1);
+}
+
+static void slot_reset(void) {
+  memset(slot_code, 0, sizeof(slot_code));
+  memset(slot_refs, 0, sizeof(slot_refs));
+  memset(slot_bucket, SLOT_NIL, sizeof(slot_bucket));
+  memset(slot_owned, 0, sizeof(slot_owned));
+  slot_cursor = 0;
+}
+
+// Drop the reference held by the screen cell at pos (if jtxt drew it)
+static void slot_release(uint16_t pos) {
+  uint16_t cell = pos - JTXT_SCREEN_RAM;
+  uint8_t mask = 1 << (cell & 7);
+
+  if (slot_owned[cell >> 3] & mask) {
+    uint8_t slot = PEEK(pos) - jtxt_state.chr_start;
+    slot_owned[cell >> 3] &= ~mask;
+    if (slot < jtxt_state.chr_count && slot_refs[slot] != 0 && slot_refs[slot] != 0xFF) {
+      slot_refs[slot]--;
+    }
+  }
+}
+
+// Record that the screen cell at pos now holds a slot reference
+static void slot_claim(uint16_t pos) {
+  uint16_t cell = pos - JTXT_SCREEN_RAM;
+  slot_owned[cell >> 3] |= 1 << (cell & 7);
+}
+
+// Undo slot_release for a cell that keeps its old character
+static void slot_restore(uint16_t pos, bool owned) {
+  uint8_t slot = PEEK(pos) - jtxt_state.chr_start;
+  if (owned) {
+    slot_claim(pos);
+    if (slot < jtxt_state.chr_count && slot_refs[slot] != 0xFF) {
+      slot_refs[slot]++;
+    }
+  }
+}
+
+// True if the screen cell at pos holds a slot reference
+static inline bool slot_is_owned(uint16_t pos) {
+  uint16_t cell = pos - JTXT_SCREEN_RAM;
+  return (slot_owned[cell >> 3] & (1 << (cell & 7))) != 0;
+}
+
+// Find or allocate the slot for char_code; returns SLOT_NIL when all
+// slots are on screen. slot_fresh tells the caller to define the glyph.
+static uint8_t slot_acquire(uint16_t char_code) {
+  uint8_t h = slot_hash(char_code);
+  uint8_t slot = slot_bucket[h];
+
+  slot_fresh = false;
+
+  while (slot != SLOT_NIL) {
+    if (slot_code[slot] == char_code) {
+      if (slot_refs[slot] != 0xFF) {
+        slot_refs[slot]++;  // Saturated slots stay pinned until jtxt_cls
+      }
+      return slot;
+    }
+    slot = slot_next[slot];
+  }
+
+  // Look for a slot with no cells on screen
+  uint8_t count = jtxt_state.chr_count;
+  slot = slot_cursor;
+  for (uint8_t n = 0; n < count; n++) {
+    if (slot >= count) {
+      slot = 0;
+    }
+    if (slot_refs[slot] == 0) {
+      break;
+    }
+    slot++;
+  }
+  if (slot >= count || slot_refs[slot] != 0) {
+    return SLOT_NIL;  // Overflow
+  }
+  slot_cursor = slot + 1;
+
+  // Unhook previous glyph from its hash chain
+  if (slot_code[slot] != 0) {
+    uint8_t old_h = slot_hash(slot_code[slot]);
+    uint8_t s = slot_bucket[old_h];
+    if (s == slot) {
+      slot_bucket[old_h] = slot_next[slot];
+    } else {
+      while (slot_next[s] != slot) {
+        s = slot_next[s];
+      }
+      slot_next[s] = slot_next[slot];
+    }
+  }
+
+  slot_code[slot] = char_code;
+  slot_next[slot] = slot_bucket[h];
+  slot_bucket[h] = slot;
+  slot_refs[slot] = 1;
+
+  slot_fresh = true;
+  return slot;
+}
+#endif
+
 void jtxt_init(uint8_t mode) {
 #ifdef JTXT_CRT
   // CRT: manual initialization (no C initializer with -n flag)
@@ -53,6 +185,32 @@ void jtxt_init(uint8_t mode) {
   jtxt_state.wrap_pending = false;
 #endif
 
+#ifdef JTXT_SJIS_INDEX
+  // Use the glyph index only if the cartridge carries one for this layout
+  jtxt_sjis_index_check();
+#endif
+
+#ifdef JTXT_REU
+  // Copy the fonts into the REU if one is present (glyph DMA from then on)
+  jtxt_reu_init();
+#endif
+
+#ifdef JTXT_SLOT_DEDUP
+  // Slot map lives in BSS, which CRT builds do not zero-fill
+  slot_reset();
+#endif
+
+#ifdef JTXT_SHADOW
+  // Screen contents are unknown until the library draws them
+  jtxt_shadow_invalidate();
+#endif
+
+#ifdef JTXT_GLYPH_CACHE
+  // Cache tables live in BSS, which CRT builds do not zero-fill
+  jtxt_glyph_cache_clear();
+  jtxt_glyph_cache_reset_stats();
+#endif
+
   // Set display mode
   jtxt_set_mode(mode);
 
@@ -136,6 +294,10 @@ void jtxt_set_range(uint8_t start_char, uint8_t char_count) {
   jtxt_state.current_index = start_char;
   jtxt_state.screen_pos = JTXT_SCREEN_RAM;
   jtxt_state.color_pos = JTXT_COLOR_RAM;
+
+#ifdef JTXT_SLOT_DEDUP
+  slot_reset();
+#endif
 }
 
 void jtxt_cls(void) {
@@ -146,6 +308,24 @@ void jtxt_cls(void) {
   jtxt_state.current_index = jtxt_state.chr_start;
   jtxt_locate(0, 0);
   jtxt_state.sjis_first_byte = 0;
+
+#ifdef JTXT_SLOT_DEDUP
+  // Nothing on screen any more: release every slot (glyphs stay cached)
+  memset(slot_refs, 0, sizeof(slot_refs));
+  memset(slot_owned, 0, sizeof(slot_owned));
+#endif
+}
+
+void jtxt_clear_line(uint8_t row) {
+  uint16_t pos = JTXT_SCREEN_RAM + (uint16_t)row * JTXT_CHAR_WIDTH;
+
+#ifdef JTXT_SLOT_DEDUP
+  for (uint8_t x = 0; x < JTXT_CHAR_WIDTH; x++) {
+    slot_release(pos + x);
+  }
+#endif
+
+  memset((void *)pos, 32, JTXT_CHAR_WIDTH);
 }
 
 void jtxt_locate(uint8_t x, uint8_t y) {
@@ -163,6 +343,34 @@ void jtxt_set_bgcolor(uint8_t bgcolor, uint8_t bordercolor) {
 
 // Internal function to output a character (handles actual drawing)
 static void jtxt_putc_internal(uint16_t char_code) {
+#ifdef JTXT_SLOT_DEDUP
+  // Release whatever the cell showed before, so a full charset can reuse
+  // the slot of its only cell; rewriting the same character finds its
+  // slot still mapped and keeps it
+  bool owned = slot_is_owned(jtxt_state.screen_pos);
+  slot_release(jtxt_state.screen_pos);
+
+  uint8_t slot = slot_acquire(char_code);
+  if (slot == SLOT_NIL) {
+    slot_restore(jtxt_state.screen_pos, owned);
+    return; // Overflow
+  }
+
+  if (slot_fresh) {
+    jtxt_define_char(jtxt_state.chr_start + slot, char_code);
+  }
+
+  POKE(jtxt_state.screen_pos, jtxt_state.chr_start + slot);
+  slot_claim(jtxt_state.screen_pos);
+  POKE(jtxt_state.color_pos, jtxt_state.current_color);
+
+  if (jtxt_state.screen_pos < JTXT_SCREEN_RAM + 999) {
+    jtxt_state.screen_pos++;
+    jtxt_state.color_pos++;
+  }
+  return;
+#endif
+
   // Range check
   if (jtxt_state.current_index >= jtxt_state.chr_start + jtxt_state.chr_count) {
     return; // Overflow
@@ -228,6 +436,163 @@ void jtxt_puts(const char *str) {
   }
 }
 
+//=============================================================================
+// puts_fast: text-mode counterpart of jtxt_bputs_fast
+//
+// Key optimizations vs puts:
+//   1. ROM access ($01 save/restore) done ONCE for entire string
+//   2. Bank 0 reset NOT done between characters
+//   3. Glyph definition inlined (no define_char/define_font/define_kanji)
+//   4. Loop state in zero page, screen/color pointers cached locally
+//
+// Limitations:
+//   - No newline handling
+//   - Caller must provide valid printable / SJIS data
+//=============================================================================
+
+// Zero-page registers for puts_fast inner loop
+static __zeropage uint8_t _tfast_ch;
+static __zeropage uint8_t _tfast_sjis;
+static __zeropage uint8_t _tfast_index;
+
+void jtxt_puts_fast(const char *str) {
+  uint16_t scr = jtxt_state.screen_pos;
+  uint16_t col = jtxt_state.color_pos;
+  uint8_t color = jtxt_state.current_color;
+#ifndef JTXT_SLOT_DEDUP
+  uint16_t limit = (uint16_t)jtxt_state.chr_start + jtxt_state.chr_count;
+#endif
+
+  _tfast_index = jtxt_state.current_index;
+  _tfast_sjis = 0;
+
+  // Batch ROM access: begin once for entire string
+  uint8_t saved_01 = PEEK(0x01);
+  POKE(0x01, saved_01 | 0x01);
+
+#ifdef JTXT_REU
+  // REU glyph DMA: load bank and length once, autoload keeps them
+  bool reu = jtxt_reu_ready;
+  if (reu) {
+    POKE(JTXT_REU_REU_BANK, JTXT_REU_FONT_BANK);
+    POKE(JTXT_REU_LENGTH, 8);
+    POKE(JTXT_REU_LENGTH + 1, 0);
+  }
+#endif
+
+  while ((_tfast_ch = (uint8_t)*str++) != 0) {
+    uint16_t char_code;
+    uint8_t slot;
+
+    // Inline SJIS state machine
+    if (_tfast_sjis != 0) {
+      char_code = ((uint16_t)_tfast_sjis << 8) | _tfast_ch;
+      _tfast_sjis = 0;
+    } else if ((_tfast_ch >= 0x81 && _tfast_ch <= 0x9F) || (_tfast_ch >= 0xE0 && _tfast_ch <= 0xFC)) {
+      _tfast_sjis = _tfast_ch;
+      continue;
+    } else {
+      char_code = _tfast_ch;
+    }
+
+    // Charset slot
+#ifdef JTXT_SLOT_DEDUP
+    {
+      bool owned = slot_is_owned(scr);
+      slot_release(scr);
+      slot = slot_acquire(char_code);
+      if (slot == SLOT_NIL) {
+        slot_restore(scr, owned);
+        break; // Overflow
+      }
+    }
+    slot_claim(scr);
+    slot += jtxt_state.chr_start;
+    if (slot_fresh)
+#else
+    if (_tfast_index >= limit) {
+      break; // Overflow
+    }
+    slot = _tfast_index++;
+#endif
+    {
+      // --- Inline glyph definition (ROM window already open) ---
+      uint16_t dst = JTXT_CHARSET_RAM + ((uint16_t)slot << 3);
+      uint16_t src;
+      uint8_t bank;
+
+#ifdef JTXT_REU
+      if (reu) {
+        // Glyph DMA from the REU copy
+        uint16_t off = jtxt_font_offset(char_code);
+        POKE(JTXT_REU_C64_ADDR, (uint8_t)dst);
+        POKE(JTXT_REU_C64_ADDR + 1, (uint8_t)(dst >> 8));
+        POKE(JTXT_REU_REU_ADDR, (uint8_t)off);
+        POKE(JTXT_REU_REU_ADDR + 1, (uint8_t)(off >> 8));
+        POKE(JTXT_REU_COMMAND, JTXT_REU_CMD_FETCH | JTXT_REU_CMD_AUTOLOAD);
+      } else
+#endif
+      {
+        if ((char_code & 0xFF00) == 0) {
+          // Single-byte: ASCII / half-width kana
+          bank = 1 + JTXT_BANK_OFFSET;
+          src = JTXT_ROM_BASE + ((uint16_t)(uint8_t)char_code << 3);
+#ifdef JTXT_SJIS_INDEX
+        } else if (jtxt_sjis_index_ready) {
+          src = jtxt_sjis_index_lookup(char_code, &bank);
+#endif
+        } else {
+          // Double-byte: Kanji
+          uint16_t kanji_offset = jtxt_sjis_to_offset(char_code);
+#ifdef JTXT_EASYFLASH
+          // EasyFlash: 16KB banks
+          if (kanji_offset < 14336) {
+            bank = 1;
+            src = JTXT_ROM_BASE + kanji_offset + 2048;
+          } else {
+            uint16_t adjusted = kanji_offset - 14336;
+            bank = (uint8_t)(adjusted >> 14) + 2;
+            src = JTXT_ROM_BASE + (adjusted & 0x3FFF);
+          }
+#else
+          // MagicDesk: 8KB banks (+ JTXT_BANK_OFFSET for CRT)
+          bank = (uint8_t)(kanji_offset >> 13) + 1 + JTXT_BANK_OFFSET;
+          src = JTXT_ROM_BASE + (kanji_offset & 0x1FFF);
+#endif
+        }
+
+        *((volatile char *)JTXT_BANK_REG) = bank;
+        *(volatile uint8_t *)(dst)     = *(volatile uint8_t *)(src);
+        *(volatile uint8_t *)(dst + 1) = *(volatile uint8_t *)(src + 1);
+        *(volatile uint8_t *)(dst + 2) = *(volatile uint8_t *)(src + 2);
+        *(volatile uint8_t *)(dst + 3) = *(volatile uint8_t *)(src + 3);
+        *(volatile uint8_t *)(dst + 4) = *(volatile uint8_t *)(src + 4);
+        *(volatile uint8_t *)(dst + 5) = *(volatile uint8_t *)(src + 5);
+        *(volatile uint8_t *)(dst + 6) = *(volatile uint8_t *)(src + 6);
+        *(volatile uint8_t *)(dst + 7) = *(volatile uint8_t *)(src + 7);
+      }
+    }
+
+    // Display on screen
+    POKE(scr, slot);
+    POKE(col, color);
+    if (scr < JTXT_SCREEN_RAM + 999) {
+      scr++;
+      col++;
+    }
+  }
+
+  // Batch ROM access: end once for entire string
+  *((volatile char *)JTXT_BANK_REG) = 0;
+  POKE(0x01, saved_01);
+
+  // Update state
+  jtxt_state.screen_pos = scr;
+  jtxt_state.color_pos = col;
+  jtxt_state.current_index = _tfast_index;
+  jtxt_state.sjis_first_byte = _tfast_sjis;
+}
+
 void jtxt_newline(void) {
   uint16_t pos = jtxt_state.screen_pos - JTXT_SCREEN_RAM;
   uint8_t row = pos / 40;
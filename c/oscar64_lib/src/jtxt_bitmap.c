@@ -37,13 +37,80 @@ static const uint16_t screen_row_addr[25] = {
     0x5FC0
 };
 
+#ifdef JTXT_SHADOW
+//=============================================================================
+// Shadow cell buffer: SJIS code + color currently shown in each cell
+//
+// Every library draw path keeps it up to date, so the diff variants can
+// skip cells that already show the requested glyph. Code 0xFFFF marks a
+// cell as unknown (never matches).
+//
+// RAM: 1000 * 3 = 3000 bytes
+//=============================================================================
+
+#define SHADOW_UNKNOWN 0xFFFFU
+
+static uint16_t shadow_code[1000];
+static uint8_t  shadow_color[1000];
+
+// Shadow row base index: y*40
+static const uint16_t shadow_row_off[25] = {
+      0,  40,  80, 120, 160, 200, 240, 280,
+    320, 360, 400, 440, 480, 520, 560, 600,
+    640, 680, 720, 760, 800, 840, 880, 920,
+    960
+};
+
+// When true, jtxt_draw_font_to_bitmap skips cells that already match
+static bool shadow_skip_same = false;
+
+// Record count cells of a row as cleared (space) in the given color
+static void shadow_fill(uint8_t row, uint8_t x, uint8_t count, uint8_t color) {
+    uint16_t i = shadow_row_off[row] + x;
+    while (count--) {
+        shadow_code[i] = 0x20;
+        shadow_color[i] = color;
+        i++;
+    }
+}
+
+void jtxt_shadow_invalidate(void) {
+    for (uint16_t i = 0; i < 1000; i++) {
+        shadow_code[i] = SHADOW_UNKNOWN;
+    }
+}
+
+void jtxt_shadow_invalidate_row(uint8_t row) {
+    uint16_t i = shadow_row_off[row];
+    for (uint8_t x = 0; x < 40; x++) {
+        shadow_code[i++] = SHADOW_UNKNOWN;
+    }
+}
+#endif
+
 void jtxt_bcls(void) {
     uint8_t top = jtxt_state.bitmap_top_row;
     uint8_t bottom = jtxt_state.bitmap_bottom_row;
 
+#ifdef JTXT_REU
+    if (jtxt_reu_ready && bottom >= top) {
+        // Window rows are contiguous: one REU fill each for bitmap and color
+        uint8_t rows = bottom - top + 1;
+        jtxt_reu_fill(bitmap_row_addr[top], 0, (uint16_t)rows * 320);
+        jtxt_reu_fill(screen_row_addr[top], jtxt_state.bitmap_color, (uint16_t)rows * 40);
+#ifdef JTXT_SHADOW
+        for (uint8_t row = top; row <= bottom; row++) {
+            shadow_fill(row, 0, 40, jtxt_state.bitmap_color);
+        }
+#endif
+    } else
+#endif
     for (uint8_t row = top; row <= bottom; row++) {
         memset((void*)bitmap_row_addr[row], 0, 320);
         memset((void*)screen_row_addr[row], jtxt_state.bitmap_color, 40);
+#ifdef JTXT_SHADOW
+        shadow_fill(row, 0, 40, jtxt_state.bitmap_color);
+#endif
     }
 
     // Reset cursor position
@@ -127,45 +194,58 @@ void jtxt_bscroll_up(void) {
     uint8_t top = jtxt_state.bitmap_top_row;
     uint8_t bottom = jtxt_state.bitmap_bottom_row;
 
+#ifdef JTXT_REU
+    if (jtxt_reu_ready) {
+        // Whole window in two REU block moves (bitmap, color)
+        if (bottom > top) {
+            uint8_t rows = bottom - top;
+            jtxt_reu_copy(bitmap_row_addr[top], bitmap_row_addr[top + 1], (uint16_t)rows * 320);
+            jtxt_reu_copy(screen_row_addr[top], screen_row_addr[top + 1], (uint16_t)rows * 40);
+        }
+    } else
+#endif
     for (uint8_t i = top; i < bottom; i++) {
         memcpy((void*)bitmap_row_addr[i], (void*)bitmap_row_addr[i + 1], 320);
         memcpy((void*)screen_row_addr[i], (void*)screen_row_addr[i + 1], 40);
     }
 
+#ifdef JTXT_SHADOW
+    if (bottom > top) {
+        uint16_t rows = (uint16_t)(bottom - top) * 40;
+        memmove(&shadow_code[shadow_row_off[top]], &shadow_code[shadow_row_off[top + 1]], rows * 2);
+        memmove(&shadow_color[shadow_row_off[top]], &shadow_color[shadow_row_off[top + 1]], rows);
+    }
+    shadow_fill(bottom, 0, 40, (COLOR_WHITE << 4) | COLOR_BLACK);
+#endif
+
     // Clear last row with default color (white on black)
+#ifdef JTXT_REU
+    if (jtxt_reu_ready) {
+        jtxt_reu_fill(bitmap_row_addr[bottom], 0, 320);
+        jtxt_reu_fill(screen_row_addr[bottom], (COLOR_WHITE << 4) | COLOR_BLACK, 40);
+        return;
+    }
+#endif
     memset((void*)bitmap_row_addr[bottom], 0, 320);
     memset((void*)screen_row_addr[bottom], (COLOR_WHITE << 4) | COLOR_BLACK, 40);
 }
 
-void jtxt_draw_font_to_bitmap(uint16_t char_code) {
-    uint8_t cx = jtxt_state.cursor_x;
-    uint8_t cy = jtxt_state.cursor_y;
-
-    // Color RAM: table lookup (no multiplication)
-    *(volatile uint8_t *)(screen_row_addr[cy] + cx) = jtxt_state.bitmap_color;
-
-    // Bitmap address: table lookup + shift (no multiplication)
-    uint16_t dst = bitmap_row_addr[cy] + ((uint16_t)cx << 3);
-
-    // --- Flattened font copy (no define_font/define_kanji call chain) ---
-
+// Select the glyph's bank and copy its 8 bytes to dst_addr
+// (ROM must be visible; the bank is left selected)
+static void jtxt_rom_glyph(uint16_t char_code, uint16_t dst_addr) {
+    uint16_t dst = dst_addr;
     uint16_t src;
     uint8_t bank;
-    uint8_t saved_01;
 
     if ((char_code & 0xFF00) == 0) {
         // Single-byte: ASCII / half-width kana (Bank 1)
-        uint8_t code = (uint8_t)char_code;
-
-        if (code == 0x20) {
-            // Space: zero-fill without ROM access
-            *(volatile uint32_t *)(dst)     = 0;
-            *(volatile uint32_t *)(dst + 4) = 0;
-            return;
-        }
-
-        src = JTXT_ROM_BASE + ((uint16_t)code << 3);
+        src = JTXT_ROM_BASE + ((uint16_t)(uint8_t)char_code << 3);
         bank = 1 + JTXT_BANK_OFFSET;
+#ifdef JTXT_SJIS_INDEX
+    } else if (jtxt_sjis_index_ready) {
+        // Double-byte: Kanji via index (two table loads)
+        src = jtxt_sjis_index_lookup(char_code, &bank);
+#endif
     } else {
         // Double-byte: Kanji
         uint16_t kanji_offset = jtxt_sjis_to_offset(char_code);
@@ -186,9 +266,7 @@ void jtxt_draw_font_to_bitmap(uint16_t char_code) {
 #endif
     }
 
-    // ROM access + bank switch + 8-byte copy (all inline)
-    saved_01 = *(volatile uint8_t *)0x01;
-    *(volatile uint8_t *)0x01 = saved_01 | 0x01;
+    // Bank switch + 8-byte copy (all inline)
     *((volatile char *)JTXT_BANK_REG) = bank;
 
 #if USE_ASM_COPY
@@ -228,11 +306,217 @@ void jtxt_draw_font_to_bitmap(uint16_t char_code) {
     *(volatile uint8_t *)(dst + 6) = *(volatile uint8_t *)(src + 6);
     *(volatile uint8_t *)(dst + 7) = *(volatile uint8_t *)(src + 7);
 #endif
+}
+
+// Copy one 8-byte glyph from cartridge ROM to dst_addr
+// (flattened: no define_font/define_kanji call chain)
+static void jtxt_fetch_glyph(uint16_t char_code, uint16_t dst_addr) {
+#ifdef JTXT_REU
+    if (jtxt_reu_ready) {
+        // Glyph DMA from the REU copy: no $01 or $DE00 access
+        jtxt_reu_fetch_glyph(char_code, dst_addr);
+        return;
+    }
+#endif
+
+    // ROM access (index lookup needs the ROM visible)
+    uint8_t saved_01 = *(volatile uint8_t *)0x01;
+    *(volatile uint8_t *)0x01 = saved_01 | 0x01;
+
+    jtxt_rom_glyph(char_code, dst_addr);
 
     *((volatile char *)JTXT_BANK_REG) = 0;
     *(volatile uint8_t *)0x01 = saved_01;
 }
 
+#ifdef JTXT_GLYPH_CACHE
+//=============================================================================
+// Glyph cache: hashed RAM table in front of jtxt_fetch_glyph
+//
+// Each slot holds one 8-byte glyph keyed by its character code. Lookup
+// hashes the code to a bucket and walks a short chain; all slots sit on a
+// doubly linked recency list so a miss recycles the least recently used
+// slot. A hit is a RAM-to-RAM copy with no $01 or $DE00 access.
+//
+// RAM: JTXT_GLYPH_CACHE_SIZE * 14 bytes (896 bytes for 64 entries)
+//=============================================================================
+
+#if JTXT_GLYPH_CACHE_SIZE < 8 || JTXT_GLYPH_CACHE_SIZE > 128 || \
+    (JTXT_GLYPH_CACHE_SIZE & (JTXT_GLYPH_CACHE_SIZE - 1)) != 0
+#error "JTXT_GLYPH_CACHE_SIZE must be a power of 2 between 8 and 128"
+#endif
+
+#define GC_NIL    0xFF
+#define GC_EMPTY  0xFFFFU   // Never a valid character code
+#define GC_MASK   (JTXT_GLYPH_CACHE_SIZE - 1)
+
+static uint8_t  gc_glyph[JTXT_GLYPH_CACHE_SIZE][8];
+static uint16_t gc_code[JTXT_GLYPH_CACHE_SIZE];
+static uint8_t  gc_bucket[JTXT_GLYPH_CACHE_SIZE];  // Hash -> first slot
+static uint8_t  gc_chain[JTXT_GLYPH_CACHE_SIZE];   // Next slot in same bucket
+static uint8_t  gc_newer[JTXT_GLYPH_CACHE_SIZE];   // Recency list links
+static uint8_t  gc_older[JTXT_GLYPH_CACHE_SIZE];
+static uint8_t  gc_mru;                            // Most recently used slot
+static uint8_t  gc_lru;                            // Eviction candidate
+
+uint16_t jtxt_glyph_cache_hits;
+uint16_t jtxt_glyph_cache_misses;
+
+static inline uint8_t gc_hash(uint16_t code) {
+    return ((uint8_t)code ^ (uint8_t)(code >> 8)) & GC_MASK;
+}
+
+void jtxt_glyph_cache_clear(void) {
+    for (uint8_t i = 0; i < JTXT_GLYPH_CACHE_SIZE; i++) {
+        gc_code[i] = GC_EMPTY;
+        gc_bucket[i] = GC_NIL;
+        gc_chain[i] = GC_NIL;
+        gc_newer[i] = i - 1;            // Slot 0 gets GC_NIL (0 - 1)
+        gc_older[i] = i + 1;
+    }
+    gc_older[JTXT_GLYPH_CACHE_SIZE - 1] = GC_NIL;
+    gc_mru = 0;
+    gc_lru = JTXT_GLYPH_CACHE_SIZE - 1;
+}
+
+void jtxt_glyph_cache_reset_stats(void) {
+    jtxt_glyph_cache_hits = 0;
+    jtxt_glyph_cache_misses = 0;
+}
+
+// Move slot to the head of the recency list
+static void gc_touch(uint8_t slot) {
+    uint8_t newer, older;
+
+    if (slot == gc_mru) {
+        return;
+    }
+
+    // Unlink (slot is not MRU, so it always has a newer neighbour)
+    newer = gc_newer[slot];
+    older = gc_older[slot];
+    gc_older[newer] = older;
+    if (older != GC_NIL) {
+        gc_newer[older] = newer;
+    } else {
+        gc_lru = newer;
+    }
+
+    // Insert at head
+    gc_newer[slot] = GC_NIL;
+    gc_older[slot] = gc_mru;
+    gc_newer[gc_mru] = slot;
+    gc_mru = slot;
+}
+
+// Return the RAM copy of a glyph, fetching it from ROM on a miss
+static const uint8_t *gc_lookup(uint16_t char_code) {
+    uint8_t h = gc_hash(char_code);
+    uint8_t slot = gc_bucket[h];
+
+    while (slot != GC_NIL) {
+        if (gc_code[slot] == char_code) {
+            jtxt_glyph_cache_hits++;
+            gc_touch(slot);
+            return gc_glyph[slot];
+        }
+        slot = gc_chain[slot];
+    }
+
+    // Miss: recycle the least recently used slot
+    jtxt_glyph_cache_misses++;
+    slot = gc_lru;
+
+    if (gc_code[slot] != GC_EMPTY) {
+        // Unhook from its old bucket chain
+        uint8_t old_h = gc_hash(gc_code[slot]);
+        uint8_t s = gc_bucket[old_h];
+        if (s == slot) {
+            gc_bucket[old_h] = gc_chain[slot];
+        } else {
+            while (gc_chain[s] != slot) {
+                s = gc_chain[s];
+            }
+            gc_chain[s] = gc_chain[slot];
+        }
+    }
+
+    gc_code[slot] = char_code;
+    gc_chain[slot] = gc_bucket[h];
+    gc_bucket[h] = slot;
+    gc_touch(slot);
+
+    jtxt_fetch_glyph(char_code, (uint16_t)gc_glyph[slot]);
+    return gc_glyph[slot];
+}
+#endif
+
+void jtxt_draw_font_to_bitmap(uint16_t char_code) {
+    uint8_t cx = jtxt_state.cursor_x;
+    uint8_t cy = jtxt_state.cursor_y;
+
+#ifdef JTXT_SHADOW
+    uint16_t si = shadow_row_off[cy] + cx;
+    if (shadow_skip_same && shadow_code[si] == char_code &&
+        shadow_color[si] == jtxt_state.bitmap_color) {
+        // Cell already shows this glyph: no ROM fetch, no bitmap write
+        return;
+    }
+    shadow_code[si] = char_code;
+    shadow_color[si] = jtxt_state.bitmap_color;
+#endif
+
+    // Color RAM: table lookup (no multiplication)
+    *(volatile uint8_t *)(screen_row_addr[cy] + cx) = jtxt_state.bitmap_color;
+
+    // Bitmap address: table lookup + shift (no multiplication)
+    uint16_t dst = bitmap_row_addr[cy] + ((uint16_t)cx << 3);
+
+    if (char_code == 0x20) {
+        // Space: zero-fill without ROM access
+        *(volatile uint32_t *)(dst)     = 0;
+        *(volatile uint32_t *)(dst + 4) = 0;
+        return;
+    }
+
+#ifdef JTXT_GLYPH_CACHE
+    // Cached glyph: plain RAM copy, no bank switching
+    uint16_t src = (uint16_t)gc_lookup(char_code);
+#if USE_ASM_COPY
+    __asm volatile {
+        ldy #0
+        lda (src),y
+        sta (dst),y
+        iny
+        lda (src),y
+        sta (dst),y
+        iny
+        lda (src),y
+        sta (dst),y
+        iny
+        lda (src),y
+        sta (dst),y
+        iny
+        lda (src),y
+        sta (dst),y
+        iny
+        lda (src),y
+        sta (dst),y
+        iny
+        lda (src),y
+        sta (dst),y
+        iny
+        lda (src),y
+        sta (dst),y
+    }
+#else
+    memcpy((void *)dst, (const void *)src, 8);
+#endif
+#else
+    jtxt_fetch_glyph(char_code, dst);
+#endif
+}
+
 // Internal function for bitmap character output (deferred wrap)
 static void jtxt_bputc_internal(uint16_t char_code) {
     // Check window bounds
@@ -342,11 +626,24 @@ void jtxt_bputs_fast(const char* str) {
     // Cache row base addresses (updated on row change)
     uint16_t bmp_base = bitmap_row_addr[cy];
     uint16_t scr_base = screen_row_addr[cy];
+#ifdef JTXT_SHADOW
+    uint16_t sh_base = shadow_row_off[cy];
+#endif
 
     // Batch ROM access: begin once for entire string
     uint8_t saved_01 = *(volatile uint8_t *)0x01;
     *(volatile uint8_t *)0x01 = saved_01 | 0x01;
 
+#ifdef JTXT_REU
+    // REU glyph DMA: load bank and length once, autoload keeps them
+    bool reu = jtxt_reu_ready;
+    if (reu) {
+        *(volatile uint8_t *)(JTXT_REU_REU_BANK)   = JTXT_REU_FONT_BANK;
+        *(volatile uint8_t *)(JTXT_REU_LENGTH)     = 8;
+        *(volatile uint8_t *)(JTXT_REU_LENGTH + 1) = 0;
+    }
+#endif
+
     while ((_fast_ch = (uint8_t)*str++) != 0) {
         uint16_t char_code;
 
@@ -357,6 +654,9 @@ void jtxt_bputs_fast(const char* str) {
             if (cy < 24) cy++;
             bmp_base = bitmap_row_addr[cy];
             scr_base = screen_row_addr[cy];
+#ifdef JTXT_SHADOW
+            sh_base = shadow_row_off[cy];
+#endif
         }
 
         // Inline SJIS state machine
@@ -379,9 +679,30 @@ void jtxt_bputs_fast(const char* str) {
         // Color RAM
         *(volatile uint8_t *)(scr_base + _fast_cx) = color;
 
+#ifdef JTXT_SHADOW
+        shadow_code[sh_base + _fast_cx] = char_code;
+        shadow_color[sh_base + _fast_cx] = color;
+#endif
+
         // Bitmap address
         uint16_t dst = bmp_base + ((uint16_t)_fast_cx << 3);
 
+#ifdef JTXT_REU
+        if (reu) {
+            if (char_code == 0x20) {
+                *(volatile uint32_t *)(dst)     = 0;
+                *(volatile uint32_t *)(dst + 4) = 0;
+            } else {
+                // Glyph DMA straight into the bitmap cell
+                uint16_t off = jtxt_font_offset(char_code);
+                *(volatile uint8_t *)(JTXT_REU_C64_ADDR)     = (uint8_t)dst;
+                *(volatile uint8_t *)(JTXT_REU_C64_ADDR + 1) = (uint8_t)(dst >> 8);
+                *(volatile uint8_t *)(JTXT_REU_REU_ADDR)     = (uint8_t)off;
+                *(volatile uint8_t *)(JTXT_REU_REU_ADDR + 1) = (uint8_t)(off >> 8);
+                *(volatile uint8_t *)(JTXT_REU_COMMAND) = JTXT_REU_CMD_FETCH | JTXT_REU_CMD_AUTOLOAD;
+            }
+        } else
+#endif
         if ((char_code & 0xFF00) == 0) {
             // Single-byte: ASCII / half-width kana
             uint8_t code = (uint8_t)char_code;
@@ -431,24 +752,31 @@ void jtxt_bputs_fast(const char* str) {
             }
         } else {
             // Double-byte: Kanji
-            uint16_t kanji_offset = jtxt_sjis_to_offset(char_code);
             uint8_t bank;
             uint16_t src;
+#ifdef JTXT_SJIS_INDEX
+            if (jtxt_sjis_index_ready) {
+                src = jtxt_sjis_index_lookup(char_code, &bank);
+            } else
+#endif
+            {
+                uint16_t kanji_offset = jtxt_sjis_to_offset(char_code);
 #ifdef JTXT_EASYFLASH
-            // EasyFlash: 16KB banks
-            if (kanji_offset < 14336) {
-                bank = 1;
-                src = JTXT_ROM_BASE + kanji_offset + 2048;
-            } else {
-                uint16_t adjusted = kanji_offset - 14336;
-                bank = (uint8_t)(adjusted >> 14) + 2;
-                src = JTXT_ROM_BASE + (adjusted & 0x3FFF);
-            }
+                // EasyFlash: 16KB banks
+                if (kanji_offset < 14336) {
+                    bank = 1;
+                    src = JTXT_ROM_BASE + kanji_offset + 2048;
+                } else {
+                    uint16_t adjusted = kanji_offset - 14336;
+                    bank = (uint8_t)(adjusted >> 14) + 2;
+                    src = JTXT_ROM_BASE + (adjusted & 0x3FFF);
+                }
 #else
-            // MagicDesk: 8KB banks (+ JTXT_BANK_OFFSET for CRT)
-            bank = (uint8_t)(kanji_offset >> 13) + 1 + JTXT_BANK_OFFSET;
-            src = JTXT_ROM_BASE + (kanji_offset & 0x1FFF);
+                // MagicDesk: 8KB banks (+ JTXT_BANK_OFFSET for CRT)
+                bank = (uint8_t)(kanji_offset >> 13) + 1 + JTXT_BANK_OFFSET;
+                src = JTXT_ROM_BASE + (kanji_offset & 0x1FFF);
 #endif
+            }
             *((volatile char *)JTXT_BANK_REG) = bank;
 #if USE_ASM_COPY
             __asm volatile {
@@ -508,20 +836,482 @@ void jtxt_bputs_fast(const char* str) {
     jtxt_state.wrap_pending = fast_wrap_pending;
 }
 
+//=============================================================================
+// bputn: Batched output of a received run
+//
+// Draws length bytes exactly as jtxt_bputc would (SJIS state carried over
+// between calls, invalid second bytes, window, auto-wrap and scroll), but
+// a row at a time:
+//   1. Decode the bytes that fit on the row (ROM hidden, so the source may
+//      lie under BASIC ROM and the shadow buffer can be updated)
+//   2. Draw the whole row segment under one ROM window
+// Control codes (< 0x20) are skipped: callers handle BS/CR/LF themselves.
+//=============================================================================
+
+// Draw n decoded cells from column cx of row cy
+static void jtxt_bputn_row(const uint16_t* codes, uint8_t cy, uint8_t cx, uint8_t n) {
+    uint8_t color = jtxt_state.bitmap_color;
+    uint16_t scr = screen_row_addr[cy] + cx;
+    uint16_t dst = bitmap_row_addr[cy] + ((uint16_t)cx << 3);
+
+#ifndef JTXT_GLYPH_CACHE
+    bool rom = true;
+#ifdef JTXT_REU
+    rom = !jtxt_reu_ready;
+#endif
+    uint8_t saved_01 = *(volatile uint8_t *)0x01;
+    if (rom) *(volatile uint8_t *)0x01 = saved_01 | 0x01;
+#endif
+
+    for (uint8_t i = 0; i < n; i++) {
+        uint16_t char_code = codes[i];
+
+        *(volatile uint8_t *)scr = color;
+
+        if (char_code == 0x20) {
+            *(volatile uint32_t *)(dst)     = 0;
+            *(volatile uint32_t *)(dst + 4) = 0;
+        } else {
+#ifdef JTXT_GLYPH_CACHE
+            memcpy((void *)dst, gc_lookup(char_code), 8);
+#else
+#ifdef JTXT_REU
+            if (!rom) jtxt_reu_fetch_glyph(char_code, dst); else
+#endif
+            jtxt_rom_glyph(char_code, dst);
+#endif
+        }
+
+        scr++;
+        dst += 8;
+    }
+
+#ifndef JTXT_GLYPH_CACHE
+    if (rom) {
+        *((volatile char *)JTXT_BANK_REG) = 0;
+        *(volatile uint8_t *)0x01 = saved_01;
+    }
+#endif
+}
+
+void jtxt_bputn(const char* data, uint16_t length) {
+    // Off-window or no auto-wrap: keep the per-byte path
+    if (!is_auto_scroll ||
+        (jtxt_state.bitmap_window_enabled &&
+         (jtxt_state.cursor_y < jtxt_state.bitmap_top_row ||
+          jtxt_state.cursor_y > jtxt_state.bitmap_bottom_row))) {
+        while (length--) jtxt_bputc((uint8_t)*data++);
+        return;
+    }
+
+    uint16_t row_code[40];
+    uint16_t out[2];
+    uint8_t sjis = jtxt_state.sjis_first_byte;
+    uint8_t cx = jtxt_state.cursor_x;
+    uint8_t cy = jtxt_state.cursor_y;
+    bool wrap_pending = jtxt_state.wrap_pending;
+    uint8_t start_cx = cx;
+    uint8_t n = 0;
+
+    while (length--) {
+        uint8_t ch = (uint8_t)*data++;
+        uint8_t nout = 0;
+
+        // SJIS state machine (same checks as jtxt_bputc)
+        if (sjis != 0) {
+            if ((ch >= 0x40 && ch <= 0x7E) || (ch >= 0x80 && ch <= 0xFC)) {
+                out[nout++] = ((uint16_t)sjis << 8) | ch;
+                sjis = 0;
+                ch = 0;
+            } else {
+                // Invalid second byte: lead byte is drawn on its own
+                out[nout++] = sjis;
+                sjis = 0;
+            }
+        }
+        if ((ch >= 0x81 && ch <= 0x9F) || (ch >= 0xE0 && ch <= 0xFC)) {
+            sjis = ch;
+        } else if ((ch >= 0xA1 && ch <= 0xDF) || (ch >= 0x20 && ch <= 0x7E)) {
+            out[nout++] = ch;
+        }
+
+        for (uint8_t k = 0; k < nout; k++) {
+            // Deferred wrap: finish this row, then let bnewline scroll
+            if (wrap_pending) {
+                jtxt_bputn_row(row_code, cy, start_cx, n);
+                jtxt_state.cursor_y = cy;
+                jtxt_bnewline();
+                cy = jtxt_state.cursor_y;
+                cx = 0;
+                start_cx = 0;
+                n = 0;
+                wrap_pending = false;
+            }
+
+#ifdef JTXT_SHADOW
+            shadow_code[shadow_row_off[cy] + cx] = out[k];
+            shadow_color[shadow_row_off[cy] + cx] = jtxt_state.bitmap_color;
+#endif
+            row_code[n++] = out[k];
+
+            cx++;
+            if (cx >= 40) {
+                cx = 39;
+                wrap_pending = true;
+            }
+        }
+    }
+
+    jtxt_bputn_row(row_code, cy, start_cx, n);
+
+    // Update state
+    jtxt_state.cursor_x = cx;
+    jtxt_state.cursor_y = cy;
+    jtxt_state.sjis_first_byte = sjis;
+    jtxt_state.wrap_pending = wrap_pending;
+}
+
+#ifdef JTXT_BANK_GROUP
+//=============================================================================
+// Bank-grouped line compositor
+//
+// jtxt_bputs_grouped draws like jtxt_bputs_fast, but in two passes per row:
+//   1. Resolve every glyph to (bank, ROM address, column) and chain it to
+//      its bank; color RAM and spaces are written immediately
+//   2. Select each bank once and copy all of its glyphs into the row
+// $DE00 is written once per distinct bank per row instead of per glyph.
+//=============================================================================
+
+#define GRP_END 0xFF
+
+static uint16_t grp_src[40];    // ROM address of each pending glyph
+static uint8_t  grp_cx[40];     // Destination column of each pending glyph
+static uint8_t  grp_next[40];   // Next pending glyph in the same bank
+static uint8_t  grp_bank[40];   // Distinct banks used on the row
+static uint8_t  grp_head[40];   // First pending glyph of each bank
+static uint8_t  grp_nglyph;
+static uint8_t  grp_nbank;
+
+static void grp_add(uint8_t bank, uint16_t src, uint8_t cx) {
+    uint8_t g = grp_nglyph++;
+    uint8_t b = 0;
+
+    grp_src[g] = src;
+    grp_cx[g] = cx;
+
+    // Few distinct banks per row, so a linear search is enough
+    while (b < grp_nbank && grp_bank[b] != bank) b++;
+    if (b == grp_nbank) {
+        grp_bank[b] = bank;
+        grp_head[b] = GRP_END;
+        grp_nbank++;
+    }
+
+    // Order within a bank does not matter: push to front
+    grp_next[g] = grp_head[b];
+    grp_head[b] = g;
+}
+
+// Copy all pending glyphs into the row at bmp_base (ROM must be visible)
+static void grp_flush(uint16_t bmp_base) {
+    for (uint8_t b = 0; b < grp_nbank; b++) {
+        uint8_t g = grp_head[b];
+
+        *((volatile char *)JTXT_BANK_REG) = grp_bank[b];
+
+        while (g != GRP_END) {
+            uint16_t src = grp_src[g];
+            uint16_t dst = bmp_base + ((uint16_t)grp_cx[g] << 3);
+#if USE_ASM_COPY
+            __asm volatile {
+                ldy #0
+                lda (src),y
+                sta (dst),y
+                iny
+                lda (src),y
+                sta (dst),y
+                iny
+                lda (src),y
+                sta (dst),y
+                iny
+                lda (src),y
+                sta (dst),y
+                iny
+                lda (src),y
+                sta (dst),y
+                iny
+                lda (src),y
+                sta (dst),y
+                iny
+                lda (src),y
+                sta (dst),y
+                iny
+                lda (src),y
+                sta (dst),y
+            }
+#else
+            *(volatile uint8_t *)(dst)     = *(volatile uint8_t *)(src);
+            *(volatile uint8_t *)(dst + 1) = *(volatile uint8_t *)(src + 1);
+            *(volatile uint8_t *)(dst + 2) = *(volatile uint8_t *)(src + 2);
+            *(volatile uint8_t *)(dst + 3) = *(volatile uint8_t *)(src + 3);
+            *(volatile uint8_t *)(dst + 4) = *(volatile uint8_t *)(src + 4);
+            *(volatile uint8_t *)(dst + 5) = *(volatile uint8_t *)(src + 5);
+            *(volatile uint8_t *)(dst + 6) = *(volatile uint8_t *)(src + 6);
+            *(volatile uint8_t *)(dst + 7) = *(volatile uint8_t *)(src + 7);
+#endif
+            g = grp_next[g];
+        }
+    }
+
+    grp_nglyph = 0;
+    grp_nbank = 0;
+}
+
+void jtxt_bputs_grouped(const char* str) {
+#ifdef JTXT_REU
+    if (jtxt_reu_ready) {
+        // No banks to group: glyphs come from the REU by DMA
+        jtxt_bputs_fast(str);
+        return;
+    }
+#endif
+
+    _fast_cx = jtxt_state.cursor_x;
+    _fast_sjis = 0;
+    uint8_t cy = jtxt_state.cursor_y;
+    bool fast_wrap_pending = jtxt_state.wrap_pending;
+    uint8_t color = jtxt_state.bitmap_color;
+
+    // Cache row base addresses (updated on row change)
+    uint16_t bmp_base = bitmap_row_addr[cy];
+    uint16_t scr_base = screen_row_addr[cy];
+#ifdef JTXT_SHADOW
+    uint16_t sh_base = shadow_row_off[cy];
+#endif
+
+    grp_nglyph = 0;
+    grp_nbank = 0;
+
+    // Batch ROM access: begin once for entire string
+    uint8_t saved_01 = *(volatile uint8_t *)0x01;
+    *(volatile uint8_t *)0x01 = saved_01 | 0x01;
+
+    while ((_fast_ch = (uint8_t)*str++) != 0) {
+        uint16_t char_code;
+
+        // Deferred wrap: finish this row before moving to the next
+        if (fast_wrap_pending) {
+            grp_flush(bmp_base);
+            _fast_cx = 0;
+            fast_wrap_pending = false;
+            if (cy < 24) cy++;
+            bmp_base = bitmap_row_addr[cy];
+            scr_base = screen_row_addr[cy];
+#ifdef JTXT_SHADOW
+            sh_base = shadow_row_off[cy];
+#endif
+        }
+
+        // Inline SJIS state machine (no range checks, as in bputs_fast)
+        if (_fast_sjis != 0) {
+            char_code = ((uint16_t)_fast_sjis << 8) | _fast_ch;
+            _fast_sjis = 0;
+        } else if ((_fast_ch >= 0x81 && _fast_ch <= 0x9F) || (_fast_ch >= 0xE0 && _fast_ch <= 0xFC)) {
+            _fast_sjis = _fast_ch;
+            continue;
+        } else {
+            char_code = _fast_ch;
+        }
+
+        // Color RAM
+        *(volatile uint8_t *)(scr_base + _fast_cx) = color;
+
+#ifdef JTXT_SHADOW
+        shadow_code[sh_base + _fast_cx] = char_code;
+        shadow_color[sh_base + _fast_cx] = color;
+#endif
+
+        if ((char_code & 0xFF00) == 0) {
+            // Single-byte: ASCII / half-width kana
+            uint8_t code = (uint8_t)char_code;
+            if (code == 0x20) {
+                uint16_t dst = bmp_base + ((uint16_t)_fast_cx << 3);
+                *(volatile uint32_t *)(dst)     = 0;
+                *(volatile uint32_t *)(dst + 4) = 0;
+            } else {
+                grp_add(1 + JTXT_BANK_OFFSET, JTXT_ROM_BASE + ((uint16_t)code << 3), _fast_cx);
+            }
+        } else {
+            // Double-byte: Kanji
+            uint8_t bank;
+            uint16_t src;
+#ifdef JTXT_SJIS_INDEX
+            if (jtxt_sjis_index_ready) {
+                src = jtxt_sjis_index_lookup(char_code, &bank);
+            } else
+#endif
+            {
+                uint16_t kanji_offset = jtxt_sjis_to_offset(char_code);
+#ifdef JTXT_EASYFLASH
+                // EasyFlash: 16KB banks
+                if (kanji_offset < 14336) {
+                    bank = 1;
+                    src = JTXT_ROM_BASE + kanji_offset + 2048;
+                } else {
+                    uint16_t adjusted = kanji_offset - 14336;
+                    bank = (uint8_t)(adjusted >> 14) + 2;
+                    src = JTXT_ROM_BASE + (adjusted & 0x3FFF);
+                }
+#else
+                // MagicDesk: 8KB banks (+ JTXT_BANK_OFFSET for CRT)
+                bank = (uint8_t)(kanji_offset >> 13) + 1 + JTXT_BANK_OFFSET;
+                src = JTXT_ROM_BASE + (kanji_offset & 0x1FFF);
+#endif
+            }
+            grp_add(bank, src, _fast_cx);
+        }
+
+        // Advance cursor (deferred wrap)
+        _fast_cx++;
+        if (_fast_cx >= 40) {
+            _fast_cx = 39;
+            fast_wrap_pending = true;
+        }
+    }
+
+    grp_flush(bmp_base);
+
+    // Batch ROM access: end once for entire string
+    *((volatile char *)JTXT_BANK_REG) = 0;
+    *(volatile uint8_t *)0x01 = saved_01;
+
+    // Update state
+    jtxt_state.cursor_x = _fast_cx;
+    jtxt_state.cursor_y = cy;
+    jtxt_state.sjis_first_byte = _fast_sjis;
+    jtxt_state.wrap_pending = fast_wrap_pending;
+}
+#endif
+
 void jtxt_bclear_to_eol(void) {
+    jtxt_bclear_chars(40 - jtxt_state.cursor_x);
+}
+
+// Clear count cells from the cursor (up to the end of the line) with block
+// fills; the cursor does not move
+void jtxt_bclear_chars(uint8_t count) {
     uint8_t cx = jtxt_state.cursor_x;
     uint8_t cy = jtxt_state.cursor_y;
     uint16_t bmp = bitmap_row_addr[cy] + ((uint16_t)cx << 3);
-    uint8_t count = 40 - cx;
-    memset((void*)bmp, 0, (uint16_t)count << 3);
-    memset((void*)(screen_row_addr[cy] + cx), jtxt_state.bitmap_color, count);
+    if (cx >= 40) {
+        return;
+    }
+    if (count > (uint8_t)(40 - cx)) {
+        count = 40 - cx;
+    }
+#ifdef JTXT_REU
+    if (jtxt_reu_ready) {
+        jtxt_reu_fill(bmp, 0, (uint16_t)count << 3);
+        jtxt_reu_fill(screen_row_addr[cy] + cx, jtxt_state.bitmap_color, count);
+    } else
+#endif
+    {
+        memset((void*)bmp, 0, (uint16_t)count << 3);
+        memset((void*)(screen_row_addr[cy] + cx), jtxt_state.bitmap_color, count);
+    }
+#ifdef JTXT_SHADOW
+    shadow_fill(cy, cx, count, jtxt_state.bitmap_color);
+#endif
 }
 
 void jtxt_bclear_line(uint8_t row) {
-    memset((void*)bitmap_row_addr[row], 0, 320);
-    memset((void*)screen_row_addr[row], jtxt_state.bitmap_color, 40);
+#ifdef JTXT_REU
+    if (jtxt_reu_ready) {
+        jtxt_reu_fill(bitmap_row_addr[row], 0, 320);
+        jtxt_reu_fill(screen_row_addr[row], jtxt_state.bitmap_color, 40);
+    } else
+#endif
+    {
+        memset((void*)bitmap_row_addr[row], 0, 320);
+        memset((void*)screen_row_addr[row], jtxt_state.bitmap_color, 40);
+    }
+#ifdef JTXT_SHADOW
+    shadow_fill(row, 0, 40, jtxt_state.bitmap_color);
+#endif
+}
+
+#ifdef JTXT_SHADOW
+//=============================================================================
+// Diff output: only cells whose glyph or color changed are redrawn
+//=============================================================================
+
+void jtxt_bputc_diff(uint8_t char_code) {
+    shadow_skip_same = true;
+    jtxt_bputc(char_code);
+    shadow_skip_same = false;
+}
+
+void jtxt_bputs_diff(const char *str) {
+    shadow_skip_same = true;
+    while (*str) {
+        jtxt_bputc(*str);
+        str++;
+    }
+    shadow_skip_same = false;
 }
 
+void jtxt_bline_clear(jtxt_line_t *line, uint8_t color) {
+    for (uint8_t x = 0; x < 40; x++) {
+        line->code[x] = 0x20;
+        line->color[x] = color;
+    }
+}
+
+uint8_t jtxt_bline_puts(jtxt_line_t *line, uint8_t x, const char *str, uint8_t color) {
+    while (*str && x < 40) {
+        uint8_t ch = (uint8_t)*str++;
+        uint16_t code = ch;
+
+        if ((ch >= 0x81 && ch <= 0x9F) || (ch >= 0xE0 && ch <= 0xFC)) {
+            if (*str == 0) {
+                break;
+            }
+            code = ((uint16_t)ch << 8) | (uint8_t)*str++;
+        }
+
+        line->code[x] = code;
+        line->color[x] = color;
+        x++;
+    }
+    return x;
+}
+
+void jtxt_bcommit_row(uint8_t row, const jtxt_line_t *line) {
+    uint16_t si = shadow_row_off[row];
+    uint8_t saved_color = jtxt_state.bitmap_color;
+    uint8_t saved_x = jtxt_state.cursor_x;
+    uint8_t saved_y = jtxt_state.cursor_y;
+
+    jtxt_state.cursor_y = row;
+    for (uint8_t x = 0; x < 40; x++, si++) {
+        uint16_t code = line->code[x];
+        uint8_t color = line->color[x];
+
+        if (shadow_code[si] == code && shadow_color[si] == color) {
+            continue;
+        }
+
+        jtxt_state.cursor_x = x;
+        jtxt_state.bitmap_color = color;
+        jtxt_draw_font_to_bitmap(code);
+    }
+
+    jtxt_state.bitmap_color = saved_color;
+    jtxt_state.cursor_x = saved_x;
+    jtxt_state.cursor_y = saved_y;
+}
+#endif
+
 void jtxt_bput_hex2(uint8_t value) {
     uint8_t hi = value >> 4;
     uint8_t lo = value & 0x0F;
@@ -61,6 +61,156 @@ uint16_t jtxt_sjis_to_offset(uint16_t sjis_code) {
   return ((row + (uint16_t)ch2) << 3) + JTXT_JISX0208_OFFSET;
 }
 
+// Offset of a glyph in the font image (JIS X 0201, then JIS X 0208).
+// ROM bank = JTXT_FONT_FIRST_BANK + offset / JTXT_FONT_BANK_SIZE; the REU
+// copy uses the offset as is.
+uint16_t jtxt_font_offset(uint16_t code) {
+  if ((code & 0xFF00) == 0) {
+    return (uint16_t)(uint8_t)code << 3;
+  }
+  return jtxt_sjis_to_offset(code) + (JTXT_JISX0201_SIZE - JTXT_JISX0208_OFFSET);
+}
+
+#ifdef JTXT_SJIS_INDEX
+//=============================================================================
+// SJIS glyph index (built by createcrt/create_crt.py)
+//
+// Level 1 maps the lead byte to a per-lead block (bank + pointer biased by
+// the trail minimum), level 2 maps the trail byte to the glyph's bank and
+// ROM address. Blocks never straddle a bank, so a lookup is two table loads
+// and two bank switches with no Ku/Ten arithmetic.
+//=============================================================================
+
+uint8_t jtxt_sjis_index_ready;
+
+// Verify index header matches this build's bank layout
+bool jtxt_sjis_index_check(void) {
+  const volatile uint8_t *hdr = (const volatile uint8_t *)JTXT_ROM_BASE;
+
+  jtxt_rom_access_begin();
+  *((volatile char *)JTXT_BANK_REG) = JTXT_SJIS_INDEX_BANK;
+
+  jtxt_sjis_index_ready =
+      hdr[0] == 'S' && hdr[1] == 'J' && hdr[2] == 'X' && hdr[3] == 0 &&
+      hdr[4] == JTXT_SJIS_INDEX_VERSION &&
+      hdr[5] == JTXT_SJIS_INDEX_BANK_UNITS &&
+      hdr[6] == JTXT_SJIS_INDEX_FONT_BANK &&
+      hdr[7] == JTXT_SJIS_INDEX_BANK;
+
+  *((volatile char *)JTXT_BANK_REG) = 0;
+  jtxt_rom_access_end();
+
+  return jtxt_sjis_index_ready;
+}
+
+// Resolve a double-byte code to its glyph bank and ROM address.
+// ROM must already be visible ($01 LORAM set); leaves $DE00 on the index
+// block bank, so the caller switches to *bank before copying.
+uint16_t jtxt_sjis_index_lookup(uint16_t sjis_code, uint8_t *bank) {
+  uint8_t lead = (uint8_t)(sjis_code >> 8) & 0x7F;
+  uint8_t trail = (uint8_t)sjis_code;
+  const volatile uint8_t *hdr = (const volatile uint8_t *)JTXT_ROM_BASE;
+
+  // Level 1: lead byte -> block
+  *((volatile char *)JTXT_BANK_REG) = JTXT_SJIS_INDEX_BANK;
+  uint8_t block_bank = hdr[JTXT_SJIS_INDEX_L1_BANK + lead];
+  const volatile uint8_t *block = (const volatile uint8_t *)
+      (hdr[JTXT_SJIS_INDEX_L1_LO + lead] | ((uint16_t)hdr[JTXT_SJIS_INDEX_L1_HI + lead] << 8));
+
+  // Level 2: trail byte -> glyph bank and address
+  *((volatile char *)JTXT_BANK_REG) = block_bank;
+  *bank = block[trail];
+  return block[JTXT_SJIS_INDEX_STRIDE + trail] |
+         ((uint16_t)block[2 * JTXT_SJIS_INDEX_STRIDE + trail] << 8);
+}
+#endif
+
+#ifdef JTXT_REU
+//=============================================================================
+// REU font store
+//
+// jtxt_reu_init copies the font image bank by bank into REU bank
+// JTXT_REU_FONT_BANK at the same offsets jtxt_font_offset returns. After
+// that a glyph is one 8-byte DMA fetch: no $01 or $DE00 access.
+// Bitmap scroll and clears use JTXT_REU_WORK_BANK for block moves and
+// fills at one cycle per byte.
+//
+// The REU registers sit in IO2 ($DF00), which EasyFlash also uses for its
+// RAM, so jtxt.h rejects JTXT_REU in EasyFlash builds.
+//=============================================================================
+
+uint8_t jtxt_reu_ready;
+
+// One REU transfer (command: JTXT_REU_CMD_STASH / JTXT_REU_CMD_FETCH)
+void jtxt_reu_dma(uint8_t command, uint16_t c64_addr, uint16_t reu_addr, uint8_t reu_bank, uint16_t length) {
+  *(volatile uint8_t *)(JTXT_REU_C64_ADDR)     = (uint8_t)c64_addr;
+  *(volatile uint8_t *)(JTXT_REU_C64_ADDR + 1) = (uint8_t)(c64_addr >> 8);
+  *(volatile uint8_t *)(JTXT_REU_REU_ADDR)     = (uint8_t)reu_addr;
+  *(volatile uint8_t *)(JTXT_REU_REU_ADDR + 1) = (uint8_t)(reu_addr >> 8);
+  *(volatile uint8_t *)(JTXT_REU_REU_BANK)     = reu_bank;
+  *(volatile uint8_t *)(JTXT_REU_LENGTH)       = (uint8_t)length;
+  *(volatile uint8_t *)(JTXT_REU_LENGTH + 1)   = (uint8_t)(length >> 8);
+  *(volatile uint8_t *)(JTXT_REU_COMMAND)      = command;
+}
+
+// Detect the REU with a stash/fetch round trip, then load the fonts.
+// Without an REU the glyph paths keep using the cartridge ROM.
+bool jtxt_reu_init(void) {
+  uint8_t probe[4];
+
+  jtxt_reu_ready = 0;
+
+  *(volatile uint8_t *)(JTXT_REU_ADDR_CTRL) = 0;
+  probe[0] = 'J'; probe[1] = 'T'; probe[2] = 'X'; probe[3] = 'T';
+  jtxt_reu_dma(JTXT_REU_CMD_STASH, (uint16_t)probe, 0, JTXT_REU_FONT_BANK, 4);
+  probe[0] = probe[1] = probe[2] = probe[3] = 0;
+  jtxt_reu_dma(JTXT_REU_CMD_FETCH, (uint16_t)probe, 0, JTXT_REU_FONT_BANK, 4);
+  if (probe[0] != 'J' || probe[1] != 'T' || probe[2] != 'X' || probe[3] != 'T') {
+    return false;
+  }
+
+  // Stash each font bank straight from the ROM window
+  uint16_t reu_addr = 0;
+  uint16_t left = JTXT_FONT_IMAGE_SIZE;
+  uint8_t bank = JTXT_FONT_FIRST_BANK;
+
+  jtxt_rom_access_begin();
+  while (left != 0) {
+    uint16_t length = left < JTXT_FONT_BANK_SIZE ? left : JTXT_FONT_BANK_SIZE;
+    *((volatile char *)JTXT_BANK_REG) = bank++;
+    jtxt_reu_dma(JTXT_REU_CMD_STASH, JTXT_ROM_BASE, reu_addr, JTXT_REU_FONT_BANK, length);
+    reu_addr += length;
+    left -= length;
+  }
+  *((volatile char *)JTXT_BANK_REG) = 0;
+  jtxt_rom_access_end();
+
+  jtxt_reu_ready = 1;
+  return true;
+}
+
+// Fetch one glyph from the REU copy to dest_addr
+void jtxt_reu_fetch_glyph(uint16_t code, uint16_t dest_addr) {
+  jtxt_reu_dma(JTXT_REU_CMD_FETCH, dest_addr, jtxt_font_offset(code), JTXT_REU_FONT_BANK, 8);
+}
+
+// Move a C64 memory block through the REU work bank (C64 -> REU -> C64),
+// so overlapping source and destination are fine
+void jtxt_reu_copy(uint16_t dest_addr, uint16_t src_addr, uint16_t length) {
+  jtxt_reu_dma(JTXT_REU_CMD_STASH, src_addr, JTXT_REU_COPY_ADDR, JTXT_REU_WORK_BANK, length);
+  jtxt_reu_dma(JTXT_REU_CMD_FETCH, dest_addr, JTXT_REU_COPY_ADDR, JTXT_REU_WORK_BANK, length);
+}
+
+// Fill a C64 memory block: stash the byte once, then fetch it with the
+// REU address held fixed
+void jtxt_reu_fill(uint16_t dest_addr, uint8_t value, uint16_t length) {
+  jtxt_reu_dma(JTXT_REU_CMD_STASH, (uint16_t)&value, JTXT_REU_FILL_ADDR, JTXT_REU_WORK_BANK, 1);
+  *(volatile uint8_t *)(JTXT_REU_ADDR_CTRL) = 0x40;
+  jtxt_reu_dma(JTXT_REU_CMD_FETCH, dest_addr, JTXT_REU_FILL_ADDR, JTXT_REU_WORK_BANK, length);
+  *(volatile uint8_t *)(JTXT_REU_ADDR_CTRL) = 0;
+}
+#endif
+
 void jtxt_define_jisx0201(uint8_t jisx0201_code) {
   // Calculate source address in ROM
   uint16_t src_addr = JTXT_ROM_BASE + ((uint16_t)jisx0201_code * 8);
@@ -98,35 +248,45 @@ void jtxt_define_jisx0201(uint8_t jisx0201_code) {
 }
 
 void jtxt_define_kanji(uint16_t sjis_code) {
-  uint16_t kanji_offset = jtxt_sjis_to_offset(sjis_code);
   uint8_t bank;
-  uint16_t in_bank_offset;
+  uint16_t rom_addr;
+
+  // Begin ROM access with $01 register backup
+  jtxt_rom_access_begin();
+
+#ifdef JTXT_SJIS_INDEX
+  if (jtxt_sjis_index_ready) {
+    // Two table loads instead of Ku/Ten + bank arithmetic
+    rom_addr = jtxt_sjis_index_lookup(sjis_code, &bank);
+  } else
+#endif
+  {
+    uint16_t kanji_offset = jtxt_sjis_to_offset(sjis_code);
+    uint16_t in_bank_offset;
 
 #ifdef JTXT_EASYFLASH
-  // EasyFlash: 16KB banks, Bank 1 has JIS X 0201 (2KB) + Kanji part 1
-  if (kanji_offset < 14336) {
-    bank = 1;
-    in_bank_offset = kanji_offset + 2048;
-  } else {
-    uint16_t adjusted = kanji_offset - 14336;
-    bank = (uint8_t)(adjusted >> 14) + 2;
-    in_bank_offset = adjusted & 0x3FFF;
-  }
+    // EasyFlash: 16KB banks, Bank 1 has JIS X 0201 (2KB) + Kanji part 1
+    if (kanji_offset < 14336) {
+      bank = 1;
+      in_bank_offset = kanji_offset + 2048;
+    } else {
+      uint16_t adjusted = kanji_offset - 14336;
+      bank = (uint8_t)(adjusted >> 14) + 2;
+      in_bank_offset = adjusted & 0x3FFF;
+    }
 #else
-  // MagicDesk: 8KB banks (+ JTXT_BANK_OFFSET for CRT)
-  bank = (uint8_t)(kanji_offset >> 13) + 1 + JTXT_BANK_OFFSET;
-  in_bank_offset = kanji_offset & 0x1FFF;
+    // MagicDesk: 8KB banks (+ JTXT_BANK_OFFSET for CRT)
+    bank = (uint8_t)(kanji_offset >> 13) + 1 + JTXT_BANK_OFFSET;
+    in_bank_offset = kanji_offset & 0x1FFF;
 #endif
 
-  // Begin ROM access with $01 register backup
-  jtxt_rom_access_begin();
+    rom_addr = JTXT_ROM_BASE + in_bank_offset;
+  }
 
   // Switch to appropriate bank
   // POKE(JTXT_BANK_REG, bank);
   *((volatile char *)JTXT_BANK_REG) = bank;
 
-  uint16_t rom_addr = JTXT_ROM_BASE + in_bank_offset;
-
   // Copy 8 bytes of font data
   uint16_t dst_addr = jtxt_state.screen_pos;
 
@@ -148,6 +308,14 @@ void jtxt_define_kanji(uint16_t sjis_code) {
 }
 
 void jtxt_define_font(uint16_t dest_addr, uint16_t code) {
+#ifdef JTXT_REU
+  if (jtxt_reu_ready) {
+    // Glyph DMA from the REU copy
+    jtxt_reu_fetch_glyph(code, dest_addr);
+    return;
+  }
+#endif
+
   // Save destination address temporarily
   uint16_t saved_pos = jtxt_state.screen_pos;
   jtxt_state.screen_pos = dest_addr;
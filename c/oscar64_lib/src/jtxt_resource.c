@@ -92,4 +92,106 @@ void jtxt_bputr(uint8_t resource_number) {
   if (jtxt_load_string_resource(resource_number)) {
     jtxt_bputs((const char *)JTXT_STRING_BUFFER);
   }
-}
\ No newline at end of file
+}
+
+#ifdef JTXT_RASTER
+//=============================================================================
+// Pre-rasterized string resources (convert_string_resources.py --raster)
+//
+// Strings are stored as glyph runs in display order and never cross an
+// 8KB bank, so drawing is one bank selection plus a block copy per run:
+// no SJIS decoding and no font lookup.
+//=============================================================================
+
+bool jtxt_bputr_raster(uint8_t resource_number) {
+  const volatile uint8_t *hdr = (const volatile uint8_t *)JTXT_STRING_RESOURCE_BASE;
+
+  // Begin ROM access with $01 register backup
+  jtxt_rom_access_begin();
+
+  // Switch to raster resource bank
+  POKE(JTXT_BANK_REG, JTXT_RASTER_RESOURCE_BANK);
+
+  // Header and range check ('RST\0', 16-bit string count)
+  if (hdr[0] != 'R' || hdr[1] != 'S' || hdr[2] != 'T' || hdr[3] != 0 ||
+      (hdr[5] == 0 && resource_number >= hdr[4])) {
+    POKE(JTXT_BANK_REG, 0);
+    jtxt_rom_access_end();
+    return false;
+  }
+
+  // Read offset table entry (4 bytes per entry, same layout as SJIS table)
+  uint16_t entry = JTXT_RASTER_HEADER_SIZE + (uint16_t)resource_number * 4;
+  uint8_t target_bank = hdr[entry];
+  uint16_t raster_offset = hdr[entry + 2] | ((uint16_t)hdr[entry + 3] << 8);
+
+  // Check for undefined string
+  if (target_bank == 0 && raster_offset == 0) {
+    POKE(JTXT_BANK_REG, 0);
+    jtxt_rom_access_end();
+    return false;
+  }
+
+  // Whole string lives in this bank
+  POKE(JTXT_BANK_REG, target_bank);
+
+  const uint8_t *src = (const uint8_t *)(JTXT_ROM_BASE + raster_offset);
+  uint8_t runs = *src++;
+
+  while (runs-- > 0) {
+    uint8_t flags = src[0];
+    uint8_t fg = src[1];
+    uint8_t width = src[2];
+    uint8_t color = jtxt_state.bitmap_color;
+    src += 3;
+
+    if (fg != JTXT_RASTER_COLOR_CURRENT) {
+      color = (uint8_t)(fg << 4) | (color & 0x0F);
+    }
+
+    if (flags & JTXT_RASTER_FLAG_NEWLINE) {
+      jtxt_bnewline();
+    }
+
+    // Copy the run, splitting it at the right edge (deferred wrap as in
+    // jtxt_bputs_fast)
+    while (width > 0) {
+      if (jtxt_state.wrap_pending) {
+        jtxt_bnewline();
+      }
+
+      uint8_t cx = jtxt_state.cursor_x;
+      uint8_t cy = jtxt_state.cursor_y;
+      uint8_t count = JTXT_CHAR_WIDTH - cx;
+      if (count > width) {
+        count = width;
+      }
+
+      memcpy((void *)(JTXT_BITMAP_BASE + (uint16_t)cy * 320 + ((uint16_t)cx << 3)),
+             src, (uint16_t)count << 3);
+      memset((void *)(JTXT_BITMAP_SCREEN_RAM + (uint16_t)cy * JTXT_CHAR_WIDTH + cx),
+             color, count);
+#ifdef JTXT_SHADOW
+      // Codes are not stored in the raster data
+      jtxt_shadow_invalidate_row(cy);
+#endif
+
+      src += (uint16_t)count << 3;
+      width -= count;
+      cx += count;
+      if (cx >= JTXT_CHAR_WIDTH) {
+        cx = JTXT_CHAR_WIDTH - 1;
+        jtxt_state.wrap_pending = true;
+      }
+      jtxt_state.cursor_x = cx;
+    }
+  }
+
+  // Return to bank 0
+  POKE(JTXT_BANK_REG, 0);
+
+  // End ROM access with $01 register restore
+  jtxt_rom_access_end();
+  return true;
+}
+#endif
@@ -0,0 +1,168 @@
+#ifndef ROMAJI_TABLE_H
+#define ROMAJI_TABLE_H
+
+// Generated by romajiconv.py from romaji.txt, do not edit.
+// See romajiconv/romajiconv.py for the table format.
+
+#define ROMAJI_STATES     37
+#define ROMAJI_KEY_FIRST  44
+#define ROMAJI_KEY_LAST   122
+#define ROMAJI_DEPTH_MAX  2
+
+static const uint16_t romaji_base[37] = {
+    0x0000, 0x004C, 0x005F, 0x0031, 0x006A, 0x0071, 0x007C, 0x008D,
+    0x008F, 0x0098, 0x001A, 0x009A, 0x00AB, 0x0036, 0x0043, 0x00C7,
+    0x00B6, 0x0062, 0x00AD, 0x00D4, 0x00D1, 0x00C8, 0x00DE, 0x00E3,
+    0x00EA, 0x00EB, 0x00ED, 0x00EE, 0x00EF, 0x00F6, 0x00FA, 0x0105,
+    0x00D2, 0x0106, 0x00D3, 0x0107, 0x0109
+};
+
+static const uint8_t romaji_check[344] = {
+    0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x0A,
+    0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0xFF, 0x0A, 0x0A, 0x0A, 0x0A, 0xFF,
+    0x0A, 0x0A, 0x0A, 0x0A, 0xFF, 0x0A, 0x03, 0x0A, 0x0A, 0x03, 0x03, 0x0D, 0xFF, 0x03, 0x03, 0x0D,
+    0xFF, 0xFF, 0x0D, 0x0D, 0x03, 0xFF, 0xFF, 0xFF, 0x0E, 0x0D, 0x03, 0xFF, 0x0E, 0x0D, 0x03, 0x0D,
+    0x0E, 0x01, 0x01, 0x0D, 0xFF, 0x01, 0x0E, 0xFF, 0xFF, 0x01, 0x0E, 0x0E, 0x0E, 0xFF, 0xFF, 0x01,
+    0x0E, 0xFF, 0xFF, 0xFF, 0x02, 0x01, 0x02, 0x11, 0x02, 0x01, 0xFF, 0x02, 0x02, 0xFF, 0xFF, 0x04,
+    0xFF, 0xFF, 0x02, 0x04, 0x04, 0x11, 0x05, 0x04, 0x02, 0xFF, 0x05, 0x11, 0x05, 0x04, 0x05, 0x11,
+    0xFF, 0x06, 0xFF, 0x04, 0x05, 0x06, 0xFF, 0x04, 0x06, 0x06, 0x05, 0xFF, 0xFF, 0xFF, 0x05, 0x06,
+    0xFF, 0xFF, 0x07, 0xFF, 0x08, 0x06, 0x07, 0xFF, 0x08, 0x06, 0x07, 0x07, 0x08, 0x09, 0x08, 0x0B,
+    0x07, 0x09, 0x08, 0x0B, 0xFF, 0x09, 0x07, 0x0B, 0x08, 0x09, 0x07, 0x09, 0x08, 0x0B, 0x0B, 0xFF,
+    0x0C, 0x09, 0x12, 0x0B, 0x0C, 0x09, 0x12, 0x0B, 0x0C, 0xFF, 0x12, 0x10, 0xFF, 0xFF, 0x0C, 0x10,
+    0x12, 0x0C, 0xFF, 0x10, 0x0C, 0xFF, 0x12, 0xFF, 0x0C, 0x10, 0x12, 0x12, 0x0F, 0x15, 0xFF, 0x10,
+    0x0F, 0x15, 0xFF, 0x10, 0x0F, 0x15, 0x14, 0x20, 0x22, 0x13, 0x0F, 0x15, 0x22, 0xFF, 0x14, 0x20,
+    0x22, 0x15, 0x0F, 0x16, 0x14, 0x20, 0x22, 0x13, 0x17, 0xFF, 0x14, 0x20, 0x22, 0x13, 0xFF, 0x18,
+    0x19, 0x16, 0x1A, 0x1B, 0x1C, 0xFF, 0x17, 0x16, 0xFF, 0xFF, 0xFF, 0x1D, 0x17, 0x18, 0x19, 0x1E,
+    0x1A, 0x1B, 0x1C, 0x18, 0x19, 0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1F, 0x21, 0x23, 0x1E, 0x24, 0x1D,
+    0xFF, 0xFF, 0xFF, 0x1E, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x21, 0x23, 0xFF, 0x24, 0xFF, 0x1F, 0x21,
+    0x23, 0xFF, 0x24, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static const uint8_t romaji_next[344] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x00, 0x04, 0x05, 0x06, 0x00, 0x07, 0x08,
+    0x00, 0x09, 0x0A, 0x00, 0x0B, 0x00, 0x0C, 0x0D, 0x0E, 0x00, 0x00, 0x0F, 0x10, 0x11, 0x12, 0x00,
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x05, 0x06, 0x00, 0x07, 0x08, 0x00, 0x09, 0x00, 0x00, 0x0B, 0x00,
+    0x0C, 0x0D, 0x0E, 0x00, 0x00, 0x0F, 0x00, 0x1D, 0x12, 0x03, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00,
+    0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x16, 0x00,
+    0x00, 0x00, 0x01, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x0E, 0x00, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x13, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x11,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x17, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0x07, 0x00, 0x00, 0x08, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x1A, 0x00, 0x1B, 0x00, 0x0B, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x24, 0x12, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t romaji_out[344] = {
+    0x01, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x36,
+    0x37, 0x37, 0x37, 0x38, 0x37, 0x37, 0x37, 0x39, 0x37, 0x37, 0x00, 0x37, 0x37, 0x3A, 0x37, 0x00,
+    0x37, 0x37, 0x37, 0x3B, 0x00, 0x37, 0x14, 0x00, 0x37, 0x0A, 0x15, 0x46, 0x00, 0x00, 0x16, 0x47,
+    0x00, 0x00, 0x00, 0x48, 0x17, 0x00, 0x00, 0x00, 0x0F, 0x49, 0x18, 0x00, 0x10, 0x0A, 0x00, 0x4A,
+    0x11, 0x09, 0x0A, 0x00, 0x00, 0x0B, 0x12, 0x00, 0x00, 0x0C, 0x00, 0x0A, 0x13, 0x00, 0x00, 0x0D,
+    0x00, 0x00, 0x00, 0x00, 0x0F, 0x0E, 0x0A, 0x55, 0x10, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x19,
+    0x00, 0x00, 0x12, 0x1A, 0x0A, 0x56, 0x1E, 0x1B, 0x13, 0x00, 0x1F, 0x57, 0x0A, 0x1C, 0x20, 0x0A,
+    0x00, 0x23, 0x00, 0x1D, 0x21, 0x24, 0x00, 0x00, 0x0A, 0x25, 0x22, 0x00, 0x00, 0x00, 0x00, 0x26,
+    0x00, 0x00, 0x27, 0x00, 0x2C, 0x1D, 0x28, 0x00, 0x2D, 0x00, 0x29, 0x0A, 0x2E, 0x31, 0x0A, 0x3C,
+    0x2A, 0x32, 0x2F, 0x3D, 0x00, 0x33, 0x2B, 0x3E, 0x30, 0x0A, 0x00, 0x34, 0x00, 0x3F, 0x0A, 0x00,
+    0x41, 0x35, 0x58, 0x40, 0x42, 0x00, 0x59, 0x00, 0x43, 0x00, 0x29, 0x4F, 0x00, 0x00, 0x44, 0x50,
+    0x5A, 0x0A, 0x00, 0x51, 0x45, 0x00, 0x5B, 0x00, 0x00, 0x52, 0x00, 0x0A, 0x4B, 0x62, 0x00, 0x53,
+    0x4C, 0x63, 0x00, 0x54, 0x4D, 0x64, 0x5F, 0x82, 0x13, 0x5C, 0x4E, 0x65, 0x13, 0x00, 0x11, 0x48,
+    0x13, 0x66, 0x0A, 0x67, 0x60, 0x83, 0x13, 0x5D, 0x6A, 0x00, 0x61, 0x84, 0x13, 0x5E, 0x00, 0x6D,
+    0x70, 0x68, 0x27, 0x73, 0x76, 0x00, 0x6B, 0x69, 0x00, 0x00, 0x00, 0x79, 0x6C, 0x6E, 0x71, 0x7C,
+    0x2A, 0x74, 0x77, 0x6F, 0x72, 0x00, 0x2B, 0x75, 0x78, 0x7A, 0x7F, 0x82, 0x5F, 0x7D, 0x27, 0x7B,
+    0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x80, 0x83, 0x60, 0x00, 0x2A, 0x00, 0x81, 0x84,
+    0x61, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t romaji_parent[37] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C,
+    0x0D, 0x0D, 0x0E, 0x0E, 0x12
+};
+
+static const uint8_t romaji_key[37] = {
+    0, 'b', 'c', 'd', 'f', 'g', 'h', 'j', 'k', 'm', 'n', 'p', 'r', 's', 't', 'w',
+    'x', 'y', 'z', 'y', 'h', 'h', 'y', 'y', 'y', 'y', 'y', 'y', 'y', 'y', 'y', 'y',
+    'h', 'y', 's', 'y', 'y'
+};
+
+static const uint8_t romaji_depth[37] = {
+    0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x02
+};
+
+static const uint16_t romaji_output[133] = {
+    0x0000, 0x0001, 0x0004, 0x0007, 0x000A, 0x000D, 0x0010, 0x0013,
+    0x0016, 0x0019, 0x001C, 0x001F, 0x0022, 0x0025, 0x0028, 0x002B,
+    0x002E, 0x0031, 0x0034, 0x0037, 0x003A, 0x003D, 0x0040, 0x0043,
+    0x0046, 0x0049, 0x004E, 0x0053, 0x0058, 0x005D, 0x0060, 0x0063,
+    0x0066, 0x0069, 0x006C, 0x006F, 0x0072, 0x0075, 0x0078, 0x007B,
+    0x0080, 0x0085, 0x0088, 0x008D, 0x0092, 0x0095, 0x0098, 0x009B,
+    0x009E, 0x00A1, 0x00A4, 0x00A7, 0x00AA, 0x00AD, 0x00B0, 0x00B3,
+    0x00B6, 0x00B9, 0x00BC, 0x00BF, 0x00C2, 0x00C5, 0x00C8, 0x00CB,
+    0x00CE, 0x00D1, 0x00D4, 0x00D7, 0x00DA, 0x00DD, 0x00E0, 0x00E3,
+    0x00E6, 0x00E9, 0x00EC, 0x00EF, 0x00F2, 0x00F7, 0x00FC, 0x00FF,
+    0x0102, 0x0105, 0x0108, 0x010B, 0x010E, 0x0111, 0x0114, 0x0117,
+    0x011A, 0x011D, 0x0120, 0x0123, 0x0126, 0x012B, 0x0130, 0x0135,
+    0x013A, 0x013F, 0x0144, 0x0149, 0x014E, 0x0153, 0x0158, 0x015D,
+    0x0162, 0x0167, 0x016C, 0x0171, 0x0176, 0x017B, 0x0180, 0x0185,
+    0x018A, 0x018F, 0x0194, 0x0199, 0x019E, 0x01A3, 0x01A8, 0x01AD,
+    0x01B2, 0x01B7, 0x01BC, 0x01C1, 0x01C6, 0x01CB, 0x01D0, 0x01D5,
+    0x01DA, 0x01DF, 0x01E4, 0x01E9, 0x01EE
+};
+
+static const uint8_t romaji_kana[499] = {
+    0x00, 0x81, 0x41, 0x00, 0x81, 0x5B, 0x00, 0x81, 0x42, 0x00, 0x82, 0xA0, 0x00, 0x82, 0xA6, 0x00,
+    0x82, 0xA2, 0x00, 0x82, 0xA8, 0x00, 0x82, 0xA4, 0x00, 0x82, 0xCE, 0x00, 0x82, 0xC1, 0x00, 0x82,
+    0xD7, 0x00, 0x82, 0xD1, 0x00, 0x82, 0xDA, 0x00, 0x82, 0xD4, 0x00, 0x82, 0xBD, 0x00, 0x82, 0xC4,
+    0x00, 0x82, 0xBF, 0x00, 0x82, 0xC6, 0x00, 0x82, 0xC2, 0x00, 0x82, 0xBE, 0x00, 0x82, 0xC5, 0x00,
+    0x82, 0xC0, 0x00, 0x82, 0xC7, 0x00, 0x82, 0xC3, 0x00, 0x82, 0xD3, 0x82, 0x9F, 0x00, 0x82, 0xD3,
+    0x82, 0xA5, 0x00, 0x82, 0xD3, 0x82, 0xA1, 0x00, 0x82, 0xD3, 0x82, 0xA7, 0x00, 0x82, 0xD3, 0x00,
+    0x82, 0xAA, 0x00, 0x82, 0xB0, 0x00, 0x82, 0xAC, 0x00, 0x82, 0xB2, 0x00, 0x82, 0xAE, 0x00, 0x82,
+    0xCD, 0x00, 0x82, 0xD6, 0x00, 0x82, 0xD0, 0x00, 0x82, 0xD9, 0x00, 0x82, 0xB6, 0x82, 0xE1, 0x00,
+    0x82, 0xB6, 0x82, 0xA5, 0x00, 0x82, 0xB6, 0x00, 0x82, 0xB6, 0x82, 0xE5, 0x00, 0x82, 0xB6, 0x82,
+    0xE3, 0x00, 0x82, 0xA9, 0x00, 0x82, 0xAF, 0x00, 0x82, 0xAB, 0x00, 0x82, 0xB1, 0x00, 0x82, 0xAD,
+    0x00, 0x82, 0xDC, 0x00, 0x82, 0xDF, 0x00, 0x82, 0xDD, 0x00, 0x82, 0xE0, 0x00, 0x82, 0xDE, 0x00,
+    0x82, 0xC8, 0x00, 0x82, 0xF1, 0x00, 0x82, 0xCB, 0x00, 0x82, 0xC9, 0x00, 0x82, 0xCC, 0x00, 0x82,
+    0xCA, 0x00, 0x82, 0xCF, 0x00, 0x82, 0xD8, 0x00, 0x82, 0xD2, 0x00, 0x82, 0xDB, 0x00, 0x82, 0xD5,
+    0x00, 0x82, 0xE7, 0x00, 0x82, 0xEA, 0x00, 0x82, 0xE8, 0x00, 0x82, 0xEB, 0x00, 0x82, 0xE9, 0x00,
+    0x82, 0xB3, 0x00, 0x82, 0xB9, 0x00, 0x82, 0xB5, 0x00, 0x82, 0xBB, 0x00, 0x82, 0xB7, 0x00, 0x82,
+    0xED, 0x00, 0x82, 0xA4, 0x82, 0xA5, 0x00, 0x82, 0xA4, 0x82, 0xA1, 0x00, 0x82, 0xF0, 0x00, 0x82,
+    0x9F, 0x00, 0x82, 0xA5, 0x00, 0x82, 0xA1, 0x00, 0x82, 0xA7, 0x00, 0x82, 0xA3, 0x00, 0x82, 0xE1,
+    0x00, 0x82, 0xE2, 0x00, 0x82, 0xE6, 0x00, 0x82, 0xE4, 0x00, 0x82, 0xB4, 0x00, 0x82, 0xBA, 0x00,
+    0x82, 0xBC, 0x00, 0x82, 0xB8, 0x00, 0x82, 0xD1, 0x82, 0xE1, 0x00, 0x82, 0xD1, 0x82, 0xE5, 0x00,
+    0x82, 0xD1, 0x82, 0xE3, 0x00, 0x82, 0xBF, 0x82, 0xE1, 0x00, 0x82, 0xBF, 0x82, 0xE5, 0x00, 0x82,
+    0xBF, 0x82, 0xE3, 0x00, 0x82, 0xC5, 0x82, 0xE1, 0x00, 0x82, 0xC5, 0x82, 0xA5, 0x00, 0x82, 0xC5,
+    0x82, 0xA1, 0x00, 0x82, 0xC5, 0x82, 0xE5, 0x00, 0x82, 0xC5, 0x82, 0xE3, 0x00, 0x82, 0xC0, 0x82,
+    0xE1, 0x00, 0x82, 0xC0, 0x82, 0xE5, 0x00, 0x82, 0xC0, 0x82, 0xE3, 0x00, 0x82, 0xD3, 0x82, 0xE1,
+    0x00, 0x82, 0xD3, 0x82, 0xE5, 0x00, 0x82, 0xD3, 0x82, 0xE3, 0x00, 0x82, 0xAC, 0x82, 0xE1, 0x00,
+    0x82, 0xAC, 0x82, 0xE5, 0x00, 0x82, 0xAC, 0x82, 0xE3, 0x00, 0x82, 0xD0, 0x82, 0xE1, 0x00, 0x82,
+    0xD0, 0x82, 0xE5, 0x00, 0x82, 0xD0, 0x82, 0xE3, 0x00, 0x82, 0xAB, 0x82, 0xE1, 0x00, 0x82, 0xAB,
+    0x82, 0xE5, 0x00, 0x82, 0xAB, 0x82, 0xE3, 0x00, 0x82, 0xDD, 0x82, 0xE1, 0x00, 0x82, 0xDD, 0x82,
+    0xE5, 0x00, 0x82, 0xDD, 0x82, 0xE3, 0x00, 0x82, 0xC9, 0x82, 0xE1, 0x00, 0x82, 0xC9, 0x82, 0xE5,
+    0x00, 0x82, 0xC9, 0x82, 0xE3, 0x00, 0x82, 0xD2, 0x82, 0xE1, 0x00, 0x82, 0xD2, 0x82, 0xE5, 0x00,
+    0x82, 0xD2, 0x82, 0xE3, 0x00, 0x82, 0xE8, 0x82, 0xE1, 0x00, 0x82, 0xE8, 0x82, 0xE5, 0x00, 0x82,
+    0xE8, 0x82, 0xE3, 0x00, 0x82, 0xB5, 0x82, 0xE1, 0x00, 0x82, 0xB5, 0x82, 0xE5, 0x00, 0x82, 0xB5,
+    0x82, 0xE3, 0x00
+};
+
+#endif /* ROMAJI_TABLE_H */
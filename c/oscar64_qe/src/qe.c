@@ -828,6 +828,11 @@ static bool process_ime_insert(bool replacing)
                 // モード変更（ひらがな⇔カタカナ）はIME継続
                 return true;
 
+            case IME_EVENT_BUSY:
+            case IME_EVENT_CANDIDATES_READY:
+                // 変換中・候補表示もIME継続
+                continue;
+
             case IME_EVENT_CANCELLED:
             case IME_EVENT_DEACTIVATED:
                 // IME無効化時は通常入力に戻る
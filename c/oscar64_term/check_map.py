@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""
+Check the MagicDesk terminal's RAM layout in the Oscar64 map file
+
+The CRT copies its code from ROM banks into fixed RAM windows (see the
+region pragmas in src/term_main.c): the IME overlay runs at $2300-$42FF
+and the stack and heap follow it, and BSS has $C000-$CFFF. This prints
+where every group of sections ended up and how much of its window is
+left, and fails when one runs past the window.
+
+Usage:
+  python3 check_map.py jterm.map
+"""
+
+import re
+import sys
+
+# Name, sections, RAM window start, window end (exclusive)
+WINDOWS = [
+    ('Main code (bank 0)',        ('mcode', 'mdata'), 0x0900, 0x2300),
+    ('IME overlay (bank 1)',      ('icode', 'idata'), 0x2300, 0x4300),
+    ('XMODEM overlay (bank 37)',  ('xcode', 'xdata'), 0x2300, 0x4300),
+    ('BSS',                       ('bss',),           0xC000, 0xD000),
+]
+
+SECTION_LINE = re.compile(r'^([0-9a-fA-F]{4,}) - ([0-9a-fA-F]{4,}) : (.*)$')
+
+def read_sections(filename):
+    """Returns {section name: (start, end)} from the map's sections list"""
+    sections = {}
+    in_sections = False
+    with open(filename, 'r', encoding='latin-1') as f:
+        for line in f:
+            line = line.strip()
+            if line == 'sections':
+                in_sections = True
+                continue
+            if line in ('regions', 'objects'):
+                in_sections = False
+                continue
+            m = SECTION_LINE.match(line)
+            if not in_sections or not m:
+                continue
+            name = m.group(3).split(',')[-1].strip()
+            start, end = int(m.group(1), 16), int(m.group(2), 16)
+            if name in sections:
+                start = min(start, sections[name][0])
+                end = max(end, sections[name][1])
+            sections[name] = (start, end)
+    return sections
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    sections = read_sections(sys.argv[1])
+    if not sections:
+        print(f"Warning: no sections found in {sys.argv[1]}, layout not checked", file=sys.stderr)
+        return 0
+
+    failed = False
+    print(f"{'WINDOW':26} {'USED':>11} {'LIMIT':>11} {'FREE':>6}")
+    for label, names, low, high in WINDOWS:
+        found = [sections[n] for n in names if n in sections]
+        if not found:
+            print(f"{label:26} {'-':>11} ${low:04X}-${high - 1:04X} {'-':>6}")
+            continue
+        start = min(s for s, _ in found)
+        end = max(e for _, e in found)
+        used = f"${start:04X}-${max(end - 1, start):04X}"
+        free = high - end
+        mark = ''
+        if start < low or end > high:
+            mark = ' OVERFLOW'
+            failed = True
+        print(f"{label:26} {used:>11} ${low:04X}-${high - 1:04X} {free:>6}{mark}")
+
+    if failed:
+        print("Error: a section runs outside its RAM window (see term_main.c)", file=sys.stderr)
+        return 1
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
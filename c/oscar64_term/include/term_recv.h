@@ -0,0 +1,18 @@
+/*
+ * Received data handling for C64 Japanese Terminal
+ *
+ * Telnet filter, ANSI escape sequences (cursor, erase, SGR colors) and
+ * BS erase patterns on the data read from the socket.
+ */
+
+#ifndef _TERM_RECV_H_
+#define _TERM_RECV_H_
+
+// Reset the ANSI and BS parser states (start of a session)
+void term_recv_init(void);
+
+// Process count received bytes and draw them in the terminal window.
+// data points at the payload (after the c64u_socketread length header).
+void term_recv_process(const char *data, int count);
+
+#endif // _TERM_RECV_H_
@@ -21,11 +21,13 @@ void telnet_init(unsigned char socketid)
 	telnet.socketid = socketid;
 }
 
+// Queued, so a reply made while received data is processed does not
+// overwrite c64u_data; the terminal loop sends it at the end of the pass
 void telnet_send_iac(unsigned char verb, unsigned char opt)
 {
-	c64u_socketwritechar(telnet.socketid, (char)NVT_IAC);
-	c64u_socketwritechar(telnet.socketid, (char)verb);
-	c64u_socketwritechar(telnet.socketid, (char)opt);
+	c64u_socketqueuechar(telnet.socketid, (char)NVT_IAC);
+	c64u_socketqueuechar(telnet.socketid, (char)verb);
+	c64u_socketqueuechar(telnet.socketid, (char)opt);
 }
 
 // Handle WILL/DO/WONT/DONT negotiation
@@ -29,6 +29,7 @@
 #include "c64u_network.h"
 #include "c64u_turbo.h"
 #include "telnet.h"
+#include "term_recv.h"
 #include "ime.h"
 #include "xmodem.h"
 
@@ -42,7 +43,8 @@ jtxt_state_t jtxt_state;
 // MagicDesk CRT: 2-bank code layout with ROM-to-RAM copy
 // Bank 0: bootstrap (ROM) + main code (copied to $0900) + ccopy (copied to $0380)
 // Bank 1: IME code (copied to $2300)
-// Banks 2-10: fonts, Banks 11-36: dictionary
+// Banks 2-10: fonts, Banks 11-35: dictionary (version 3 term_skkdic.bin,
+// size checked by the Makefile), Bank 37: XMODEM overlay
 #pragma region(boot, 0x8080, 0x8600, , 0, { code, data })
 #pragma section(ccode, 0)
 #pragma region(crom, 0x9E00, 0xA000, , 0, { ccode }, 0x0380)
@@ -78,8 +80,15 @@ jtxt_state_t jtxt_state;
 #ifndef JTXT_CRT
 // Current disk device number (read from $BA at init)
 static unsigned char disk_dev = 8;
+
+// IME conversion cache, loaded per session and saved on disconnect
+#define IME_MRU_FILE "u-term-mru"
 #endif
 
+// Dictionary lookups per ime_process call: a conversion is spread over
+// several loop passes so received data keeps being drawn
+#define IME_LOOKUPS_PER_POLL 2
+
 static char hosts[MAX_HOSTS][HOST_NAME_SIZE];
 static unsigned int ports[MAX_HOSTS];
 static unsigned char host_count;
@@ -166,10 +175,11 @@ static unsigned char read_key(void)
 	return key;
 }
 
-// Send a single ASCII character over the socket
+// Queue a single ASCII character for the socket (sent at the end of the
+// main loop pass)
 static void send_ascii_char(unsigned char socketid, unsigned char c)
 {
-	c64u_socketwritechar(socketid, (char)c);
+	c64u_socketqueuechar(socketid, (char)c);
 }
 
 //=============================================================================
@@ -488,244 +498,6 @@ static int select_host(void)
 	}
 }
 
-//=============================================================================
-// ANSI escape sequence parser
-//=============================================================================
-
-#define ANSI_STATE_NORMAL 0
-#define ANSI_STATE_ESC    1  // Got ESC
-#define ANSI_STATE_CSI    2  // Got ESC [
-
-static unsigned char ansi_state = ANSI_STATE_NORMAL;
-
-// CSI parameter buffer
-#define ANSI_MAX_PARAMS 4
-static unsigned char ansi_params[ANSI_MAX_PARAMS];
-static unsigned char ansi_param_count;
-static unsigned int ansi_current_param;
-static bool ansi_has_digit;
-
-// ANSI 8-color -> C64 color mapping
-static const unsigned char ansi_to_c64_color[8] = {
-	COLOR_BLACK, COLOR_RED, COLOR_GREEN, COLOR_YELLOW,
-	COLOR_BLUE, COLOR_PURPLE, COLOR_CYAN, COLOR_WHITE
-};
-
-// BS erase pattern detection state machine
-// Halfwidth erase: BS SP BS         -> jtxt_bbackspace() once
-// Fullwidth erase: BS BS SP SP BS BS -> jtxt_bbackspace() once
-// Other patterns are discarded
-#define BS_STATE_NORMAL         0
-#define BS_STATE_BS1            1  // Got BS
-#define BS_STATE_BS_SP          2  // Got BS SP (halfwidth: expect BS)
-#define BS_STATE_BS_BS          3  // Got BS BS (fullwidth: expect SP)
-#define BS_STATE_BS_BS_SP       4  // Got BS BS SP (expect SP)
-#define BS_STATE_BS_BS_SP_SP    5  // Got BS BS SP SP (expect BS)
-#define BS_STATE_BS_BS_SP_SP_BS 6  // Got BS BS SP SP BS (expect BS)
-
-static unsigned char bs_state = BS_STATE_NORMAL;
-
-// CSI command dispatch
-static void ansi_dispatch(unsigned char final_byte)
-{
-	unsigned char p0 = (ansi_param_count > 0) ? ansi_params[0] : 0;
-	unsigned char p1 = (ansi_param_count > 1) ? ansi_params[1] : 0;
-	unsigned char n;
-
-	switch (final_byte) {
-	case 'A': // Cursor Up
-		n = (p0 > 0) ? p0 : 1;
-		if (jtxt_state.cursor_y >= jtxt_state.bitmap_top_row + n)
-			jtxt_state.cursor_y -= n;
-		else
-			jtxt_state.cursor_y = jtxt_state.bitmap_top_row;
-		jtxt_state.wrap_pending = false;
-		break;
-	case 'B': // Cursor Down
-		n = (p0 > 0) ? p0 : 1;
-		if (jtxt_state.cursor_y + n <= jtxt_state.bitmap_bottom_row)
-			jtxt_state.cursor_y += n;
-		else
-			jtxt_state.cursor_y = jtxt_state.bitmap_bottom_row;
-		jtxt_state.wrap_pending = false;
-		break;
-	case 'C': // Cursor Forward
-		n = (p0 > 0) ? p0 : 1;
-		jtxt_state.cursor_x += n;
-		if (jtxt_state.cursor_x > 39) jtxt_state.cursor_x = 39;
-		jtxt_state.wrap_pending = false;
-		break;
-	case 'D': // Cursor Back
-		n = (p0 > 0) ? p0 : 1;
-		if (jtxt_state.cursor_x >= n)
-			jtxt_state.cursor_x -= n;
-		else
-			jtxt_state.cursor_x = 0;
-		jtxt_state.wrap_pending = false;
-		break;
-	case 'H': // Cursor Position (row;col, 1-based)
-	case 'f':
-		{
-			unsigned char row = (p0 > 0) ? p0 - 1 : 0;
-			unsigned char col = (p1 > 0) ? p1 - 1 : 0;
-			row += jtxt_state.bitmap_top_row;
-			if (row > jtxt_state.bitmap_bottom_row)
-				row = jtxt_state.bitmap_bottom_row;
-			if (col > 39) col = 39;
-			jtxt_blocate(col, row);
-		}
-		break;
-	case 'J': // Erase in Display
-		if (p0 == 0 || ansi_param_count == 0) {
-			jtxt_bclear_to_eol();
-			for (unsigned char r = jtxt_state.cursor_y + 1;
-			     r <= jtxt_state.bitmap_bottom_row; r++) {
-				jtxt_bclear_line(r);
-			}
-		} else if (p0 == 2) {
-			jtxt_bcls();
-		}
-		break;
-	case 'K': // Erase in Line
-		if (p0 == 0 || ansi_param_count == 0) {
-			jtxt_bclear_to_eol();
-		} else if (p0 == 2) {
-			jtxt_bclear_line(jtxt_state.cursor_y);
-		}
-		break;
-	case 'm': // SGR
-		if (ansi_param_count == 0) {
-			jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
-		}
-		for (unsigned char i = 0; i < ansi_param_count; i++) {
-			unsigned char p = ansi_params[i];
-			if (p == 0) {
-				jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
-			} else if (p >= 30 && p <= 37) {
-				unsigned char bg = jtxt_state.bitmap_color & 0x0F;
-				jtxt_bcolor(ansi_to_c64_color[p - 30], bg);
-			} else if (p >= 40 && p <= 47) {
-				unsigned char fg = jtxt_state.bitmap_color >> 4;
-				jtxt_bcolor(fg, ansi_to_c64_color[p - 40]);
-			}
-		}
-		break;
-	}
-}
-
-// Process received data and display on terminal
-static void process_received(unsigned char socketid, int datacount)
-{
-	int i;
-	unsigned char c;
-	int result;
-
-	for (i = 0; i < datacount; i++) {
-		c = (unsigned char)c64u_data[i + 2];
-
-		result = telnet_process_byte(c);
-
-		if (result == TELNET_CONSUMED) {
-			continue;
-		}
-
-		if (result == TELNET_ESCAPED) {
-			// IAC IAC -> literal 0xFF, pass to jtxt as data
-			jtxt_bputc(0xFF);
-			continue;
-		}
-
-		// ANSI escape sequence handling
-		if (ansi_state == ANSI_STATE_ESC) {
-			if (c == 0x5B) {
-				// ESC [ -> CSI sequence
-				ansi_state = ANSI_STATE_CSI;
-				ansi_param_count = 0;
-				ansi_current_param = 0;
-				ansi_has_digit = false;
-			} else {
-				// ESC + something else, ignore and reset
-				ansi_state = ANSI_STATE_NORMAL;
-			}
-			continue;
-		}
-
-		if (ansi_state == ANSI_STATE_CSI) {
-			if (c >= '0' && c <= '9') {
-				ansi_current_param = ansi_current_param * 10 + (c - '0');
-				ansi_has_digit = true;
-			} else if (c == ';') {
-				if (ansi_param_count < ANSI_MAX_PARAMS) {
-					ansi_params[ansi_param_count++] =
-						(ansi_current_param > 255) ? 255 : (unsigned char)ansi_current_param;
-				}
-				ansi_current_param = 0;
-				ansi_has_digit = false;
-			} else if (c >= 0x40 && c <= 0x7E) {
-				if (ansi_has_digit && ansi_param_count < ANSI_MAX_PARAMS) {
-					ansi_params[ansi_param_count++] =
-						(ansi_current_param > 255) ? 255 : (unsigned char)ansi_current_param;
-				}
-				ansi_dispatch(c);
-				ansi_state = ANSI_STATE_NORMAL;
-			}
-			continue;
-		}
-
-		// BS erase pattern detection
-		if (bs_state != BS_STATE_NORMAL) {
-			switch (bs_state) {
-			case BS_STATE_BS1:
-				if (c == 0x20) { bs_state = BS_STATE_BS_SP; continue; }
-				if (c == 0x08) { bs_state = BS_STATE_BS_BS; continue; }
-				bs_state = BS_STATE_NORMAL;
-				break; // pattern broken, fall through to process c
-			case BS_STATE_BS_SP:
-				bs_state = BS_STATE_NORMAL;
-				if (c == 0x08) { jtxt_bbackspace(); continue; }
-				break; // pattern broken
-			case BS_STATE_BS_BS:
-				if (c == 0x20) { bs_state = BS_STATE_BS_BS_SP; continue; }
-				bs_state = BS_STATE_NORMAL;
-				break;
-			case BS_STATE_BS_BS_SP:
-				if (c == 0x20) { bs_state = BS_STATE_BS_BS_SP_SP; continue; }
-				bs_state = BS_STATE_NORMAL;
-				break;
-			case BS_STATE_BS_BS_SP_SP:
-				if (c == 0x08) { bs_state = BS_STATE_BS_BS_SP_SP_BS; continue; }
-				bs_state = BS_STATE_NORMAL;
-				break;
-			case BS_STATE_BS_BS_SP_SP_BS:
-				bs_state = BS_STATE_NORMAL;
-				if (c == 0x08) { jtxt_bbackspace(); continue; }
-				break;
-			}
-		}
-
-		// Normal character processing
-		if (c == 0x1B) {
-			// ESC
-			ansi_state = ANSI_STATE_ESC;
-			continue;
-		} else if (c == 0x0D) {
-			// CR - ignore (use LF for newline)
-			continue;
-		} else if (c == 0x0A) {
-			// LF - newline
-			jtxt_bnewline();
-		} else if (c == 0x08) {
-			// BS - start pattern detection (don't erase yet)
-			bs_state = BS_STATE_BS1;
-		} else if (c >= 0x20) {
-			// Printable ASCII + high bytes (Shift-JIS, half-width kana, etc.)
-			// jtxt_bputc handles Shift-JIS multi-byte internally
-			jtxt_bputc(c);
-		}
-		// Control characters (0x00-0x1F except above) are ignored
-	}
-}
-
 //=============================================================================
 // Terminal session
 //=============================================================================
@@ -781,8 +553,11 @@ static int terminal_session(void)
 	ccopy(1, (char *)0x2300, (char *)0x8000, 0x2000);
 #endif
 	ime_init();
-	ansi_state = ANSI_STATE_NORMAL;
-	bs_state = BS_STATE_NORMAL;
+	ime_set_lookup_budget(IME_LOOKUPS_PER_POLL);
+#ifndef JTXT_CRT
+	ime_mru_load(disk_dev, IME_MRU_FILE);
+#endif
+	term_recv_init();
 
 	// Main terminal loop
 	while (1) {
@@ -800,7 +575,7 @@ static int terminal_session(void)
 		}
 
 		if (datacount > 0) {
-			process_received(socketid, datacount);
+			term_recv_process(&c64u_data[2], datacount);
 		}
 		// datacount == -1 means no data available (wait state)
 
@@ -813,10 +588,7 @@ static int terminal_session(void)
 				const unsigned char *text = ime_get_result_text();
 				unsigned char len = ime_get_result_length();
 				if (text && len > 0) {
-					unsigned char i;
-					for (i = 0; i < len; i++) {
-						c64u_socketwritechar(socketid, (char)text[i]);
-					}
+					c64u_socketqueue(socketid, (const char *)text, len);
 				}
 				ime_clear_output();
 			} else if (ime_event == IME_EVENT_KEY_PASSTHROUGH) {
@@ -833,14 +605,16 @@ static int terminal_session(void)
 				if (key != 0) {
 					if (key == PETSCII_F3) {
 						// F3: XMODEM transfer menu
+						c64u_socketflush();
 #ifdef JTXT_MAGICDESK_CRT
 						ccopy(37, (char *)0x2300, (char *)0x8000, 0x2000);
 #endif
 						xmodem_menu(socketid);
 #ifdef JTXT_MAGICDESK_CRT
-						// Reload IME overlay
+						// Reload IME overlay; the conversion cache in BSS survives
 						ccopy(1, (char *)0x2300, (char *)0x8000, 0x2000);
-						ime_init();
+						ime_reset();
+						ime_set_lookup_budget(IME_LOOKUPS_PER_POLL);
 #endif
 						continue;
 					} else if (key == 0x0D) {
@@ -855,14 +629,22 @@ static int terminal_session(void)
 					}
 				}
 			}
-			// Other events (MODE_CHANGED, CANCELLED, DEACTIVATED): ignore
+			// Other events (MODE_CHANGED, CANCELLED, DEACTIVATED, BUSY,
+			// CANDIDATES_READY): ignore
 		}
+
+		// Send what this pass queued (typed keys, IME text, telnet
+		// replies) in one write command
+		c64u_socketflush();
 	}
 
 	// Deactivate IME if active
 	if (ime_is_active()) {
 		ime_deactivate();
 	}
+#ifndef JTXT_CRT
+	ime_mru_save(disk_dev, IME_MRU_FILE);
+#endif
 
 	// Disconnect
 	c64u_socketclose(socketid);
@@ -1145,13 +927,13 @@ __export const unsigned char font_gothic_4[] = {
 
 #pragma data( data )
 
-//--- Banks 6-18: SKK Dictionary (210,789 bytes in 13 banks) ---
+//--- Banks 6-18: SKK Dictionary (version 3, 199,666 bytes in 13 banks) ---
 
 #pragma section( dic6, 0 )
 #pragma region(dict6, 0x8000, 0xc000, , 6, { dic6 })
 #pragma data( dic6 )
 __export const unsigned char dict_0[] = {
-    #embed 16384 0 "../../../dicconv/skkdic.bin"
+    #embed 16384 0 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1159,7 +941,7 @@ __export const unsigned char dict_0[] = {
 #pragma region(dict7, 0x8000, 0xc000, , 7, { dic7 })
 #pragma data( dic7 )
 __export const unsigned char dict_1[] = {
-    #embed 16384 16384 "../../../dicconv/skkdic.bin"
+    #embed 16384 16384 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1167,7 +949,7 @@ __export const unsigned char dict_1[] = {
 #pragma region(dict8, 0x8000, 0xc000, , 8, { dic8 })
 #pragma data( dic8 )
 __export const unsigned char dict_2[] = {
-    #embed 16384 32768 "../../../dicconv/skkdic.bin"
+    #embed 16384 32768 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1175,7 +957,7 @@ __export const unsigned char dict_2[] = {
 #pragma region(dict9, 0x8000, 0xc000, , 9, { dic9 })
 #pragma data( dic9 )
 __export const unsigned char dict_3[] = {
-    #embed 16384 49152 "../../../dicconv/skkdic.bin"
+    #embed 16384 49152 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1183,7 +965,7 @@ __export const unsigned char dict_3[] = {
 #pragma region(dict10, 0x8000, 0xc000, , 10, { dic10 })
 #pragma data( dic10 )
 __export const unsigned char dict_4[] = {
-    #embed 16384 65536 "../../../dicconv/skkdic.bin"
+    #embed 16384 65536 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1191,7 +973,7 @@ __export const unsigned char dict_4[] = {
 #pragma region(dict11, 0x8000, 0xc000, , 11, { dic11 })
 #pragma data( dic11 )
 __export const unsigned char dict_5[] = {
-    #embed 16384 81920 "../../../dicconv/skkdic.bin"
+    #embed 16384 81920 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1199,7 +981,7 @@ __export const unsigned char dict_5[] = {
 #pragma region(dict12, 0x8000, 0xc000, , 12, { dic12 })
 #pragma data( dic12 )
 __export const unsigned char dict_6[] = {
-    #embed 16384 98304 "../../../dicconv/skkdic.bin"
+    #embed 16384 98304 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1207,7 +989,7 @@ __export const unsigned char dict_6[] = {
 #pragma region(dict13, 0x8000, 0xc000, , 13, { dic13 })
 #pragma data( dic13 )
 __export const unsigned char dict_7[] = {
-    #embed 16384 114688 "../../../dicconv/skkdic.bin"
+    #embed 16384 114688 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1215,7 +997,7 @@ __export const unsigned char dict_7[] = {
 #pragma region(dict14, 0x8000, 0xc000, , 14, { dic14 })
 #pragma data( dic14 )
 __export const unsigned char dict_8[] = {
-    #embed 16384 131072 "../../../dicconv/skkdic.bin"
+    #embed 16384 131072 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1223,7 +1005,7 @@ __export const unsigned char dict_8[] = {
 #pragma region(dict15, 0x8000, 0xc000, , 15, { dic15 })
 #pragma data( dic15 )
 __export const unsigned char dict_9[] = {
-    #embed 16384 147456 "../../../dicconv/skkdic.bin"
+    #embed 16384 147456 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1231,7 +1013,7 @@ __export const unsigned char dict_9[] = {
 #pragma region(dict16, 0x8000, 0xc000, , 16, { dic16 })
 #pragma data( dic16 )
 __export const unsigned char dict_10[] = {
-    #embed 16384 163840 "../../../dicconv/skkdic.bin"
+    #embed 16384 163840 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1239,7 +1021,7 @@ __export const unsigned char dict_10[] = {
 #pragma region(dict17, 0x8000, 0xc000, , 17, { dic17 })
 #pragma data( dic17 )
 __export const unsigned char dict_11[] = {
-    #embed 16384 180224 "../../../dicconv/skkdic.bin"
+    #embed 16384 180224 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1247,7 +1029,7 @@ __export const unsigned char dict_11[] = {
 #pragma region(dict18, 0x8000, 0xc000, , 18, { dic18 })
 #pragma data( dic18 )
 __export const unsigned char dict_12[] = {
-    #embed 14181 196608 "../../../dicconv/skkdic.bin"
+    #embed 3058 196608 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1343,13 +1125,13 @@ __export const unsigned char md_font_gothic_8[] = {
 };
 #pragma data( data )
 
-//--- Banks 11-36: SKK Dictionary (210,789 bytes in 26 x 8KB banks) ---
+//--- Banks 11-35: SKK Dictionary (version 3, 199,666 bytes in 25 x 8KB banks) ---
 
 #pragma section( mddic11, 0 )
 #pragma region( mddict11, 0x8000, 0xA000, , 11, { mddic11 })
 #pragma data( mddic11 )
 __export const unsigned char md_dict_0[] = {
-    #embed 8192 0 "../../../dicconv/skkdic.bin"
+    #embed 8192 0 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1357,7 +1139,7 @@ __export const unsigned char md_dict_0[] = {
 #pragma region( mddict12, 0x8000, 0xA000, , 12, { mddic12 })
 #pragma data( mddic12 )
 __export const unsigned char md_dict_1[] = {
-    #embed 8192 8192 "../../../dicconv/skkdic.bin"
+    #embed 8192 8192 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1365,7 +1147,7 @@ __export const unsigned char md_dict_1[] = {
 #pragma region( mddict13, 0x8000, 0xA000, , 13, { mddic13 })
 #pragma data( mddic13 )
 __export const unsigned char md_dict_2[] = {
-    #embed 8192 16384 "../../../dicconv/skkdic.bin"
+    #embed 8192 16384 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1373,7 +1155,7 @@ __export const unsigned char md_dict_2[] = {
 #pragma region( mddict14, 0x8000, 0xA000, , 14, { mddic14 })
 #pragma data( mddic14 )
 __export const unsigned char md_dict_3[] = {
-    #embed 8192 24576 "../../../dicconv/skkdic.bin"
+    #embed 8192 24576 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1381,7 +1163,7 @@ __export const unsigned char md_dict_3[] = {
 #pragma region( mddict15, 0x8000, 0xA000, , 15, { mddic15 })
 #pragma data( mddic15 )
 __export const unsigned char md_dict_4[] = {
-    #embed 8192 32768 "../../../dicconv/skkdic.bin"
+    #embed 8192 32768 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1389,7 +1171,7 @@ __export const unsigned char md_dict_4[] = {
 #pragma region( mddict16, 0x8000, 0xA000, , 16, { mddic16 })
 #pragma data( mddic16 )
 __export const unsigned char md_dict_5[] = {
-    #embed 8192 40960 "../../../dicconv/skkdic.bin"
+    #embed 8192 40960 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1397,7 +1179,7 @@ __export const unsigned char md_dict_5[] = {
 #pragma region( mddict17, 0x8000, 0xA000, , 17, { mddic17 })
 #pragma data( mddic17 )
 __export const unsigned char md_dict_6[] = {
-    #embed 8192 49152 "../../../dicconv/skkdic.bin"
+    #embed 8192 49152 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1405,7 +1187,7 @@ __export const unsigned char md_dict_6[] = {
 #pragma region( mddict18, 0x8000, 0xA000, , 18, { mddic18 })
 #pragma data( mddic18 )
 __export const unsigned char md_dict_7[] = {
-    #embed 8192 57344 "../../../dicconv/skkdic.bin"
+    #embed 8192 57344 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1413,7 +1195,7 @@ __export const unsigned char md_dict_7[] = {
 #pragma region( mddict19, 0x8000, 0xA000, , 19, { mddic19 })
 #pragma data( mddic19 )
 __export const unsigned char md_dict_8[] = {
-    #embed 8192 65536 "../../../dicconv/skkdic.bin"
+    #embed 8192 65536 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1421,7 +1203,7 @@ __export const unsigned char md_dict_8[] = {
 #pragma region( mddict20, 0x8000, 0xA000, , 20, { mddic20 })
 #pragma data( mddic20 )
 __export const unsigned char md_dict_9[] = {
-    #embed 8192 73728 "../../../dicconv/skkdic.bin"
+    #embed 8192 73728 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1429,7 +1211,7 @@ __export const unsigned char md_dict_9[] = {
 #pragma region( mddict21, 0x8000, 0xA000, , 21, { mddic21 })
 #pragma data( mddic21 )
 __export const unsigned char md_dict_10[] = {
-    #embed 8192 81920 "../../../dicconv/skkdic.bin"
+    #embed 8192 81920 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1437,7 +1219,7 @@ __export const unsigned char md_dict_10[] = {
 #pragma region( mddict22, 0x8000, 0xA000, , 22, { mddic22 })
 #pragma data( mddic22 )
 __export const unsigned char md_dict_11[] = {
-    #embed 8192 90112 "../../../dicconv/skkdic.bin"
+    #embed 8192 90112 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1445,7 +1227,7 @@ __export const unsigned char md_dict_11[] = {
 #pragma region( mddict23, 0x8000, 0xA000, , 23, { mddic23 })
 #pragma data( mddic23 )
 __export const unsigned char md_dict_12[] = {
-    #embed 8192 98304 "../../../dicconv/skkdic.bin"
+    #embed 8192 98304 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1453,7 +1235,7 @@ __export const unsigned char md_dict_12[] = {
 #pragma region( mddict24, 0x8000, 0xA000, , 24, { mddic24 })
 #pragma data( mddic24 )
 __export const unsigned char md_dict_13[] = {
-    #embed 8192 106496 "../../../dicconv/skkdic.bin"
+    #embed 8192 106496 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1461,7 +1243,7 @@ __export const unsigned char md_dict_13[] = {
 #pragma region( mddict25, 0x8000, 0xA000, , 25, { mddic25 })
 #pragma data( mddic25 )
 __export const unsigned char md_dict_14[] = {
-    #embed 8192 114688 "../../../dicconv/skkdic.bin"
+    #embed 8192 114688 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1469,7 +1251,7 @@ __export const unsigned char md_dict_14[] = {
 #pragma region( mddict26, 0x8000, 0xA000, , 26, { mddic26 })
 #pragma data( mddic26 )
 __export const unsigned char md_dict_15[] = {
-    #embed 8192 122880 "../../../dicconv/skkdic.bin"
+    #embed 8192 122880 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1477,7 +1259,7 @@ __export const unsigned char md_dict_15[] = {
 #pragma region( mddict27, 0x8000, 0xA000, , 27, { mddic27 })
 #pragma data( mddic27 )
 __export const unsigned char md_dict_16[] = {
-    #embed 8192 131072 "../../../dicconv/skkdic.bin"
+    #embed 8192 131072 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1485,7 +1267,7 @@ __export const unsigned char md_dict_16[] = {
 #pragma region( mddict28, 0x8000, 0xA000, , 28, { mddic28 })
 #pragma data( mddic28 )
 __export const unsigned char md_dict_17[] = {
-    #embed 8192 139264 "../../../dicconv/skkdic.bin"
+    #embed 8192 139264 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1493,7 +1275,7 @@ __export const unsigned char md_dict_17[] = {
 #pragma region( mddict29, 0x8000, 0xA000, , 29, { mddic29 })
 #pragma data( mddic29 )
 __export const unsigned char md_dict_18[] = {
-    #embed 8192 147456 "../../../dicconv/skkdic.bin"
+    #embed 8192 147456 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1501,7 +1283,7 @@ __export const unsigned char md_dict_18[] = {
 #pragma region( mddict30, 0x8000, 0xA000, , 30, { mddic30 })
 #pragma data( mddic30 )
 __export const unsigned char md_dict_19[] = {
-    #embed 8192 155648 "../../../dicconv/skkdic.bin"
+    #embed 8192 155648 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1509,7 +1291,7 @@ __export const unsigned char md_dict_19[] = {
 #pragma region( mddict31, 0x8000, 0xA000, , 31, { mddic31 })
 #pragma data( mddic31 )
 __export const unsigned char md_dict_20[] = {
-    #embed 8192 163840 "../../../dicconv/skkdic.bin"
+    #embed 8192 163840 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1517,7 +1299,7 @@ __export const unsigned char md_dict_20[] = {
 #pragma region( mddict32, 0x8000, 0xA000, , 32, { mddic32 })
 #pragma data( mddic32 )
 __export const unsigned char md_dict_21[] = {
-    #embed 8192 172032 "../../../dicconv/skkdic.bin"
+    #embed 8192 172032 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1525,7 +1307,7 @@ __export const unsigned char md_dict_21[] = {
 #pragma region( mddict33, 0x8000, 0xA000, , 33, { mddic33 })
 #pragma data( mddic33 )
 __export const unsigned char md_dict_22[] = {
-    #embed 8192 180224 "../../../dicconv/skkdic.bin"
+    #embed 8192 180224 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1533,7 +1315,7 @@ __export const unsigned char md_dict_22[] = {
 #pragma region( mddict34, 0x8000, 0xA000, , 34, { mddic34 })
 #pragma data( mddic34 )
 __export const unsigned char md_dict_23[] = {
-    #embed 8192 188416 "../../../dicconv/skkdic.bin"
+    #embed 8192 188416 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -1541,15 +1323,7 @@ __export const unsigned char md_dict_23[] = {
 #pragma region( mddict35, 0x8000, 0xA000, , 35, { mddic35 })
 #pragma data( mddic35 )
 __export const unsigned char md_dict_24[] = {
-    #embed 8192 196608 "../../../dicconv/skkdic.bin"
-};
-#pragma data( data )
-
-#pragma section( mddic36, 0 )
-#pragma region( mddict36, 0x8000, 0xA000, , 36, { mddic36 })
-#pragma data( mddic36 )
-__export const unsigned char md_dict_25[] = {
-    #embed 5989 204800 "../../../dicconv/skkdic.bin"
+    #embed 3058 196608 "../term_skkdic.bin"
 };
 #pragma data( data )
 
@@ -0,0 +1,275 @@
+/*
+ * Received data handling for C64 Japanese Terminal
+ *
+ * Runs the bytes read from the socket through the Telnet filter, the ANSI
+ * escape sequence parser and the BS erase pattern detection, and draws
+ * everything else with jtxt in bitmap mode.
+ */
+
+#include "c64_oscar.h"
+#include "jtxt.h"
+#include "telnet.h"
+#include "term_recv.h"
+
+#ifdef JTXT_MAGICDESK_CRT
+#pragma code(mcode)
+#pragma data(mdata)
+#endif
+
+//=============================================================================
+// ANSI escape sequence parser
+//=============================================================================
+
+#define ANSI_STATE_NORMAL 0
+#define ANSI_STATE_ESC    1  // Got ESC
+#define ANSI_STATE_CSI    2  // Got ESC [
+
+static unsigned char ansi_state = ANSI_STATE_NORMAL;
+
+// CSI parameter buffer
+#define ANSI_MAX_PARAMS 4
+static unsigned char ansi_params[ANSI_MAX_PARAMS];
+static unsigned char ansi_param_count;
+static unsigned int ansi_current_param;
+static bool ansi_has_digit;
+
+// ANSI 8-color -> C64 color mapping
+static const unsigned char ansi_to_c64_color[8] = {
+	COLOR_BLACK, COLOR_RED, COLOR_GREEN, COLOR_YELLOW,
+	COLOR_BLUE, COLOR_PURPLE, COLOR_CYAN, COLOR_WHITE
+};
+
+// BS erase pattern detection state machine
+// Halfwidth erase: BS SP BS         -> jtxt_bbackspace() once
+// Fullwidth erase: BS BS SP SP BS BS -> jtxt_bbackspace() once
+// Other patterns are discarded
+#define BS_STATE_NORMAL         0
+#define BS_STATE_BS1            1  // Got BS
+#define BS_STATE_BS_SP          2  // Got BS SP (halfwidth: expect BS)
+#define BS_STATE_BS_BS          3  // Got BS BS (fullwidth: expect SP)
+#define BS_STATE_BS_BS_SP       4  // Got BS BS SP (expect SP)
+#define BS_STATE_BS_BS_SP_SP    5  // Got BS BS SP SP (expect BS)
+#define BS_STATE_BS_BS_SP_SP_BS 6  // Got BS BS SP SP BS (expect BS)
+
+static unsigned char bs_state = BS_STATE_NORMAL;
+
+// CSI command dispatch
+static void ansi_dispatch(unsigned char final_byte)
+{
+	unsigned char p0 = (ansi_param_count > 0) ? ansi_params[0] : 0;
+	unsigned char p1 = (ansi_param_count > 1) ? ansi_params[1] : 0;
+	unsigned char n;
+
+	switch (final_byte) {
+	case 'A': // Cursor Up
+		n = (p0 > 0) ? p0 : 1;
+		if (jtxt_state.cursor_y >= jtxt_state.bitmap_top_row + n)
+			jtxt_state.cursor_y -= n;
+		else
+			jtxt_state.cursor_y = jtxt_state.bitmap_top_row;
+		jtxt_state.wrap_pending = false;
+		break;
+	case 'B': // Cursor Down
+		n = (p0 > 0) ? p0 : 1;
+		if (jtxt_state.cursor_y + n <= jtxt_state.bitmap_bottom_row)
+			jtxt_state.cursor_y += n;
+		else
+			jtxt_state.cursor_y = jtxt_state.bitmap_bottom_row;
+		jtxt_state.wrap_pending = false;
+		break;
+	case 'C': // Cursor Forward
+		n = (p0 > 0) ? p0 : 1;
+		jtxt_state.cursor_x += n;
+		if (jtxt_state.cursor_x > 39) jtxt_state.cursor_x = 39;
+		jtxt_state.wrap_pending = false;
+		break;
+	case 'D': // Cursor Back
+		n = (p0 > 0) ? p0 : 1;
+		if (jtxt_state.cursor_x >= n)
+			jtxt_state.cursor_x -= n;
+		else
+			jtxt_state.cursor_x = 0;
+		jtxt_state.wrap_pending = false;
+		break;
+	case 'H': // Cursor Position (row;col, 1-based)
+	case 'f':
+		{
+			unsigned char row = (p0 > 0) ? p0 - 1 : 0;
+			unsigned char col = (p1 > 0) ? p1 - 1 : 0;
+			row += jtxt_state.bitmap_top_row;
+			if (row > jtxt_state.bitmap_bottom_row)
+				row = jtxt_state.bitmap_bottom_row;
+			if (col > 39) col = 39;
+			jtxt_blocate(col, row);
+		}
+		break;
+	case 'J': // Erase in Display
+		if (p0 == 0 || ansi_param_count == 0) {
+			jtxt_bclear_to_eol();
+			for (unsigned char r = jtxt_state.cursor_y + 1;
+			     r <= jtxt_state.bitmap_bottom_row; r++) {
+				jtxt_bclear_line(r);
+			}
+		} else if (p0 == 2) {
+			jtxt_bcls();
+		}
+		break;
+	case 'K': // Erase in Line
+		if (p0 == 0 || ansi_param_count == 0) {
+			jtxt_bclear_to_eol();
+		} else if (p0 == 2) {
+			jtxt_bclear_line(jtxt_state.cursor_y);
+		}
+		break;
+	case 'm': // SGR
+		if (ansi_param_count == 0) {
+			jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+		}
+		for (unsigned char i = 0; i < ansi_param_count; i++) {
+			unsigned char p = ansi_params[i];
+			if (p == 0) {
+				jtxt_bcolor(COLOR_WHITE, COLOR_BLACK);
+			} else if (p >= 30 && p <= 37) {
+				unsigned char bg = jtxt_state.bitmap_color & 0x0F;
+				jtxt_bcolor(ansi_to_c64_color[p - 30], bg);
+			} else if (p >= 40 && p <= 47) {
+				unsigned char fg = jtxt_state.bitmap_color >> 4;
+				jtxt_bcolor(fg, ansi_to_c64_color[p - 40]);
+			}
+		}
+		break;
+	}
+}
+
+void term_recv_init(void)
+{
+	ansi_state = ANSI_STATE_NORMAL;
+	bs_state = BS_STATE_NORMAL;
+}
+
+void term_recv_process(const char *data, int count)
+{
+	int i;
+	unsigned char c;
+	int result;
+
+	for (i = 0; i < count; i++) {
+		c = (unsigned char)data[i];
+
+		// Plain run (no IAC, ESC, BS, CR or LF, no sequence in progress):
+		// draw it in one jtxt_bputn call instead of byte by byte
+		if (c >= 0x20 && c != NVT_IAC && telnet.iac_state == IAC_STATE_NORMAL &&
+		    ansi_state == ANSI_STATE_NORMAL && bs_state == BS_STATE_NORMAL) {
+			int j = i + 1;
+			while (j < count) {
+				unsigned char d = (unsigned char)data[j];
+				if (d < 0x20 || d == NVT_IAC) break;
+				j++;
+			}
+			jtxt_bputn(&data[i], (uint16_t)(j - i));
+			i = j - 1;
+			continue;
+		}
+
+		result = telnet_process_byte(c);
+
+		if (result == TELNET_CONSUMED) {
+			continue;
+		}
+
+		if (result == TELNET_ESCAPED) {
+			// IAC IAC -> literal 0xFF, pass to jtxt as data
+			jtxt_bputc(0xFF);
+			continue;
+		}
+
+		// ANSI escape sequence handling
+		if (ansi_state == ANSI_STATE_ESC) {
+			if (c == 0x5B) {
+				// ESC [ -> CSI sequence
+				ansi_state = ANSI_STATE_CSI;
+				ansi_param_count = 0;
+				ansi_current_param = 0;
+				ansi_has_digit = false;
+			} else {
+				// ESC + something else, ignore and reset
+				ansi_state = ANSI_STATE_NORMAL;
+			}
+			continue;
+		}
+
+		if (ansi_state == ANSI_STATE_CSI) {
+			if (c >= '0' && c <= '9') {
+				ansi_current_param = ansi_current_param * 10 + (c - '0');
+				ansi_has_digit = true;
+			} else if (c == ';') {
+				if (ansi_param_count < ANSI_MAX_PARAMS) {
+					ansi_params[ansi_param_count++] =
+						(ansi_current_param > 255) ? 255 : (unsigned char)ansi_current_param;
+				}
+				ansi_current_param = 0;
+				ansi_has_digit = false;
+			} else if (c >= 0x40 && c <= 0x7E) {
+				if (ansi_has_digit && ansi_param_count < ANSI_MAX_PARAMS) {
+					ansi_params[ansi_param_count++] =
+						(ansi_current_param > 255) ? 255 : (unsigned char)ansi_current_param;
+				}
+				ansi_dispatch(c);
+				ansi_state = ANSI_STATE_NORMAL;
+			}
+			continue;
+		}
+
+		// BS erase pattern detection
+		if (bs_state != BS_STATE_NORMAL) {
+			switch (bs_state) {
+			case BS_STATE_BS1:
+				if (c == 0x20) { bs_state = BS_STATE_BS_SP; continue; }
+				if (c == 0x08) { bs_state = BS_STATE_BS_BS; continue; }
+				bs_state = BS_STATE_NORMAL;
+				break; // pattern broken, fall through to process c
+			case BS_STATE_BS_SP:
+				bs_state = BS_STATE_NORMAL;
+				if (c == 0x08) { jtxt_bbackspace(); continue; }
+				break; // pattern broken
+			case BS_STATE_BS_BS:
+				if (c == 0x20) { bs_state = BS_STATE_BS_BS_SP; continue; }
+				bs_state = BS_STATE_NORMAL;
+				break;
+			case BS_STATE_BS_BS_SP:
+				if (c == 0x20) { bs_state = BS_STATE_BS_BS_SP_SP; continue; }
+				bs_state = BS_STATE_NORMAL;
+				break;
+			case BS_STATE_BS_BS_SP_SP:
+				if (c == 0x08) { bs_state = BS_STATE_BS_BS_SP_SP_BS; continue; }
+				bs_state = BS_STATE_NORMAL;
+				break;
+			case BS_STATE_BS_BS_SP_SP_BS:
+				bs_state = BS_STATE_NORMAL;
+				if (c == 0x08) { jtxt_bbackspace(); continue; }
+				break;
+			}
+		}
+
+		// Normal character processing
+		if (c == 0x1B) {
+			// ESC
+			ansi_state = ANSI_STATE_ESC;
+			continue;
+		} else if (c == 0x0D) {
+			// CR - ignore (use LF for newline)
+			continue;
+		} else if (c == 0x0A) {
+			// LF - newline
+			jtxt_bnewline();
+		} else if (c == 0x08) {
+			// BS - start pattern detection (don't erase yet)
+			bs_state = BS_STATE_BS1;
+		} else if (c >= 0x20) {
+			// Printable ASCII + high bytes (Shift-JIS, half-width kana, etc.)
+			// jtxt_bputc handles Shift-JIS multi-byte internally
+			jtxt_bputc(c);
+		}
+		// Control characters (0x00-0x1F except above) are ignored
+	}
+}
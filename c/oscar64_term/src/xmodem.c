@@ -649,33 +649,8 @@ static int xmodem_download(unsigned char socketid)
 	return 1;
 }
 
-// ============================================================
-// Binary socket write (sends exact bytes, no strlen)
-// Builds UII+ SOCKET_WRITE command directly.
-// ============================================================
-
-// NET_CMD_SOCKET_WRITE (0x11) is defined in c64u_network.h
-
-static unsigned char xm_write_buf[3 + SECSIZE + 5]; // header(3) + SOH+blk+~blk+data+CRC(max 133)
-
-static void socket_write_binary(unsigned char socketid, const unsigned char *data, unsigned char len)
-{
-	unsigned char x;
-
-	xm_write_buf[0] = 0x00;
-	xm_write_buf[1] = NET_CMD_SOCKET_WRITE;
-	xm_write_buf[2] = socketid;
-
-	for (x = 0; x < len; x++)
-		xm_write_buf[x + 3] = data[x];
-
-	c64u_settarget(TARGET_NETWORK);
-	c64u_sendcommand(xm_write_buf, 3 + len);
-
-	c64u_readdata();
-	c64u_readstatus();
-	c64u_accept();
-}
+// XMODEM block: SOH + blk + ~blk + data + CRC (max 133 bytes)
+static unsigned char xm_block[3 + SECSIZE + 2];
 
 // ============================================================
 // CRC-16 for XMODEM-CRC (polynomial 0x1021)
@@ -801,32 +776,32 @@ static int xmodem_upload(unsigned char socketid)
 				sector[i] = 0x1A;
 		}
 
-		// Build XMODEM block in xm_write_buf (static) and send
+		// Build XMODEM block in xm_block (static) and send
 		for (;;) {
 			{
 				unsigned char pktlen;
 
-				xm_write_buf[0] = SOH;
-				xm_write_buf[1] = blocknumber;
-				xm_write_buf[2] = ~blocknumber;
+				xm_block[0] = SOH;
+				xm_block[1] = blocknumber;
+				xm_block[2] = ~blocknumber;
 
 				for (i = 0; i < SECSIZE; i++)
-					xm_write_buf[3 + i] = sector[i];
+					xm_block[3 + i] = sector[i];
 
 				if (use_crc) {
 					crc = crc16_xmodem(sector, SECSIZE);
-					xm_write_buf[3 + SECSIZE] = (unsigned char)(crc >> 8);
-					xm_write_buf[3 + SECSIZE + 1] = (unsigned char)(crc & 0xFF);
+					xm_block[3 + SECSIZE] = (unsigned char)(crc >> 8);
+					xm_block[3 + SECSIZE + 1] = (unsigned char)(crc & 0xFF);
 					pktlen = 3 + SECSIZE + 2; // 133
 				} else {
 					checksum = 0;
 					for (i = 0; i < SECSIZE; i++)
 						checksum += sector[i];
-					xm_write_buf[3 + SECSIZE] = checksum;
+					xm_block[3 + SECSIZE] = checksum;
 					pktlen = 3 + SECSIZE + 1; // 132
 				}
 
-				socket_write_binary(socketid, xm_write_buf, pktlen);
+				c64u_socketwrite_len(socketid, (const char *)xm_block, pktlen);
 			}
 
 			// Wait for ACK/NAK
@@ -42,6 +42,18 @@
 
 #define HIRAGANA_BUFFER_LIMIT (HIRAGANA_BUFFER_SIZE - 2)
 
+// Dictionary header (see dicconv/dicconv.py)
+#define DIC_NOUN_TABLE        4U
+#define DIC_VERB_TABLE        250U
+#define DIC_NOUN_INDEX_TABLE  496U
+#define DIC_VERB_INDEX_TABLE  742U
+#define DIC_SLOT_OTHER        83
+#define DIC_SLOT_SHORT        84
+#define DIC_DIRECTORY_END     0xFF
+#define DIC_SORTED_RUN_MIN    8     // Shorter runs are scanned linearly
+#define DIC_VERSION_MASK      0x7F  // Bit 7: bank-aligned entries
+#define DIC_VERSION_MAX       2     // Version 3 (compressed) is Oscar64 only
+
 #define PEEK(addr) (*(volatile uint8_t*)(addr))
 #define POKE(addr, val) (PEEK(addr) = (uint8_t)(val))
 
@@ -149,6 +161,7 @@ static uint8_t current_entry_length = 0;
 
 static uint8_t current_bank = IME_DICTIONARY_START_BANK;
 static uint16_t current_offset = 0;
+static uint8_t dic_version = 0;
 
 static uint8_t verb_match_length = 0;
 static uint8_t verb_match_bank = 0;
@@ -219,11 +232,22 @@ static void jtxt_bput_number(uint8_t value);
 static uint8_t read_rom_byte(uint8_t bank, uint16_t offset);
 static uint8_t read_dic_byte(void);
 static uint8_t read_dic_string(uint8_t* buffer);
+static void dic_skip(uint16_t size);
+static bool dic_read_address(uint8_t* bank, uint16_t* offset);
 static uint8_t hiragana_to_index(uint8_t first_byte, uint8_t second_byte);
 static bool check_okurigana_match(const uint8_t* okurigana_buffer, uint8_t verb_suffix);
 static bool search_noun_entries(const uint8_t* key_buffer, uint8_t key_length);
 static bool search_verb_entries(const uint8_t* key_buffer, uint8_t key_length);
 static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search);
+static bool search_indexed_entries(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search, uint8_t index);
+static bool search_run_list(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search);
+static bool search_run(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                       uint8_t key_bytes, uint8_t count);
+static bool search_run_sorted(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                              uint8_t key_bytes, uint8_t count);
+static int8_t compare_run_entry(uint8_t table_bank, uint16_t table_offset, uint8_t index,
+                                const uint8_t* key_buffer, uint8_t stem_length);
+static void record_match(const uint8_t* key_buffer, uint8_t key_length, uint8_t entry_key_length, bool is_verb_search);
 static void add_candidates(uint16_t okurigana);
 static bool start_conversion(void);
 static void next_candidate(void);
@@ -1671,6 +1695,23 @@ static uint8_t read_dic_byte(void) {
     return data;
 }
 
+static void dic_skip(uint16_t size) {
+    uint16_t offset = current_offset + size;
+    current_bank = (uint8_t)(current_bank + offset / 8192U);
+    current_offset = offset % 8192U;
+}
+
+// Read an L M H dictionary address; false if it is zero
+static bool dic_read_address(uint8_t* bank, uint16_t* offset) {
+    uint8_t offset_low = read_dic_byte();
+    uint8_t offset_high = read_dic_byte();
+    uint8_t offset_bank = read_dic_byte();
+
+    *bank = (uint8_t)(IME_DICTIONARY_START_BANK + offset_bank);
+    *offset = mkword(offset_high, offset_low);
+    return offset_low != 0 || offset_high != 0 || offset_bank != 0;
+}
+
 static uint8_t read_dic_string(uint8_t* buffer) {
     uint8_t length = 0;
     while (length < 63) {
@@ -1751,9 +1792,6 @@ static bool check_okurigana_match(const uint8_t* okurigana_buffer, uint8_t verb_
 }
 static bool search_noun_entries(const uint8_t* key_buffer, uint8_t key_length) {
     uint8_t index;
-    uint8_t offset_low;
-    uint8_t offset_high;
-    uint8_t offset_bank;
 
     if (key_length < 2) {
         return false;
@@ -1764,27 +1802,22 @@ static bool search_noun_entries(const uint8_t* key_buffer, uint8_t key_length) {
         return false;
     }
 
-    current_bank = IME_DICTIONARY_START_BANK;
-    current_offset = (uint16_t)(4 + (uint16_t)index * 3U);
+    if (dic_version != 0) {
+        return search_indexed_entries(key_buffer, key_length, false, index);
+    }
 
-    offset_low = read_dic_byte();
-    offset_high = read_dic_byte();
-    offset_bank = read_dic_byte();
+    current_bank = IME_DICTIONARY_START_BANK;
+    current_offset = (uint16_t)(DIC_NOUN_TABLE + (uint16_t)index * 3U);
 
-    if (offset_low == 0 && offset_high == 0 && offset_bank == 0) {
+    if (!dic_read_address(&current_bank, &current_offset)) {
         return false;
     }
 
-    current_bank = (uint8_t)(IME_DICTIONARY_START_BANK + offset_bank);
-    current_offset = mkword(offset_high, offset_low);
     return search_entries_in_group(key_buffer, key_length, false);
 }
 
 static bool search_verb_entries(const uint8_t* key_buffer, uint8_t key_length) {
     uint8_t index;
-    uint8_t offset_low;
-    uint8_t offset_high;
-    uint8_t offset_bank;
 
     if (key_length < 2) {
         return false;
@@ -1795,19 +1828,17 @@ static bool search_verb_entries(const uint8_t* key_buffer, uint8_t key_length) {
         return false;
     }
 
-    current_bank = IME_DICTIONARY_START_BANK;
-    current_offset = (uint16_t)(250 + (uint16_t)index * 3U);
+    if (dic_version != 0) {
+        return search_indexed_entries(key_buffer, key_length, true, index);
+    }
 
-    offset_low = read_dic_byte();
-    offset_high = read_dic_byte();
-    offset_bank = read_dic_byte();
+    current_bank = IME_DICTIONARY_START_BANK;
+    current_offset = (uint16_t)(DIC_VERB_TABLE + (uint16_t)index * 3U);
 
-    if (offset_low == 0 && offset_high == 0 && offset_bank == 0) {
+    if (!dic_read_address(&current_bank, &current_offset)) {
         return false;
     }
 
-    current_bank = (uint8_t)(IME_DICTIONARY_START_BANK + offset_bank);
-    current_offset = mkword(offset_high, offset_low);
     return search_entries_in_group(key_buffer, key_length, true);
 }
 static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search) {
@@ -1844,10 +1875,6 @@ static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_lengt
         }
 
         if (should_check) {
-            uint8_t okurigana_high = 0;
-            uint8_t okurigana_low = 0;
-
-
             match = true;
             compare_length = entry_key_length;
 
@@ -1876,21 +1903,7 @@ static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_lengt
             }
 
             if (match) {
-                match_length = entry_key_length;
-                match_bank = current_bank;
-                match_offset = current_offset;
-                match_okurigana = 0;
-
-                current_entry_length = entry_key_length;
-                if (is_verb_search) {
-                    ++current_entry_length;
-                    if (key_length > (uint8_t)(entry_key_length - 1) && key_length > entry_key_length) {
-                        okurigana_high = key_buffer[entry_key_length - 1];
-                        okurigana_low = key_buffer[entry_key_length];
-                        match_okurigana = mkword(okurigana_high, okurigana_low);
-                    }
-                }
-
+                record_match(key_buffer, key_length, entry_key_length, is_verb_search);
                 return true;
             }
         }
@@ -1913,6 +1926,244 @@ static bool search_entries_in_group(const uint8_t* key_buffer, uint8_t key_lengt
 
     return false;
 }
+
+// Second-level index (dictionary version 1 and 2)
+//
+// Each group has a directory of [slot, L, M, H] records ending in 0xFF. The
+// slot is the index of the second kana (DIC_SLOT_OTHER for other
+// characters, DIC_SLOT_SHORT for one-kana keys and stems); the one-kana
+// slot comes first and the rest ascend. Every directory record points at a
+// list of [key bytes, count, L, M, H] runs ending in 0, longest keys first.
+// A run is a block of entries sharing the first two characters and the key
+// length, sorted by key bytes, so a lookup only reads the runs of its own
+// second kana followed by the one-kana keys.
+static bool search_indexed_entries(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search, uint8_t index) {
+    uint8_t slot = DIC_SLOT_SHORT;
+    uint8_t entry_slot;
+    uint8_t list_bank[2];
+    uint16_t list_offset[2];
+    uint8_t lists = 0;
+
+    candidate_count = 0;
+
+    if (key_length >= 4) {
+        slot = hiragana_to_index(key_buffer[2], key_buffer[3]);
+        if (slot == 0xFF) {
+            slot = DIC_SLOT_OTHER;
+        }
+    }
+
+    current_bank = IME_DICTIONARY_START_BANK;
+    current_offset = (uint16_t)((is_verb_search ? DIC_VERB_INDEX_TABLE : DIC_NOUN_INDEX_TABLE) + (uint16_t)index * 3U);
+
+    if (!dic_read_address(&current_bank, &current_offset)) {
+        return false;
+    }
+
+    while ((entry_slot = read_dic_byte()) != DIC_DIRECTORY_END) {
+        if (entry_slot == slot || entry_slot == DIC_SLOT_SHORT) {
+            (void)dic_read_address(&list_bank[lists], &list_offset[lists]);
+            ++lists;
+        } else {
+            dic_skip(3);
+        }
+        if (entry_slot == slot || (entry_slot != DIC_SLOT_SHORT && entry_slot > slot)) {
+            break;
+        }
+    }
+
+    // Second-kana runs hold the longer keys, so they go before the one-kana slot
+    while (lists != 0) {
+        --lists;
+        current_bank = list_bank[lists];
+        current_offset = list_offset[lists];
+        if (search_run_list(key_buffer, key_length, is_verb_search)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool search_run_list(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search) {
+    uint8_t key_bytes;
+
+    while ((key_bytes = read_dic_byte()) != 0) {
+        uint8_t count;
+        uint8_t entry_bank;
+        uint16_t entry_offset;
+        uint8_t list_bank;
+        uint16_t list_offset;
+
+        // Keys (verb stems) longer than the input cannot match
+        if ((is_verb_search ? (uint8_t)(key_bytes - 1) : key_bytes) > key_length) {
+            dic_skip(4);
+            continue;
+        }
+
+        count = read_dic_byte();
+        (void)dic_read_address(&entry_bank, &entry_offset);
+        list_bank = current_bank;
+        list_offset = current_offset;
+
+        current_bank = entry_bank;
+        current_offset = entry_offset;
+        if (dic_version >= 2) {
+            if (search_run_sorted(key_buffer, key_length, is_verb_search, key_bytes, count)) {
+                return true;
+            }
+        } else if (search_run(key_buffer, key_length, is_verb_search, key_bytes, count)) {
+            return true;
+        }
+        current_bank = list_bank;
+        current_offset = list_offset;
+    }
+
+    return false;
+}
+
+// Every key in a run is key_bytes long and the run is sorted, so a key is
+// dropped at its first differing byte and the run ends at the first key
+// that sorts after key_buffer.
+static bool search_run(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                       uint8_t key_bytes, uint8_t count) {
+    uint8_t stem_length = is_verb_search ? (uint8_t)(key_bytes - 1) : key_bytes;
+
+    while (count != 0) {
+        uint8_t skip_low;
+        uint8_t skip_high;
+        uint16_t skip_size;
+        uint8_t ch = 0;
+        uint8_t i;
+
+        --count;
+        skip_low = read_dic_byte();
+        skip_high = read_dic_byte();
+        skip_size = (uint16_t)(mkword(skip_high, skip_low) & 0x7FFFU);
+
+        for (i = 0; i < stem_length; ++i) {
+            ch = read_dic_byte();
+            if (ch != key_buffer[i]) {
+                break;
+            }
+        }
+
+        if (i < stem_length) {
+            if (ch > key_buffer[i]) {
+                return false;
+            }
+            // Rest of the key, its terminator and the candidates
+            dic_skip((uint16_t)(key_bytes - i) + skip_size);
+            continue;
+        }
+
+        if (is_verb_search) {
+            uint8_t verb_suffix = read_dic_byte();
+            (void)read_dic_byte();
+            if (!check_okurigana_match(&key_buffer[stem_length], verb_suffix)) {
+                dic_skip(skip_size);
+                continue;
+            }
+        } else {
+            (void)read_dic_byte();
+        }
+
+        record_match(key_buffer, key_length, key_bytes, is_verb_search);
+        return true;
+    }
+
+    return false;
+}
+
+// Version 2 run addresses point into the group's pointer table (3-byte
+// entry addresses in entry order). Binary search for the first key whose
+// stem is not below key_buffer, then walk forward while the stem matches:
+// nouns match on the first hit, verbs try each okurigana row in turn.
+static bool search_run_sorted(const uint8_t* key_buffer, uint8_t key_length, bool is_verb_search,
+                              uint8_t key_bytes, uint8_t count) {
+    uint8_t table_bank = current_bank;
+    uint16_t table_offset = current_offset;
+    uint8_t stem_length = is_verb_search ? (uint8_t)(key_bytes - 1) : key_bytes;
+    uint8_t low = 0;
+    uint8_t high = count;
+
+    if (count < DIC_SORTED_RUN_MIN) {
+        // Short runs: walk the entry chain from the first pointer
+        uint8_t entry_bank;
+        uint16_t entry_offset;
+        (void)dic_read_address(&entry_bank, &entry_offset);
+        current_bank = entry_bank;
+        current_offset = entry_offset;
+        return search_run(key_buffer, key_length, is_verb_search, key_bytes, count);
+    }
+
+    while (low < high) {
+        uint8_t mid = (uint8_t)(((uint16_t)low + high) / 2U);
+        if (compare_run_entry(table_bank, table_offset, mid, key_buffer, stem_length) < 0) {
+            low = (uint8_t)(mid + 1);
+        } else {
+            high = mid;
+        }
+    }
+
+    for (; low < count; ++low) {
+        if (compare_run_entry(table_bank, table_offset, low, key_buffer, stem_length) != 0) {
+            break;
+        }
+        if (is_verb_search) {
+            uint8_t verb_suffix = read_dic_byte();
+            (void)read_dic_byte();
+            if (!check_okurigana_match(&key_buffer[stem_length], verb_suffix)) {
+                continue;
+            }
+        } else {
+            (void)read_dic_byte();
+        }
+
+        record_match(key_buffer, key_length, key_bytes, is_verb_search);
+        return true;
+    }
+
+    return false;
+}
+
+// Compare the first stem_length key bytes of run entry index with
+// key_buffer. On equality current_bank/current_offset are left just after them.
+static int8_t compare_run_entry(uint8_t table_bank, uint16_t table_offset, uint8_t index,
+                                const uint8_t* key_buffer, uint8_t stem_length) {
+    uint8_t i;
+
+    current_bank = table_bank;
+    current_offset = table_offset;
+    dic_skip((uint16_t)index * 3U);
+    (void)dic_read_address(&current_bank, &current_offset);
+    dic_skip(2);
+
+    for (i = 0; i < stem_length; ++i) {
+        uint8_t ch = read_dic_byte();
+        if (ch != key_buffer[i]) {
+            return ch < key_buffer[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// Remember the entry whose candidate count is at current_bank/current_offset
+static void record_match(const uint8_t* key_buffer, uint8_t key_length, uint8_t entry_key_length, bool is_verb_search) {
+    match_length = entry_key_length;
+    match_bank = current_bank;
+    match_offset = current_offset;
+    match_okurigana = 0;
+
+    current_entry_length = entry_key_length;
+    if (is_verb_search) {
+        ++current_entry_length;
+        if (key_length > (uint8_t)(entry_key_length - 1) && key_length > entry_key_length) {
+            match_okurigana = mkword(key_buffer[entry_key_length - 1], key_buffer[entry_key_length]);
+        }
+    }
+}
+
 static void add_candidates(uint16_t okurigana) {
     uint8_t num_candidates = read_dic_byte();
 
@@ -1975,6 +2226,15 @@ static bool start_conversion(void) {
     if (magic0 != 'D' || magic1 != 'I' || magic2 != 'C') {
         return false;
     }
+    // 0: first-kana tables only, 1: second-level index follows them,
+    // 2: runs also have a sorted pointer table. Version 3 (compressed) is
+    // only read by the oscar64 library, so it counts as no dictionary.
+    // Bit 7 (bank-aligned entries) needs nothing here, as every byte is
+    // read through read_rom_byte.
+    dic_version = read_rom_byte(IME_DICTIONARY_START_BANK, 3) & DIC_VERSION_MASK;
+    if (dic_version > DIC_VERSION_MAX) {
+        return false;
+    }
 
 
     candidate_buffer_pos = 0;
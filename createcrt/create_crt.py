@@ -112,7 +112,131 @@ def create_chip_header(bank_number, load_address, data_size):
     
     return header
 
-def create_magicdesk_crt(base_file, font_file, output_crt, jisx0201_file=None, string_resource_file=None, dictionary_file=None):
+# SJIS glyph index (two-level lead/trail lookup table)
+#
+# Layout (starts at offset 0 of the index bank, blocks never straddle a bank):
+#   +0    'SJX\0' magic
+#   +4    version (1)
+#   +5    bank size in 8KB units (1 = MagicDesk, 2 = EasyFlash)
+#   +6    first font bank (JIS X 0201 + JIS X 0208 combined image)
+#   +7    index bank
+#   +8    trail byte minimum, +9 trail byte count
+#   +16   level 1 bank[128]    indexed by lead byte & 0x7F
+#   +144  level 1 ptr lo[128]  block address - trail minimum
+#   +272  level 1 ptr hi[128]
+#   +400  level 2 blocks: glyph bank[189], addr lo[189], addr hi[189]
+SJIS_INDEX_MAGIC = b'SJX\x00'
+SJIS_INDEX_VERSION = 1
+SJIS_INDEX_TRAIL_MIN = 0x40
+SJIS_INDEX_TRAIL_COUNT = 0xFD - SJIS_INDEX_TRAIL_MIN
+SJIS_INDEX_L1_BANK = 16
+SJIS_INDEX_L1_LO = SJIS_INDEX_L1_BANK + 128
+SJIS_INDEX_L1_HI = SJIS_INDEX_L1_LO + 128
+SJIS_INDEX_HEADER_SIZE = SJIS_INDEX_L1_HI + 128
+SJIS_INDEX_BLOCK_SIZE = SJIS_INDEX_TRAIL_COUNT * 3
+SJIS_INDEX_LEADS = list(range(0x81, 0xA0)) + list(range(0xE0, 0xFD))
+JISX0201_SIZE = 2048
+
+def sjis_to_kanji_offset(lead, trail):
+    """Shift-JIS to JIS X 0208 font offset (same arithmetic as jtxt_sjis_to_offset)"""
+    if trail < 0x40 or trail == 0x7F or trail > 0xFC:
+        return None
+    ku = (lead * 2 - 0x102) if lead <= 0x9F else (lead * 2 - 0x182)
+    if trail >= 0x9F:
+        ku += 1
+    if trail < 0x7F:
+        ten = trail - 0x40
+    elif trail < 0x9F:
+        ten = trail - 0x41
+    else:
+        ten = trail - 0x9F
+    if ku < 0 or ku >= 84:
+        return None
+    return (ku * 94 + ten) * 8
+
+def build_sjis_index(font_size, bank_size, font_bank, index_bank):
+    """Build SJIS index image (multiple of bank_size bytes)"""
+    rom_base = 0x8000
+    blank_offset = sjis_to_kanji_offset(0x81, 0x40)  # Full-width space
+
+    def glyph_entry(kanji_offset):
+        if kanji_offset is None or kanji_offset + 8 > font_size:
+            kanji_offset = blank_offset
+        combined = JISX0201_SIZE + kanji_offset
+        return (font_bank + combined // bank_size, rom_base + combined % bank_size)
+
+    def make_block(lead):
+        banks = bytearray(SJIS_INDEX_TRAIL_COUNT)
+        lo = bytearray(SJIS_INDEX_TRAIL_COUNT)
+        hi = bytearray(SJIS_INDEX_TRAIL_COUNT)
+        for i in range(SJIS_INDEX_TRAIL_COUNT):
+            offset = None
+            if lead is not None:
+                offset = sjis_to_kanji_offset(lead, SJIS_INDEX_TRAIL_MIN + i)
+            bank, addr = glyph_entry(offset)
+            banks[i] = bank
+            lo[i] = addr & 0xFF
+            hi[i] = addr >> 8
+        return bytes(banks + lo + hi)
+
+    image = bytearray(SJIS_INDEX_HEADER_SIZE)
+    image[0:4] = SJIS_INDEX_MAGIC
+    image[4] = SJIS_INDEX_VERSION
+    image[5] = bank_size // 8192
+    image[6] = font_bank
+    image[7] = index_bank
+    image[8] = SJIS_INDEX_TRAIL_MIN
+    image[9] = SJIS_INDEX_TRAIL_COUNT
+
+    def place_block(block):
+        # Keep each block inside one bank so a lookup needs one bank switch
+        pos = len(image)
+        if pos // bank_size != (pos + len(block) - 1) // bank_size:
+            image.extend(bytes(bank_size - pos % bank_size))
+            pos = len(image)
+        image.extend(block)
+        return index_bank + pos // bank_size, rom_base + pos % bank_size
+
+    # Leads without any glyph in the font share one blank block
+    blank_location = None
+    for lead in SJIS_INDEX_LEADS:
+        has_glyph = any(
+            (o := sjis_to_kanji_offset(lead, t)) is not None and o + 8 <= font_size
+            for t in range(SJIS_INDEX_TRAIL_MIN, SJIS_INDEX_TRAIL_MIN + SJIS_INDEX_TRAIL_COUNT))
+        if has_glyph:
+            bank, addr = place_block(make_block(lead))
+        else:
+            if blank_location is None:
+                blank_location = place_block(make_block(None))
+            bank, addr = blank_location
+        ptr = (addr - SJIS_INDEX_TRAIL_MIN) & 0xFFFF
+        i = lead & 0x7F
+        image[SJIS_INDEX_L1_BANK + i] = bank
+        image[SJIS_INDEX_L1_LO + i] = ptr & 0xFF
+        image[SJIS_INDEX_L1_HI + i] = ptr >> 8
+
+    image.extend(bytes(align_to_boundary(len(image), bank_size) - len(image)))
+    return bytes(image)
+
+def create_sjis_index_file(font_file, output_file, layout, font_bank, index_bank):
+    """Write standalone SJIS index image (for #embed in EasyFlash / MagicDesk CRT builds)"""
+    if not os.path.exists(font_file):
+        print(f"Error: {font_file} not found")
+        return False
+
+    bank_size = 16384 if layout == 'easyflash' else 8192
+    index_data = build_sjis_index(os.path.getsize(font_file), bank_size, font_bank, index_bank)
+
+    with open(output_file, 'wb') as f:
+        f.write(index_data)
+
+    index_banks = len(index_data) // bank_size
+    print(f"SJIS index ({layout}): Banks {index_bank}-{index_bank + index_banks - 1} ({len(index_data)} bytes)")
+    print(f"Font banks start at {font_bank}")
+    print(f"Output: {output_file}")
+    return True
+
+def create_magicdesk_crt(base_file, font_file, output_crt, jisx0201_file=None, string_resource_file=None, dictionary_file=None, sjis_index_bank=None, raster_resource_file=None):
     """Create MagicDesk CRT (manual CRT generation, 8KB bank units)"""
     
     if not os.path.exists(base_file):
@@ -252,7 +376,67 @@ def create_magicdesk_crt(base_file, font_file, output_crt, jisx0201_file=None, s
             print(f"String resources: Bank {string_resource_start_bank} ({len(string_resource_data)} bytes)")
         else:
             print(f"String resources: Banks {string_resource_start_bank}-{string_resource_end_bank} ({len(string_resource_data)} bytes)")
-    
+        if string_resource_start_bank != 36:
+            # jtxt reads them from JTXT_STRING_RESOURCE_BANK (default 36)
+            print(f"Warning: string resources start at bank {string_resource_start_bank}, "
+                  f"build with -dJTXT_STRING_RESOURCE_BANK={string_resource_start_bank}")
+    
+    # Add pre-rasterized string resources (optional, place after string resources)
+    if raster_resource_file and os.path.exists(raster_resource_file):
+        raster_start_bank = len(all_banks)
+
+        if raster_resource_file.endswith('.bin'):
+            with open(raster_resource_file, 'rb') as f:
+                raster_data = f.read()
+        else:
+            import tempfile
+            with tempfile.NamedTemporaryFile(suffix='.bin', delete=False) as tmp_file:
+                temp_bin_file = tmp_file.name
+
+            # Rasterize with the same fonts that go into the cartridge
+            command = ['python3', '../stringresources/convert_string_resources.py',
+                       raster_resource_file, temp_bin_file,
+                       str(raster_start_bank * 8192), '--no-align', '--raster',
+                       '--font-file', font_file]
+            if jisx0201_file:
+                command += ['--jisx0201-file', jisx0201_file]
+            result = subprocess.run(command, capture_output=True, text=True)
+
+            if result.returncode != 0:
+                print(f"Raster resource conversion error: {result.stderr}{result.stdout}")
+                os.unlink(temp_bin_file)
+                return False
+
+            with open(temp_bin_file, 'rb') as f:
+                raster_data = f.read()
+            os.unlink(temp_bin_file)
+
+        for i in range(0, len(raster_data), 8192):
+            chunk = raster_data[i:i+8192]
+            if len(chunk) < 8192:
+                chunk += bytes(8192 - len(chunk))
+            all_banks.append(chunk)
+
+        print(f"Raster resources: Banks {raster_start_bank}-{len(all_banks) - 1} ({len(raster_data)} bytes)"
+              f" (build with -dJTXT_RASTER_RESOURCE_BANK={raster_start_bank})")
+
+    # Add SJIS glyph index (optional, placed last at a fixed bank)
+    if sjis_index_bank is not None:
+        if len(all_banks) > sjis_index_bank:
+            print(f"Error: SJIS index bank {sjis_index_bank} is already used (next free bank: {len(all_banks)})")
+            return False
+
+        # Pad unused banks so the index lands on the requested bank
+        while len(all_banks) < sjis_index_bank:
+            all_banks.append(bytes(8192))
+
+        index_data = build_sjis_index(len(font_data) - len(jisx0201_data), 8192,
+                                      font_start_bank, sjis_index_bank)
+        for i in range(0, len(index_data), 8192):
+            all_banks.append(index_data[i:i+8192])
+
+        print(f"SJIS index: Banks {sjis_index_bank}-{len(all_banks) - 1} ({len(index_data)} bytes)")
+
     print(f"\nTotal banks: {len(all_banks)}")
     print(f"Total size: {len(all_banks) * 8192} bytes")
     print(f"Creating MagicDesk CRT: {output_crt}")
@@ -286,11 +470,30 @@ def main():
                       help='JIS X 0201 half-width font file (default: font_jisx0201.bin)')
     parser.add_argument('--string-resource-file', default=None,
                       help='String resource file (CSV format, optional)')
+    parser.add_argument('--raster-resource-file', default=None,
+                      help='String resource file to store pre-rasterized (optional)')
     parser.add_argument('--dictionary-file', default=None,
                       help='Dictionary file (skkdicm.bin, optional)')
+    parser.add_argument('--sjis-index-bank', type=int, default=None,
+                      help='Place SJIS glyph index at this bank (optional)')
+    parser.add_argument('--sjis-index-out', default=None,
+                      help='Write standalone SJIS index binary and exit (no CRT)')
+    parser.add_argument('--sjis-index-layout', choices=['magicdesk', 'easyflash'], default='magicdesk',
+                      help='Bank layout for --sjis-index-out (default: magicdesk)')
+    parser.add_argument('--font-bank', type=int, default=1,
+                      help='First font bank for --sjis-index-out (default: 1)')
     
     args = parser.parse_args()
     
+    # Standalone SJIS index for builds that embed fonts themselves
+    if args.sjis_index_out:
+        if args.sjis_index_bank is None:
+            print("Error: --sjis-index-out requires --sjis-index-bank")
+            return 1
+        success = create_sjis_index_file(args.font_file, args.sjis_index_out,
+                                         args.sjis_index_layout, args.font_bank, args.sjis_index_bank)
+        return 0 if success else 1
+    
     # Select source file
     source_file = 'kanji-magicdesk-basic.asm'
     
@@ -300,8 +503,12 @@ def main():
     print(f"Halfwidth font: {args.jisx0201_file}")
     if args.string_resource_file:
         print(f"String resources: {args.string_resource_file}")
+    if args.raster_resource_file:
+        print(f"Raster resources: {args.raster_resource_file}")
     if args.dictionary_file:
         print(f"Dictionary file: {args.dictionary_file}")
+    if args.sjis_index_bank is not None:
+        print(f"SJIS index bank: {args.sjis_index_bank}")
     print(f"Output: {args.output}")
     print()
     
@@ -312,7 +519,8 @@ def main():
     
     # Create CRT
     success = create_magicdesk_crt(bin_file, args.font_file, args.output, 
-                                   args.jisx0201_file, args.string_resource_file, args.dictionary_file)
+                                   args.jisx0201_file, args.string_resource_file, args.dictionary_file,
+                                   args.sjis_index_bank, args.raster_resource_file)
     
     if success:
         print(f"\nCreation completed: {args.output}")
@@ -1,3 +1,4 @@
+from collections import Counter
 from dataclasses import dataclass, field
 from typing import List
 import sys
@@ -6,12 +7,61 @@ import sys
 
 # Dictionary format
 #
-# +0 : 'DIC' + 0
+# +0 : 'DIC' + version (0, 1, 2 or 3), bit 7 set when bank aligned (--align)
 # +4 : Noun entry "あ" offset address L M H (3bytes)
 # +7 : Noun entry "い" offset address L M H (3bytes)
 # ....
-# 82 * 3 bytes = 207bytes of noun entries
-# 82 * 3 bytes = 207bytes of verb entries
+# 82 * 3 bytes = 246bytes of noun entries
+# 82 * 3 bytes = 246bytes of verb entries
+#
+# Version 1 adds a second-level index and version 2 a sorted pointer table
+# per group. The version 0 tables and the entry chain format are unchanged,
+# so readers that ignore the version byte still work. Version 0 keeps the
+# original entry order; version 1 and 2 sort by Shift-JIS bytes (see
+# sort_entries), so the chain order of some entries differs.
+#
+# +496 : Noun group index address L M H (3bytes) * 82
+# +742 : Verb group index address L M H (3bytes) * 82
+#
+# Group index (one per non-empty group, version 1 to 3):
+#   Directory, terminated by 0xFF. Slot 84 comes first, the rest ascend
+#     1 byte : Slot (index of the second kana, 83 = other character,
+#              84 = one kana key / one kana verb stem)
+#     3 bytes: Run list address L M H
+#   Run lists, one per slot, in entry order and terminated by 0
+#     1 byte : Key length in bytes (Shift-JIS, without the terminator)
+#     1 byte : Number of entries in this run
+#     3 bytes: Address of the first entry L M H (version 1)
+#              Address of the run in the pointer table L M H (version 2, 3)
+#   Pointer table (version 2, 3), one record per entry in entry order
+#     3 bytes: Entry address L M H
+#
+# A run is a block of consecutive entries sharing the first two characters
+# and the key length. Indexed versions sort entries by key length in bytes
+# (longest first) and then by key bytes, so every run is contiguous and sorted, and
+# the runs of one slot keep the longest-match order of the group. With the
+# fixed-stride pointer table the IME binary searches a run instead of
+# walking its entry chain.
+#
+# Version 3 (--compress) is version 2 with compressed entries. The version 0
+# tables are zero, as the entries no longer form a chain.
+#
+# +988 : Token table, 95 records of 4 bytes (expansion, 0-padded)
+#
+# Entry (version 3), reached only through the pointer table
+#   variable : Key without the bytes every key of its run shares (the
+#              group's kana, and the slot's kana for slots 0-82), and
+#              without terminator: the run record gives the key length
+#   1 byte   : Number of candidates
+#   variable : Candidates, null-terminated. Bytes 0x01-0x1F and 0xA0-0xDF
+#              where a character starts are tokens for table records
+#              0-30 and 31-94. A code that appears in a candidate as a
+#              one-byte character expands to itself.
+#
+# Bank alignment (--align): an entry that would cross an 8KB bank boundary
+# starts at the next bank instead, so a reader can walk any entry without
+# switching banks. The gap is filled with zeros and added to the skip size
+# of the entry before it, so the entry chain of version 0 to 2 still works.
 
 offset_keys = [
     "あ",   #; 0
@@ -129,6 +179,14 @@ class DicEntry:
 meishi_offset_entries = [CharOffsetEntry(key=k) for k in offset_keys]
 doushi_offset_entries = [CharOffsetEntry(key=k) for k in offset_keys]
 
+SLOT_OTHER = 83
+SLOT_SHORT = 84
+RUN_MAX = 255
+TOKEN_CODES = list(range(0x01, 0x20)) + list(range(0xA0, 0xE0))
+TOKEN_SIZE = 4
+BANK_SIZE = 8192
+DIC_ALIGNED = 0x80
+
 # Calculate header size
 all_header_size = 4
 for e in meishi_offset_entries:
@@ -146,13 +204,28 @@ for e in doushi_offset_entries:
 # Next entry
 
 # Command line argument processing
-if len(sys.argv) != 3:
-    print("Usage: python dicconv.py <input SKK dictionary file> <output binary file>")
+options = [a for a in sys.argv[1:] if a in ("--index", "--no-index", "--compress", "--align")]
+args = [a for a in sys.argv[1:] if a not in options]
+# Version 0 by default: it fits the cartridge layout (dictionary in banks
+# 10-35, strings and the SJIS index after it) and every IME copy reads it
+dic_version = 0
+if "--index" in options:
+    dic_version = 2
+if "--compress" in options:
+    dic_version = 3
+bank_align = "--align" in options
+if len(args) != 2 or ("--index" in options and "--compress" in options):
+    print("Usage: python dicconv.py [--index | --compress] [--align] <input SKK dictionary file> <output binary file>")
     print("Example: python dicconv.py skkdic.txt skkdic.bin")
+    print("  --index    : Write a version 2 dictionary with the second-level index and pointer tables")
+    print("               (larger than version 0: needs a cartridge layout with more dictionary banks)")
+    print("  --compress : Write a version 3 dictionary with compressed keys and candidates")
+    print("  --align    : Pad so that no entry crosses an 8KB bank boundary")
+    print("  --no-index : Write version 0 (the default)")
     sys.exit(1)
 
-dic_path = sys.argv[1]
-output_filename = sys.argv[2]
+dic_path = args[0]
+output_filename = args[1]
 
 print(f"Input file: {dic_path}")
 print(f"Output file: {output_filename}")
@@ -229,8 +302,15 @@ def sort_entries(entries):
     Sort entries with the following priority:
     1. String length (longest first)
     2. Alphabetical order (dictionary order)
+
+    Version 1 to 3 compare Shift-JIS bytes instead (key length in bytes,
+    then key bytes), which is the order the index runs need: readings that
+    mix kana with one-byte or other characters (こーひー) move.
     """
-    return sorted(entries, key=lambda entry: (-len(entry.key), entry.key))
+    if dic_version == 0:
+        return sorted(entries, key=lambda entry: (-len(entry.key), entry.key))
+    return sorted(entries, key=lambda entry: (-len(entry.key.encode("shift_jis")),
+                                              entry.key.encode("shift_jis")))
 
 # Sort verb entries
 for e in doushi_offset_entries:
@@ -261,74 +341,271 @@ for e in meishi_offset_entries:
 # Size calculation complete
 
 
-# Noun entries start after header size
+# Second-level index (version 1)
+def entry_slot(entry):
+    """Slot of an entry: index of its second kana, SLOT_OTHER or SLOT_SHORT"""
+    if len(entry.key) == 1 or ord(entry.key[1]) < 0x80:
+        return SLOT_SHORT
+    index = offset_keys.index(entry.key[1]) if entry.key[1] in offset_keys else -1
+    if index < 0:
+        return SLOT_OTHER
+    return index
+
+def build_runs(e):
+    """Split the sorted entries of a group into runs per slot
+    Returns {slot: [[key_bytes, count, first_entry_index], ...]}"""
+    slots = {}
+    prev = None
+    for i, entry in enumerate(e.entries):
+        slot = entry_slot(entry)
+        key_bytes = len(entry.key.encode("shift_jis"))
+        run_list = slots.setdefault(slot, [])
+        # Start a new run when the second character or the length changes
+        same_run = (prev is not None and prev.key[:2] == entry.key[:2] and
+                    len(prev.key.encode("shift_jis")) == key_bytes)
+        if not same_run or run_list[-1][1] >= RUN_MAX:
+            run_list.append([key_bytes, 0, i])
+        run_list[-1][1] += 1
+        prev = entry
+    # One kana slot first, then ascending, so a lookup can stop early
+    return dict(sorted(slots.items(), key=lambda item: (item[0] != SLOT_SHORT, item[0])))
+
+def sjis_chars(text):
+    """Shift-JIS bytes of each character"""
+    return [ch.encode("shift_jis") for ch in text]
+
+def build_tokens(entries):
+    """Pick the candidate characters and character pairs that save the most
+    bytes as one-byte tokens. Returns {expansion: code}"""
+    literal = set()
+    counts = Counter()
+    for entry in entries:
+        for k in entry.kouho:
+            chars = sjis_chars(k)
+            for ch in chars:
+                if len(ch) == 1:
+                    literal.add(ch[0])
+                counts[ch] += 1
+            for i in range(len(chars) - 1):
+                counts[chars[i] + chars[i + 1]] += 1
+    tokens = {}
+    for code in TOKEN_CODES:
+        if code in literal:
+            tokens[bytes([code])] = code
+    free = [code for code in TOKEN_CODES if code not in literal]
+    # Saving per use is the expansion length minus the token byte
+    ranked = sorted(((count * (len(text) - 1), text) for text, count in counts.items()
+                     if len(text) > 1), reverse=True)
+    for code, (saving, text) in zip(free, ranked):
+        if saving <= TOKEN_SIZE:
+            break
+        tokens[text] = code
+    return tokens
+
+def encode_candidate(text, tokens):
+    """Candidate bytes with pairs, then single characters, replaced by tokens"""
+    chars = sjis_chars(text)
+    out = bytearray()
+    i = 0
+    while i < len(chars):
+        if i + 1 < len(chars) and chars[i] + chars[i + 1] in tokens:
+            out.append(tokens[chars[i] + chars[i + 1]])
+            i += 2
+        elif chars[i] in tokens:
+            out.append(tokens[chars[i]])
+            i += 1
+        else:
+            out += chars[i]
+            i += 1
+    return bytes(out)
+
+def key_prefix(entry):
+    """Key bytes every key of the entry's run shares (group kana + slot kana)"""
+    return 4 if entry_slot(entry) < SLOT_OTHER else 2
+
+def encode_entry(entry, tokens):
+    """Version 3 entry bytes"""
+    out = bytearray(entry.key.encode("shift_jis")[key_prefix(entry):])
+    out.append(entry.kouho_count)
+    for k in entry.kouho:
+        out += encode_candidate(k, tokens) + b"\x00"
+    return bytes(out)
+
+def index_size(e):
+    size = 1                                    # Directory terminator
+    for run_list in e.runs.values():
+        size += 4 + len(run_list) * 5 + 1       # Directory record + runs + terminator
+    if dic_version >= 2:
+        size += len(e.entries) * 3              # Pointer table
+    return size
+
+def write_address(f, address):
+    # Bank number (per 8KB) in H, offset within that bank in L and M
+    f.write((address % 8192).to_bytes(2, "little"))
+    f.write((address // 8192).to_bytes(1, "little"))
+
+all_groups = meishi_offset_entries + doushi_offset_entries
+tokens = {}
+if dic_version >= 3:
+    tokens = build_tokens(all_entries)
+    for e in all_groups:
+        e.encoded = [encode_entry(entry, tokens) for entry in e.entries]
+        e.entry_size = sum(len(data) for data in e.encoded)
+index_offset = all_header_size
+if dic_version >= 1:
+    index_offset += len(all_groups) * 3
+    if dic_version >= 3:
+        index_offset += len(TOKEN_CODES) * TOKEN_SIZE
+    for e in all_groups:
+        e.runs = build_runs(e) if len(e.entries) > 0 else {}
+        e.index_offset = index_offset if len(e.entries) > 0 else 0
+        index_offset += index_size(e) if len(e.entries) > 0 else 0
+    print(f"Second-level index size: {index_offset - all_header_size} bytes")
+
+# Noun entries start after header size (and the index in version 1 and 2)
 # Followed by verb entries
 
-data_offset = all_header_size
-# Set noun entry offsets
-for e in meishi_offset_entries:
-    if len(e.entries) == 0:
-        e.offset = 0
-    else:
-        e.offset = data_offset
-    data_offset += e.entry_size
-# Set verb entry offsets
-for e in doushi_offset_entries:
-    if len(e.entries) == 0:
-        e.offset = 0
-    else:
-        e.offset = data_offset
-    data_offset += e.entry_size
+def entry_bytes(e, i):
+    return len(e.encoded[i]) if dic_version >= 3 else e.entries[i].all_size & 0x7fff
+
+# Set entry addresses in file order. With --align, an entry that does not
+# fit in the rest of its bank moves to the next one; the zeros in between
+# are written after the previous entry (entry.padding)
+data_offset = index_offset
+lead_padding = 0
+padding_total = 0
+padded_banks = 0
+crossing = 0
+previous = None
+for e in all_groups:
+    e.offset = 0
+    e.addresses = []
+    for i, entry in enumerate(e.entries):
+        size = entry_bytes(e, i)
+        gap = BANK_SIZE - data_offset % BANK_SIZE
+        entry.padding = 0
+        if size > gap:
+            if bank_align:
+                if size > BANK_SIZE:
+                    print(f"Error: entry {entry.key} ({size} bytes) does not fit in a bank")
+                    sys.exit(1)
+                if previous is None:
+                    lead_padding = gap
+                else:
+                    previous.padding = gap
+                data_offset += gap
+                padding_total += gap
+                padded_banks += 1
+            else:
+                crossing += 1
+        if i == 0:
+            e.offset = data_offset
+        e.addresses.append(data_offset)
+        data_offset += size
+        previous = entry
 
-print(f"Dictionary total size: {data_offset} bytes")
+print(f"Dictionary total size: {data_offset} bytes ({(data_offset + BANK_SIZE - 1) // BANK_SIZE} banks of 8KB)")
+if bank_align:
+    print(f"Bank padding: {padding_total} bytes at {padded_banks} bank boundaries ({padding_total * 100 / data_offset:.2f}%)")
+else:
+    print(f"Entries crossing a bank boundary: {crossing}")
 
 output_path = output_filename
 with open(output_path, "wb") as f:
     # Write header
-    f.write(b"DIC\x00")
+    f.write(b"DIC" + (dic_version | (DIC_ALIGNED if bank_align else 0)).to_bytes(1, "little"))
     # Write noun entry offsets byte by byte
     # However, instead of byte count from beginning, put bank number in H when data block is divided into 8KB, and put offset within that bank in L and M
     for e in meishi_offset_entries:
-        offset = e.offset % 8192
+        offset = e.offset % 8192 if dic_version < 3 else 0
         f.write(offset.to_bytes(2, "little"))
-        bank = e.offset // 8192
+        bank = e.offset // 8192 if dic_version < 3 else 0
         f.write(bank.to_bytes(1, "little"))
     for e in doushi_offset_entries:
-        offset = e.offset % 8192
+        offset = e.offset % 8192 if dic_version < 3 else 0
         f.write(offset.to_bytes(2, "little"))
-        bank = e.offset // 8192
+        bank = e.offset // 8192 if dic_version < 3 else 0
         f.write(bank.to_bytes(1, "little"))
-    # Write noun entries
-    for e in meishi_offset_entries:
-        for entry in e.entries:
-            # 1. Total byte count of this entry minus entry key string size and its own size
-            skip_size = entry.all_size - 2 - len(entry.key.encode("shift_jis")) - 1
-            f.write(skip_size.to_bytes(2, "little"))
-            # 2. Entry key string
-            sjis = entry.key.encode("shift_jis")
-            f.write(sjis)
-            f.write(b"\x00")
-            # 3. Number of candidates
-            f.write(entry.kouho_count.to_bytes(1, "little"))
-            # 4. Candidate strings
-            for k in entry.kouho:
-                sjis = k.encode("shift_jis")
+    if dic_version >= 1:
+        # Group index addresses
+        for e in all_groups:
+            write_address(f, e.index_offset)
+    if dic_version >= 3:
+        # Token table
+        expansions = {code: text for text, code in tokens.items()}
+        for code in TOKEN_CODES:
+            f.write(expansions.get(code, b"").ljust(TOKEN_SIZE, b"\x00"))
+        print(f"Tokens: {len(tokens)}")
+    if dic_version >= 1:
+        # Group indexes
+        for e in all_groups:
+            if len(e.entries) == 0:
+                continue
+            entry_offsets = e.addresses
+            run_address = e.index_offset + 1
+            for run_list in e.runs.values():
+                run_address += 4
+            for slot, run_list in e.runs.items():
+                f.write(slot.to_bytes(1, "little"))
+                write_address(f, run_address)
+                run_address += len(run_list) * 5 + 1
+            f.write(b"\xff")
+            # run_address is now the start of the pointer table
+            for run_list in e.runs.values():
+                for key_bytes, count, first in run_list:
+                    f.write(key_bytes.to_bytes(1, "little"))
+                    f.write(count.to_bytes(1, "little"))
+                    if dic_version >= 2:
+                        write_address(f, run_address + first * 3)
+                    else:
+                        write_address(f, entry_offsets[first])
+                f.write(b"\x00")
+            if dic_version >= 2:
+                for address in entry_offsets:
+                    write_address(f, address)
+    f.write(bytes(lead_padding))
+    if dic_version >= 3:
+        # Write noun and verb entries
+        for e in all_groups:
+            for entry, data in zip(e.entries, e.encoded):
+                f.write(data)
+                f.write(bytes(entry.padding))
+    else:
+        # Write noun entries
+        for e in meishi_offset_entries:
+            for entry in e.entries:
+                # 1. Total byte count of this entry minus entry key string size and its own size
+                skip_size = entry.all_size - 2 - len(entry.key.encode("shift_jis")) - 1 + entry.padding
+                f.write(skip_size.to_bytes(2, "little"))
+                # 2. Entry key string
+                sjis = entry.key.encode("shift_jis")
                 f.write(sjis)
                 f.write(b"\x00")
-    # Write verb entries
-    for e in doushi_offset_entries:
-        for entry in e.entries:
-            # 1. Total byte count of this entry minus entry key string size and its own size
-            skip_size = entry.all_size - 2 - len(entry.key.encode("shift_jis")) - 1
-            f.write(skip_size.to_bytes(2, "little"))
-            # 2. Entry key string
-            sjis = entry.key.encode("shift_jis")
-            f.write(sjis)
-            f.write(b"\x00")
-            # 3. Number of candidates
-            f.write(entry.kouho_count.to_bytes(1, "little"))
-            # 4. Candidate strings
-            for k in entry.kouho:
-                sjis = k.encode("shift_jis")
+                # 3. Number of candidates
+                f.write(entry.kouho_count.to_bytes(1, "little"))
+                # 4. Candidate strings
+                for k in entry.kouho:
+                    sjis = k.encode("shift_jis")
+                    f.write(sjis)
+                    f.write(b"\x00")
+                # 5. Bank padding
+                f.write(bytes(entry.padding))
+        # Write verb entries
+        for e in doushi_offset_entries:
+            for entry in e.entries:
+                # 1. Total byte count of this entry minus entry key string size and its own size
+                skip_size = entry.all_size - 2 - len(entry.key.encode("shift_jis")) - 1 + entry.padding
+                f.write(skip_size.to_bytes(2, "little"))
+                # 2. Entry key string
+                sjis = entry.key.encode("shift_jis")
                 f.write(sjis)
-                f.write(b"\x00")
\ No newline at end of file
+                f.write(b"\x00")
+                # 3. Number of candidates
+                f.write(entry.kouho_count.to_bytes(1, "little"))
+                # 4. Candidate strings
+                for k in entry.kouho:
+                    sjis = k.encode("shift_jis")
+                    f.write(sjis)
+                    f.write(b"\x00")
+                # 5. Bank padding
+                f.write(bytes(entry.padding))
@@ -0,0 +1,35 @@
+#ifndef IME_HOST_H
+#define IME_HOST_H
+
+// Host definitions for compiling oscar64_lib/src/ime.c natively (IME_HOST).
+// imesim.c implements them on a fake C64: 64KB of RAM and I/O, and a
+// cartridge ROM of up to 64 banks that the dictionary cursor reads through.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Memory access: RAM and I/O registers of the fake machine
+uint8_t host_peek(uint16_t addr);
+void host_poke(uint16_t addr, uint8_t value);
+
+#define PEEK(addr) host_peek((uint16_t)(addr))
+#define POKE(addr, val) host_poke((uint16_t)(addr), (uint8_t)(val))
+
+// ROM window of the bank selected in $DE00, and counted byte reads
+const volatile uint8_t* host_rom_window(void);
+uint8_t host_rom_read(const volatile uint8_t* ptr);
+
+#define DIC_ROM host_rom_window()
+#define DIC_BYTE(ptr) host_rom_read(ptr)
+
+// KERNAL GETIN: next key of the replayed script, 0 when idle
+uint8_t cbm_k_getin(void);
+
+// KERNAL file I/O (Oscar64 c64/kernalio.h) on host files
+void krnio_setnam(const char* name);
+bool krnio_open(char fnum, char device, char channel);
+void krnio_close(char fnum);
+int krnio_read(char fnum, char* data, int num);
+int krnio_write(char fnum, const char* data, int num);
+
+#endif /* IME_HOST_H */
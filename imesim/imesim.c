@@ -0,0 +1,783 @@
+// imesim - Host-side IME lookup simulator and profiler
+//
+// Compiles oscar64_lib/src/ime.c natively (IME_HOST) against a fake C64:
+// RAM and I/O registers are a 64KB array, and the cartridge ROM is loaded
+// from a dictionary image (skkdic.bin) or a complete CRT file. Romaji key
+// scripts are replayed through ime_process() and every conversion is
+// reported with the ROM bytes it read, the bank switches and function calls
+// it made, and an estimate of the 6502 cycles.
+//
+// The IME is included as one translation unit, so the simulator sees its
+// state (conversion, buffers, candidates) without any extra interface.
+
+#include <errno.h>
+#include <iconv.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ime_host.h"
+#include "ime.c"
+
+#define ROM_BANKS       64
+#define ROM_BANK_SIZE   16384U      // EasyFlash ROML + ROMH; 8KB used otherwise
+#define ROM_HALF        8192U
+
+#ifdef JTXT_EASYFLASH
+#define ROM_WINDOW_SIZE ROM_BANK_SIZE
+#else
+#define ROM_WINDOW_SIZE ROM_HALF
+#endif
+
+#define SCRIPT_KEYS_MAX 256
+#define LINE_OUTPUT_MAX 256
+#define DEFAULT_IDLE    3
+#define DEFAULT_DIC     "../dicconv/skkdic.bin"
+
+// Cost model for the cycle estimate (rough; for comparing changes)
+#define DEFAULT_CYCLES_READ   12    // (zp),y load, pointer step and bank check
+#define DEFAULT_CYCLES_CALL   30    // jsr/rts and frame setup of one call
+#define DEFAULT_CYCLES_SWITCH 10    // $DE00 write and window update
+
+#define PAL_CYCLES_PER_MS 985.248
+
+//=============================================================================
+// Fake machine
+//=============================================================================
+
+static uint8_t host_memory[65536];
+static uint8_t host_rom[ROM_BANKS][ROM_BANK_SIZE];
+
+// Counters of the running measurement
+typedef struct {
+    unsigned long reads;        // ROM bytes read
+    unsigned long touched;      // Distinct ROM bytes read
+    unsigned long switches;     // $DE00 writes that changed the bank
+    unsigned long calls;        // IME function calls
+    unsigned long glyphs;       // Glyphs drawn on the bitmap screen
+    unsigned long cleared;      // Cells cleared by block fills
+} sim_counters_t;
+
+static sim_counters_t counters;
+static uint32_t touch_epoch = 1;
+static uint32_t touch_stamp[ROM_BANKS * ROM_BANK_SIZE];
+
+uint8_t host_peek(uint16_t addr) {
+    return host_memory[addr];
+}
+
+void host_poke(uint16_t addr, uint8_t value) {
+    if (addr == BANK_REG && host_memory[addr] != value) {
+        ++counters.switches;
+    }
+    // Keyboard matrix rows and columns read back as "no key"
+    if (addr == CIA1_DATA_B) {
+        return;
+    }
+    host_memory[addr] = value;
+}
+
+const volatile uint8_t* host_rom_window(void) {
+    return host_rom[host_memory[BANK_REG] % ROM_BANKS];
+}
+
+uint8_t host_rom_read(const volatile uint8_t* ptr) {
+    const uint8_t* window = host_rom[host_memory[BANK_REG] % ROM_BANKS];
+    size_t offset = (size_t)((const uint8_t*)ptr - window);
+    size_t index;
+
+    if ((const uint8_t*)ptr < window || offset >= ROM_WINDOW_SIZE) {
+        fprintf(stderr, "Error: ROM read outside the window of bank %u (offset %ld)\n",
+                host_memory[BANK_REG], (long)((const uint8_t*)ptr - window));
+        exit(3);
+    }
+
+    index = (size_t)(host_memory[BANK_REG] % ROM_BANKS) * ROM_BANK_SIZE + offset;
+    ++counters.reads;
+    if (touch_stamp[index] != touch_epoch) {
+        touch_stamp[index] = touch_epoch;
+        ++counters.touched;
+    }
+    return *ptr;
+}
+
+void __attribute__((no_instrument_function)) __cyg_profile_func_enter(void* function, void* call_site) {
+    (void)function;
+    (void)call_site;
+    ++counters.calls;
+}
+
+void __attribute__((no_instrument_function)) __cyg_profile_func_exit(void* function, void* call_site) {
+    (void)function;
+    (void)call_site;
+}
+
+//=============================================================================
+// KERNAL and jtxt stubs
+//=============================================================================
+
+static uint8_t key_queue[SCRIPT_KEYS_MAX];
+static int key_count = 0;
+static uint8_t pending_key = 0;
+
+uint8_t cbm_k_getin(void) {
+    uint8_t key = pending_key;
+    pending_key = 0;
+    return key;
+}
+
+static FILE* krnio_file = NULL;
+static char krnio_name[64];
+
+void krnio_setnam(const char* name) {
+    char* comma;
+
+    snprintf(krnio_name, sizeof(krnio_name), "%s", name);
+    comma = strchr(krnio_name, ',');
+    if (comma != NULL) {
+        *comma = 0;
+    }
+}
+
+bool krnio_open(char fnum, char device, char channel) {
+    (void)fnum;
+    (void)device;
+    if (channel == 15) {
+        // Command channel: "s:" (scratch) is done by the "w" open
+        return true;
+    }
+    krnio_file = fopen(krnio_name, channel == 1 ? "wb" : "rb");
+    return krnio_file != NULL;
+}
+
+void krnio_close(char fnum) {
+    if (fnum != 15 && krnio_file != NULL) {
+        fclose(krnio_file);
+        krnio_file = NULL;
+    }
+}
+
+int krnio_read(char fnum, char* data, int num) {
+    (void)fnum;
+    return krnio_file != NULL ? (int)fread(data, 1, (size_t)num, krnio_file) : -1;
+}
+
+int krnio_write(char fnum, const char* data, int num) {
+    (void)fnum;
+    return krnio_file != NULL ? (int)fwrite(data, 1, (size_t)num, krnio_file) : -1;
+}
+
+// Bitmap output is only counted: glyphs drawn and cells block-cleared
+jtxt_state_t jtxt_state;
+
+bool jtxt_is_firstsjis(uint8_t c);
+
+void jtxt_bcolor(uint8_t fg, uint8_t bg) { (void)fg; (void)bg; }
+
+void jtxt_blocate(uint8_t x, uint8_t y) {
+    jtxt_state.cursor_x = x;
+    jtxt_state.cursor_y = y;
+    jtxt_state.sjis_first_byte = 0;
+}
+
+void jtxt_bputc(uint8_t char_code) {
+    if (jtxt_state.sjis_first_byte == 0 && jtxt_is_firstsjis(char_code)) {
+        jtxt_state.sjis_first_byte = char_code;
+        return;
+    }
+    jtxt_state.sjis_first_byte = 0;
+    ++jtxt_state.cursor_x;
+    ++counters.glyphs;
+}
+
+void jtxt_bputs(const char* str) {
+    while (*str) {
+        jtxt_bputc((uint8_t)*str++);
+    }
+}
+
+void jtxt_bclear_chars(uint8_t count) {
+    if (jtxt_state.cursor_x < 40) {
+        counters.cleared += count < 40 - jtxt_state.cursor_x ? count : 40 - jtxt_state.cursor_x;
+    }
+}
+
+void jtxt_bclear_to_eol(void) {
+    jtxt_bclear_chars((uint8_t)(40 - jtxt_state.cursor_x));
+}
+
+void jtxt_bwindow(uint8_t top_row, uint8_t bottom_row) { (void)top_row; (void)bottom_row; }
+void jtxt_bwindow_enable(void) {}
+void jtxt_bwindow_disable(void) {}
+
+bool jtxt_is_firstsjis(uint8_t c) {
+    return (c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC);
+}
+
+//=============================================================================
+// ROM loading
+//=============================================================================
+
+// Dictionary image in 8KB banks from IME_DICTIONARY_START_BANK (EasyFlash:
+// two per 16KB bank from IME_DIC_EF_START_BANK, as the IME maps them)
+static bool load_dictionary(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    unsigned bank = 0;
+    size_t size;
+
+    if (f == NULL) {
+        fprintf(stderr, "Error: cannot open %s: %s\n", filename, strerror(errno));
+        return false;
+    }
+    for (;;) {
+#ifdef JTXT_EASYFLASH
+        uint8_t* chunk = &host_rom[IME_DIC_EF_START_BANK + bank / 2][(bank & 1) * ROM_HALF];
+        bool full = IME_DIC_EF_START_BANK + bank / 2 < ROM_BANKS;
+#else
+        uint8_t* chunk = host_rom[IME_DICTIONARY_START_BANK + bank];
+        bool full = IME_DICTIONARY_START_BANK + bank < ROM_BANKS;
+#endif
+        if (!full) {
+            fprintf(stderr, "Error: %s does not fit in %d banks\n", filename, ROM_BANKS);
+            fclose(f);
+            return false;
+        }
+        size = fread(chunk, 1, ROM_HALF, f);
+        if (size < ROM_HALF) {
+            break;
+        }
+        ++bank;
+    }
+    fclose(f);
+    return true;
+}
+
+static uint16_t read_be16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t read_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// CHIP packets of a CRT image, placed by bank and load address
+static bool load_crt(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    uint8_t header[64];
+    uint8_t chip[16];
+    uint32_t header_size;
+
+    if (f == NULL) {
+        fprintf(stderr, "Error: cannot open %s: %s\n", filename, strerror(errno));
+        return false;
+    }
+    if (fread(header, 1, 0x20, f) != 0x20 || memcmp(header, "C64 CARTRIDGE   ", 16) != 0) {
+        fprintf(stderr, "Error: %s is not a CRT image\n", filename);
+        fclose(f);
+        return false;
+    }
+    header_size = read_be32(&header[0x10]);
+    fseek(f, (long)header_size, SEEK_SET);
+
+    while (fread(chip, 1, sizeof(chip), f) == sizeof(chip)) {
+        uint32_t packet_size = read_be32(&chip[4]);
+        uint16_t bank = read_be16(&chip[10]);
+        uint16_t address = read_be16(&chip[12]);
+        uint16_t size = read_be16(&chip[14]);
+        uint32_t offset = (uint32_t)address - ROM_BASE;
+
+        if (memcmp(chip, "CHIP", 4) != 0 || bank >= ROM_BANKS || address < ROM_BASE ||
+            offset + size > ROM_BANK_SIZE) {
+            fprintf(stderr, "Error: unsupported CHIP packet in %s (bank %u, $%04X)\n",
+                    filename, bank, address);
+            fclose(f);
+            return false;
+        }
+        if (fread(&host_rom[bank][offset], 1, size, f) != size) {
+            break;
+        }
+        fseek(f, (long)(packet_size - sizeof(chip) - size), SEEK_CUR);
+    }
+    fclose(f);
+    return true;
+}
+
+//=============================================================================
+// Key scripts
+//=============================================================================
+
+typedef struct {
+    const char* name;
+    uint8_t key;
+} key_name_t;
+
+static const key_name_t key_names[] = {
+    { "ret", KEY_RETURN },
+    { "esc", KEY_ESC },
+    { "del", 0x14 },
+    { "right", 0x1D },
+    { "down", 0x11 },
+    { "left", 0x9D },
+    { "up", 0x91 },
+    { "sp", KEY_SPACE },
+};
+
+// Parse a script line into key_queue: characters are keys, a space is
+// SPACE, {name} a special key. RETURN is added to confirm the line. The
+// keys end at "=>", which starts the expected output (see main).
+static bool parse_script(const char* line, int line_number) {
+    key_count = 0;
+
+    while (*line != 0 && *line != '\n' && *line != '\r' && strncmp(line, "=>", 2) != 0) {
+        uint8_t key = (uint8_t)*line++;
+
+        if (key == '{') {
+            const char* end = strchr(line, '}');
+            size_t i;
+            bool found = false;
+
+            if (end == NULL) {
+                fprintf(stderr, "Line %d: missing '}'\n", line_number);
+                return false;
+            }
+            for (i = 0; i < sizeof(key_names) / sizeof(key_names[0]); ++i) {
+                if (strlen(key_names[i].name) == (size_t)(end - line) &&
+                    strncmp(key_names[i].name, line, (size_t)(end - line)) == 0) {
+                    key = key_names[i].key;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                fprintf(stderr, "Line %d: unknown key {%.*s}\n", line_number, (int)(end - line), line);
+                return false;
+            }
+            line = end + 1;
+        }
+        if (key_count >= SCRIPT_KEYS_MAX - 1) {
+            fprintf(stderr, "Line %d: too many keys\n", line_number);
+            return false;
+        }
+        key_queue[key_count++] = key;
+    }
+    key_queue[key_count++] = KEY_RETURN;
+    return true;
+}
+
+//=============================================================================
+// Report
+//=============================================================================
+
+typedef struct {
+    unsigned long count;
+    unsigned long long sum;
+    unsigned long max;
+} stat_t;
+
+typedef struct {
+    unsigned long cycles_read;
+    unsigned long cycles_call;
+    unsigned long cycles_switch;
+    int idle;
+    int budget;
+    bool multi_clause;
+    bool quiet;
+} sim_options_t;
+
+static sim_options_t options = {
+    DEFAULT_CYCLES_READ, DEFAULT_CYCLES_CALL, DEFAULT_CYCLES_SWITCH, DEFAULT_IDLE, IME_LOOKUP_BUDGET,
+    false, false
+};
+
+static iconv_t sjis_to_utf8 = (iconv_t)-1;
+
+static void stat_add(stat_t* stat, unsigned long value) {
+    ++stat->count;
+    stat->sum += value;
+    if (value > stat->max) {
+        stat->max = value;
+    }
+}
+
+static void stat_print(const char* label, const stat_t* stat) {
+    double average = stat->count != 0 ? (double)stat->sum / (double)stat->count : 0.0;
+    printf("  %-16s %10.1f %10lu\n", label, average, stat->max);
+}
+
+static unsigned long estimate_cycles(const sim_counters_t* c) {
+    return c->reads * options.cycles_read + c->calls * options.cycles_call +
+           c->switches * options.cycles_switch;
+}
+
+static void counters_start(void) {
+    memset(&counters, 0, sizeof(counters));
+    ++touch_epoch;
+}
+
+static void counters_add(sim_counters_t* total, const sim_counters_t* c) {
+    total->reads += c->reads;
+    total->touched += c->touched;
+    total->switches += c->switches;
+    total->calls += c->calls;
+    total->glyphs += c->glyphs;
+    total->cleared += c->cleared;
+}
+
+// Shift-JIS text as UTF-8 in output (hex bytes if it does not convert)
+static const char* convert_utf8(const uint8_t* text, size_t length, char* output, size_t size) {
+    char input[LINE_OUTPUT_MAX];
+    char* in = input;
+    char* out = output;
+    size_t in_left;
+    size_t out_left = size - 1;
+
+    if (length > sizeof(input)) {
+        length = sizeof(input);
+    }
+    memcpy(input, text, length);
+    in_left = length;
+    if (sjis_to_utf8 != (iconv_t)-1) {
+        iconv(sjis_to_utf8, NULL, NULL, NULL, NULL);
+        if (iconv(sjis_to_utf8, &in, &in_left, &out, &out_left) != (size_t)-1) {
+            *out = 0;
+            return output;
+        }
+    }
+    out = output;
+    for (in_left = 0; in_left < length && in_left * 2 + 2 < size; ++in_left) {
+        out += sprintf(out, "%02X", (uint8_t)input[in_left]);
+    }
+    *out = 0;
+    return output;
+}
+
+static const char* to_utf8(const uint8_t* text, size_t length) {
+    static char output[CONVERSION_KEY_SIZE * 3 + 1];
+
+    if (length > CONVERSION_KEY_SIZE) {
+        length = CONVERSION_KEY_SIZE;
+    }
+    return convert_utf8(text, length, output, sizeof(output));
+}
+
+// Settings the application makes after ime_init (and again after an
+// overlay reload, as the terminal does)
+static void apply_settings(void) {
+    ime_set_multi_clause(options.multi_clause);
+    ime_set_lookup_budget((uint8_t)options.budget);
+    ime_activate();
+}
+
+// Script directives: "!multi on|off", "!budget N", and "!reload", which
+// resets the IME as the terminal does after its XMODEM overlay
+static bool run_directive(const char* line, int line_number) {
+    char word[16];
+    char value[16];
+    int fields = sscanf(line, "!%15s %15s", word, value);
+
+    if (fields == 2 && strcmp(word, "multi") == 0) {
+        options.multi_clause = strcmp(value, "on") == 0;
+    } else if (fields == 2 && strcmp(word, "budget") == 0) {
+        options.budget = atoi(value);
+    } else if (fields == 1 && strcmp(word, "reload") == 0) {
+        ime_reset();
+    } else {
+        fprintf(stderr, "Line %d: unknown directive %s", line_number, line);
+        return false;
+    }
+    apply_settings();
+    return true;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+static void usage(const char* program) {
+    printf("Usage: %s [options] <script file>\n", program);
+    printf("  --dic FILE     Dictionary image (default: %s)\n", DEFAULT_DIC);
+    printf("  --crt FILE     CRT image holding the dictionary instead of --dic\n");
+    printf("  --mru FILE     Load the conversion cache from FILE first (PRG build)\n");
+    printf("  --idle N       Idle calls after each key, for the pre-search (default: %d)\n", DEFAULT_IDLE);
+    printf("  --cost R,C,S   Cycles per ROM read, call and bank switch (default: %d,%d,%d)\n",
+           DEFAULT_CYCLES_READ, DEFAULT_CYCLES_CALL, DEFAULT_CYCLES_SWITCH);
+    printf("  --budget N     Dictionary lookups per ime_process call, 0 for no limit\n");
+    printf("                 (ime_set_lookup_budget, default: %d)\n", IME_LOOKUP_BUDGET);
+    printf("  --multi        Multi-clause conversion (ime_set_multi_clause(true))\n");
+    printf("  --quiet        Print the summary only\n");
+    printf("Script: one conversion sequence per line; a space is SPACE, {ret} {esc}\n");
+    printf("{del} {left} {right} {up} {down} {sp} are special keys, # starts a comment.\n");
+    printf("RETURN is pressed at the end of every line until no input is left.\n");
+    printf("\"keys => text\" checks the text the line confirmed (exit status 1 if not).\n");
+    printf("!multi on|off, !budget N and !reload (ime_reset) are directives.\n");
+}
+
+int main(int argc, char** argv) {
+    const char* dic_file = DEFAULT_DIC;
+    const char* crt_file = NULL;
+    const char* mru_file = NULL;
+    const char* script_file = NULL;
+    FILE* script;
+    char line[512];
+    int line_number = 0;
+    int i;
+    unsigned long conversions = 0;
+    unsigned long found = 0;
+    unsigned long keys = 0;
+    unsigned long checks = 0;
+    unsigned long failures = 0;
+    sim_counters_t presearch;
+    sim_counters_t typing;
+    stat_t stat_reads = { 0, 0, 0 };
+    stat_t stat_touched = { 0, 0, 0 };
+    stat_t stat_switches = { 0, 0, 0 };
+    stat_t stat_calls = { 0, 0, 0 };
+    stat_t stat_cycles = { 0, 0, 0 };
+    stat_t stat_presearch = { 0, 0, 0 };
+    stat_t stat_ticks = { 0, 0, 0 };
+    stat_t stat_longest = { 0, 0, 0 };
+    stat_t stat_key_cycles = { 0, 0, 0 };
+    stat_t stat_key_glyphs = { 0, 0, 0 };
+    stat_t stat_key_cleared = { 0, 0, 0 };
+
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--dic") == 0 && i + 1 < argc) {
+            dic_file = argv[++i];
+        } else if (strcmp(argv[i], "--crt") == 0 && i + 1 < argc) {
+            crt_file = argv[++i];
+        } else if (strcmp(argv[i], "--mru") == 0 && i + 1 < argc) {
+            mru_file = argv[++i];
+        } else if (strcmp(argv[i], "--idle") == 0 && i + 1 < argc) {
+            options.idle = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cost") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%lu,%lu,%lu", &options.cycles_read, &options.cycles_call,
+                       &options.cycles_switch) != 3) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            options.budget = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--multi") == 0) {
+            options.multi_clause = true;
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            options.quiet = true;
+        } else if (argv[i][0] != '-' && script_file == NULL) {
+            script_file = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (script_file == NULL) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // No key pressed in the keyboard matrix, $01 with the cartridge visible
+    host_memory[CIA1_DATA_B] = 0xFF;
+    host_memory[0x01] = 0x37;
+    if (crt_file != NULL ? !load_crt(crt_file) : !load_dictionary(dic_file)) {
+        return 2;
+    }
+    script = fopen(script_file, "r");
+    if (script == NULL) {
+        fprintf(stderr, "Error: cannot open %s: %s\n", script_file, strerror(errno));
+        return 2;
+    }
+    sjis_to_utf8 = iconv_open("UTF-8", "CP932");
+
+    ime_init();
+#ifndef JTXT_CRT
+    if (mru_file != NULL && !ime_mru_load(8, mru_file)) {
+        fprintf(stderr, "Warning: cannot load the conversion cache %s\n", mru_file);
+    }
+#else
+    if (mru_file != NULL) {
+        fprintf(stderr, "Warning: CRT builds have no conversion cache file\n");
+    }
+#endif
+    apply_settings();
+    if (!check_dictionary()) {
+        fprintf(stderr, "Error: no dictionary at bank %d\n", IME_DICTIONARY_START_BANK);
+        return 2;
+    }
+
+    if (!options.quiet) {
+        printf("%5s %5s %7s %7s %7s %5s %6s %8s  %s\n",
+               "LINE", "CAND", "PRE-RD", "READS", "TOUCHED", "BANK", "CALLS", "CYCLES", "READING -> FIRST CANDIDATE");
+    }
+
+    memset(&presearch, 0, sizeof(presearch));
+    memset(&typing, 0, sizeof(typing));
+    while (fgets(line, sizeof(line), script) != NULL) {
+        ++line_number;
+        uint8_t line_output[LINE_OUTPUT_MAX];
+        size_t line_output_length = 0;
+        const char* expected;
+
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r' || line[0] == 0) {
+            continue;
+        }
+        if (line[0] == '!') {
+            if (!run_directive(line, line_number)) {
+                ++failures;
+            }
+            continue;
+        }
+        if (!parse_script(line, line_number)) {
+            continue;
+        }
+
+        for (i = 0; i < key_count; ++i) {
+            uint8_t key = key_queue[i];
+            uint8_t state = ime_conversion_state;
+            uint8_t reading[HIRAGANA_BUFFER_SIZE];
+            uint8_t reading_length = hiragana_pos;
+            sim_counters_t key_cost;
+            uint8_t event;
+            unsigned long longest;
+            unsigned long ticks;
+            int idle;
+
+            memcpy(reading, hiragana_buffer, reading_length);
+
+            counters_start();
+            pending_key = key;
+            event = ime_process();
+
+            // With a lookup budget the conversion takes more calls: the key
+            // costs them all, the longest one is what the caller waits for
+            longest = estimate_cycles(&counters);
+            ticks = 1;
+            while (event == IME_EVENT_BUSY) {
+                unsigned long before = estimate_cycles(&counters);
+                event = ime_process();
+                ++ticks;
+                if (estimate_cycles(&counters) - before > longest) {
+                    longest = estimate_cycles(&counters) - before;
+                }
+            }
+            key_cost = counters;
+            ++keys;
+            if (event == IME_EVENT_CONFIRMED) {
+                uint8_t length = ime_get_result_length();
+
+                if (line_output_length + length <= sizeof(line_output)) {
+                    memcpy(&line_output[line_output_length], ime_get_result_text(), length);
+                    line_output_length += length;
+                }
+                ime_clear_output();
+            }
+
+            if (key == KEY_SPACE && state == IME_STATE_INPUT && reading_length > 0) {
+                unsigned long cycles = estimate_cycles(&key_cost);
+                bool converted = ime_conversion_state == IME_STATE_CONVERTING;
+
+                ++conversions;
+                if (converted) {
+                    ++found;
+                }
+                stat_add(&stat_reads, key_cost.reads);
+                stat_add(&stat_touched, key_cost.touched);
+                stat_add(&stat_switches, key_cost.switches);
+                stat_add(&stat_calls, key_cost.calls);
+                stat_add(&stat_cycles, cycles);
+                stat_add(&stat_presearch, presearch.reads);
+                stat_add(&stat_ticks, ticks);
+                stat_add(&stat_longest, longest);
+                if (!options.quiet) {
+                    printf("%5d %5u %7lu %7lu %7lu %5lu %6lu %8lu  %s",
+                           line_number, converted ? candidate_count : 0, presearch.reads,
+                           key_cost.reads, key_cost.touched, key_cost.switches, key_cost.calls, cycles,
+                           to_utf8(reading, reading_length));
+                    if (converted && clause_count != 0) {
+                        // Clauses separated by '|'
+                        uint8_t clause;
+                        printf(" ->");
+                        for (clause = 0; clause < clause_count; ++clause) {
+                            printf("%s%s", clause == 0 ? " " : "|",
+                                   to_utf8(&clause_text[clause_text_start[clause]],
+                                           (size_t)(clause_text_start[clause + 1] - clause_text_start[clause])));
+                        }
+                    } else if (converted) {
+                        const uint8_t* candidate = get_current_candidate();
+                        printf(" -> %s", to_utf8(candidate, strlen((const char*)candidate)));
+                    }
+                    printf("\n");
+                }
+                memset(&presearch, 0, sizeof(presearch));
+            } else {
+                stat_add(&stat_key_cycles, estimate_cycles(&key_cost));
+                stat_add(&stat_key_glyphs, key_cost.glyphs);
+                stat_add(&stat_key_cleared, key_cost.cleared);
+                counters_add(&typing, &key_cost);
+            }
+
+            // Idle loop of the application between keys
+            counters_start();
+            for (idle = 0; idle < options.idle; ++idle) {
+                (void)ime_process();
+            }
+            counters_add(&presearch, &counters);
+            counters_add(&typing, &counters);
+
+            // RETURN again until the line leaves nothing behind (only the
+            // matched part of a reading is converted and confirmed)
+            if (i == key_count - 1 && key_count < SCRIPT_KEYS_MAX &&
+                (ime_conversion_state != IME_STATE_INPUT || hiragana_pos != 0 || romaji_pos != 0)) {
+                key_queue[key_count++] = KEY_RETURN;
+            }
+        }
+        if (ime_conversion_state != IME_STATE_INPUT || hiragana_pos != 0 || romaji_pos != 0) {
+            fprintf(stderr, "Line %d: input left pending\n", line_number);
+        }
+
+        // "=> text": what the line confirmed
+        expected = strstr(line, "=>");
+        if (expected != NULL) {
+            char output[LINE_OUTPUT_MAX * 3 + 1];
+            size_t length;
+
+            expected += 2;
+            while (*expected == ' ') {
+                ++expected;
+            }
+            length = strcspn(expected, "\r\n");
+            convert_utf8(line_output, line_output_length, output, sizeof(output));
+            ++checks;
+            if (strlen(output) != length || strncmp(output, expected, length) != 0) {
+                fprintf(stderr, "Line %d: expected %.*s, got %s\n", line_number, (int)length, expected, output);
+                ++failures;
+            }
+        }
+    }
+    fclose(script);
+
+    printf("\nConversions: %lu (%lu with candidates), keys: %lu\n", conversions, found, keys);
+    printf("  %-16s %10s %10s\n", "PER CONVERSION", "AVERAGE", "MAX");
+    stat_print("ROM reads", &stat_reads);
+    stat_print("ROM bytes", &stat_touched);
+    stat_print("Bank switches", &stat_switches);
+    stat_print("Calls", &stat_calls);
+    stat_print("Cycles (est.)", &stat_cycles);
+    stat_print("Pre-search reads", &stat_presearch);
+    stat_print("IME calls", &stat_ticks);
+    stat_print("Longest call", &stat_longest);
+    printf("  %-16s %10.2f %10.2f\n", "Milliseconds",
+           stat_cycles.count != 0 ? (double)stat_cycles.sum / (double)stat_cycles.count / PAL_CYCLES_PER_MS : 0.0,
+           (double)stat_cycles.max / PAL_CYCLES_PER_MS);
+    printf("  %-16s %10s %10s\n", "OTHER KEYS", "AVERAGE", "MAX");
+    stat_print("Cycles (est.)", &stat_key_cycles);
+    stat_print("Glyphs drawn", &stat_key_glyphs);
+    stat_print("Cells cleared", &stat_key_cleared);
+    printf("Idle pre-search and other keys: %lu ROM reads, %lu calls\n", typing.reads, typing.calls);
+
+    if (checks != 0 || failures != 0) {
+        printf("Checks: %lu, failed: %lu\n", checks, failures);
+    }
+
+    if (sjis_to_utf8 != (iconv_t)-1) {
+        iconv_close(sjis_to_utf8);
+    }
+    return failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,320 @@
+#!/usr/bin/env python3
+"""
+Romaji Table Converter Tool
+Compiles a romaji to kana rule file into the transition table of the
+Oscar64 IME (c/oscar64_lib/src/romaji_table.h)
+
+Rule file (UTF-8), one rule per line, '#' starts a comment:
+
+  input  output  [pending]
+
+  input   : Keys typed (printable ASCII, lowercase letters as the IME
+            lowercases A-Z, up to MAX_INPUT keys)
+  output  : Kana written to the input line (full-width characters only)
+  pending : Keys left in the romaji buffer after the output ("kk" -> "っ"
+            leaves "k"), optional
+
+A key that continues no rule is dropped together with the keys in the
+romaji buffer, as in the llvm-mos IME ("kkwa" gives "っあ"). A rule may
+not be the prefix of another rule ("n" and "na"); to read a key again
+after a kana, give it as pending keys ("nk" -> "ん" leaves "k").
+
+Table format
+
+  The rules form a trie of the input keys. Every node that continues at
+  least one rule is a state, state 0 is the empty buffer. A transition
+  (state, key) gives the next state and an output slot. A key that
+  completes a rule outputs it and moves to the state of its pending keys,
+  a key that continues a rule outputs nothing and moves to the child.
+
+  The transitions are row displacement packed: the transition of key k in
+  state s is entry romaji_base[s] + (k - ROMAJI_KEY_FIRST) when
+  romaji_check[] of that entry is s, so one key costs one lookup. Keys
+  outside ROMAJI_KEY_FIRST to ROMAJI_KEY_LAST continue no rule.
+
+  romaji_parent[s] : State before the last key of s, for backspace
+  romaji_key[s]    : Last key of s; with romaji_parent[] it spells the
+                     romaji buffer of s
+  romaji_depth[s]  : Number of keys of s
+
+  Output slots index romaji_output[], offsets into romaji_kana[], a list
+  of null-terminated Shift-JIS strings. Slot 0 is the empty string.
+"""
+
+import sys
+
+KEY_FIRST = 32
+KEY_LAST = 126
+MAX_INPUT = 7       # ROMAJI_BUFFER_SIZE - 1 in ime.c
+
+class Node:
+    def __init__(self, parent, key, depth):
+        self.parent = parent
+        self.key = key
+        self.depth = depth
+        self.children = {}
+        self.output = None
+        self.pending = ''
+        self.state = None
+
+def parse_rules(filename):
+    """Parse the rule file; returns a list of (input, output, pending)"""
+    rules = []
+    seen = {}
+    errors = 0
+
+    with open(filename, 'r', encoding='utf-8') as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split()
+            # A field starting with '#' comments out the rest of the line
+            for i, field in enumerate(fields):
+                if field.startswith('#'):
+                    del fields[i:]
+                    break
+            if not fields:
+                continue
+            where = f"{filename}:{number}"
+            if len(fields) < 2 or len(fields) > 3:
+                print(f"Error: {where}: expected 'input output [pending]'")
+                errors += 1
+                continue
+            key, output = fields[0], fields[1]
+            pending = fields[2] if len(fields) == 3 else ''
+            if any(ord(c) < KEY_FIRST + 1 or ord(c) > KEY_LAST for c in key + pending):
+                print(f"Error: {where}: keys must be printable ASCII")
+                errors += 1
+                continue
+            if len(key) > MAX_INPUT or len(pending) > MAX_INPUT:
+                print(f"Error: {where}: more than {MAX_INPUT} keys")
+                errors += 1
+                continue
+            try:
+                sjis = output.encode('shift_jis')
+            except UnicodeEncodeError as e:
+                print(f"Error: {where}: output cannot be converted to Shift-JIS: {e}")
+                errors += 1
+                continue
+            if len(sjis) != len(output) * 2:
+                print(f"Error: {where}: output must be full-width characters")
+                errors += 1
+                continue
+            if key in seen:
+                print(f"Warning: {where}: '{key}' already defined at line {seen[key]}, ignored")
+                continue
+            seen[key] = number
+            rules.append((key, output, pending))
+
+    if errors:
+        sys.exit(1)
+    return rules
+
+def build_trie(rules):
+    """Build the key trie; returns the root node"""
+    root = Node(None, 0, 0)
+    for key, output, pending in rules:
+        node = root
+        for c in key:
+            child = node.children.get(c)
+            if child is None:
+                child = Node(node, c, node.depth + 1)
+                node.children[c] = child
+            node = child
+        node.output = output
+        node.pending = pending
+    return root
+
+def drop_prefix_rules(node):
+    """Drop the rules that other rules continue; returns how many"""
+    dropped = 0
+    if node.output is not None and node.children:
+        print(f"Warning: '{path(node)}' is the prefix of other rules, ignored")
+        node.output = None
+        dropped += 1
+    for child in node.children.values():
+        dropped += drop_prefix_rules(child)
+    return dropped
+
+def walk(root, keys):
+    """Node reached by keys from the root, or None"""
+    node = root
+    for c in keys:
+        node = node.children.get(c)
+        if node is None:
+            return None
+    return node
+
+def number_states(root):
+    """Number the nodes that continue a rule, breadth first; returns them"""
+    states = []
+    queue = [root]
+    while queue:
+        node = queue.pop(0)
+        node.state = len(states)
+        states.append(node)
+        for c in sorted(node.children):
+            child = node.children[c]
+            if child.children:
+                queue.append(child)
+    if len(states) > 255:
+        print(f"Error: {len(states)} states, the table allows 255")
+        sys.exit(1)
+    return states
+
+def output_slot(slots, text):
+    if text not in slots:
+        slots[text] = len(slots)
+    return slots[text]
+
+def build_transitions(root, states, slots):
+    """Transitions per state: list of (key, next state, output slot)"""
+    rows = []
+    for node in states:
+        row = []
+        for c in sorted(node.children):
+            child = node.children[c]
+            if child.children:
+                row.append((c, child.state, 0))
+                continue
+            target = walk(root, child.pending)
+            if target is None or not target.children:
+                print(f"Error: pending '{child.pending}' of rule '{path(child)}' continues no rule")
+                sys.exit(1)
+            row.append((c, target.state, output_slot(slots, child.output)))
+        rows.append(row)
+    return rows
+
+def path(node):
+    keys = ''
+    while node.parent is not None:
+        keys = node.key + keys
+        node = node.parent
+    return keys
+
+def pack(rows, key_first, key_last):
+    """Row displacement packing; returns (base, check, next, out)"""
+    used = []
+    base = [0] * len(rows)
+
+    # Rows with most transitions first, they are the hardest to place
+    order = sorted(range(len(rows)), key=lambda s: (-len(rows[s]), s))
+    for s in order:
+        offsets = [ord(c) - key_first for c, _, _ in rows[s]]
+        b = 0
+        while any(b + o < len(used) and used[b + o] for o in offsets):
+            b += 1
+        base[s] = b
+        for o in offsets:
+            while len(used) <= b + o:
+                used.append(False)
+            used[b + o] = True
+
+    # Every state may index the whole key range from its base
+    size = max(base) + key_last - key_first + 1
+    check = [0xFF] * size
+    next_state = [0] * size
+    out = [0] * size
+    for s, row in enumerate(rows):
+        for c, target, slot in row:
+            i = base[s] + ord(c) - key_first
+            check[i] = s
+            next_state[i] = target
+            out[i] = slot
+    return base, check, next_state, out
+
+def format_array(ctype, name, values, per_line=16, hex_digits=2):
+    lines = [f"static const {ctype} {name}[{len(values)}] = {{"]
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        text = ', '.join(f"0x{v:0{hex_digits}X}" for v in chunk)
+        lines.append(f"    {text}{',' if i + per_line < len(values) else ''}")
+    lines.append("};")
+    return '\n'.join(lines)
+
+def key_literal(c):
+    if c == 0:
+        return "0"
+    if c in "'\\":
+        return f"'\\{c}'"
+    return f"'{c}'"
+
+def write_header(filename, rule_file, states, key_first, key_last, tables, slots):
+    base, check, next_state, out = tables
+    parent = [s.parent.state if s.parent is not None else 0 for s in states]
+    depth = [s.depth for s in states]
+
+    kana = bytearray()
+    starts = []
+    for text in sorted(slots, key=slots.get):
+        starts.append(len(kana))
+        kana += text.encode('shift_jis') + b'\x00'
+
+    with open(filename, 'w', encoding='utf-8', newline='\n') as f:
+        f.write("#ifndef ROMAJI_TABLE_H\n")
+        f.write("#define ROMAJI_TABLE_H\n\n")
+        f.write(f"// Generated by romajiconv.py from {rule_file}, do not edit.\n")
+        f.write("// See romajiconv/romajiconv.py for the table format.\n\n")
+        f.write(f"#define ROMAJI_STATES     {len(states)}\n")
+        f.write(f"#define ROMAJI_KEY_FIRST  {key_first}\n")
+        f.write(f"#define ROMAJI_KEY_LAST   {key_last}\n")
+        f.write(f"#define ROMAJI_DEPTH_MAX  {max(depth)}\n\n")
+        f.write(format_array("uint16_t", "romaji_base", base, 8, 4) + "\n\n")
+        f.write(format_array("uint8_t", "romaji_check", check) + "\n\n")
+        f.write(format_array("uint8_t", "romaji_next", next_state) + "\n\n")
+        f.write(format_array("uint8_t", "romaji_out", out) + "\n\n")
+        f.write(format_array("uint8_t", "romaji_parent", parent) + "\n\n")
+        keys = [key_literal(s.key) for s in states]
+        f.write(f"static const uint8_t romaji_key[{len(keys)}] = {{\n")
+        for i in range(0, len(keys), 16):
+            chunk = keys[i:i + 16]
+            f.write(f"    {', '.join(chunk)}{',' if i + 16 < len(keys) else ''}\n")
+        f.write("};\n\n")
+        f.write(format_array("uint8_t", "romaji_depth", depth) + "\n\n")
+        f.write(format_array("uint16_t", "romaji_output", starts, 8, 4) + "\n\n")
+        f.write(format_array("uint8_t", "romaji_kana", list(kana)) + "\n\n")
+        f.write("#endif /* ROMAJI_TABLE_H */\n")
+
+    return (len(base) * 2 + len(check) * 3 + len(states) * 3 +
+            len(starts) * 2 + len(kana))
+
+def main():
+    if len(sys.argv) < 3:
+        print("Usage: python3 romajiconv.py <rule_file> <output_header>")
+        print("\nExample:")
+        print("  python3 romajiconv.py romaji.txt ../c/oscar64_lib/src/romaji_table.h")
+        return 1
+
+    rule_file = sys.argv[1]
+    header_file = sys.argv[2]
+
+    rules = parse_rules(rule_file)
+    if not rules:
+        print(f"Error: no rules in {rule_file}")
+        return 1
+
+    root = build_trie(rules)
+    dropped = drop_prefix_rules(root)
+    states = number_states(root)
+    slots = {'': 0}
+    rows = build_transitions(root, states, slots)
+    if len(slots) > 256:
+        print(f"Error: {len(slots)} distinct outputs, the table allows 256")
+        return 1
+    keys = ''.join(key for key, _, _ in rules)
+    key_first = min(ord(c) for c in keys)
+    key_last = max(ord(c) for c in keys)
+    tables = pack(rows, key_first, key_last)
+
+    total = write_header(header_file, rule_file.replace('\\', '/').split('/')[-1],
+                         states, key_first, key_last, tables, slots)
+    check = tables[1]
+
+    transitions = sum(len(row) for row in rows)
+    print(f"Rules: {len(rules) - dropped}")
+    print(f"States: {len(states)}, transitions: {transitions}, packed entries: {len(check)}")
+    print(f"Outputs: {len(slots) - 1}")
+    print(f"Table size: {total} bytes")
+    print(f"Written: {header_file}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
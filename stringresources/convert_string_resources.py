@@ -144,6 +144,179 @@ def create_resource_binary(resources, start_offset=0):
     
     return bytes(output)
 
+# Pre-rasterized resources (--raster)
+RASTER_MAGIC = b'RST\x00'
+RASTER_HEADER_SIZE = 8
+RASTER_BANK_SIZE = 8192
+RASTER_FLAG_NEWLINE = 0x01
+RASTER_COLOR_CURRENT = 0xFF
+RASTER_MAX_RUN = 255
+JISX0201_SIZE = 2048
+
+def sjis_to_kanji_offset(lead, trail):
+    """Shift-JIS to JIS X 0208 font offset (same arithmetic as jtxt_sjis_to_offset)"""
+    if trail < 0x40 or trail == 0x7F or trail > 0xFC:
+        return None
+    ku = (lead * 2 - 0x102) if lead <= 0x9F else (lead * 2 - 0x182)
+    if trail >= 0x9F:
+        ku += 1
+    if trail < 0x7F:
+        ten = trail - 0x40
+    elif trail < 0x9F:
+        ten = trail - 0x41
+    else:
+        ten = trail - 0x9F
+    if ku < 0 or ku >= 84:
+        return None
+    return (ku * 94 + ten) * 8
+
+def load_fonts(font_file, jisx0201_file):
+    """Load full-width and half-width font images"""
+    with open(font_file, 'rb') as f:
+        kanji = f.read()
+    with open(jisx0201_file, 'rb') as f:
+        jisx0201 = f.read()
+    if len(jisx0201) < JISX0201_SIZE:
+        jisx0201 += bytes(JISX0201_SIZE - len(jisx0201))
+    return kanji, jisx0201
+
+def glyph_bitmap(code, fonts):
+    """8-byte bitmap for a single-byte or double-byte SJIS code"""
+    kanji, jisx0201 = fonts
+    if code < 0x100:
+        return jisx0201[code * 8:code * 8 + 8]
+    offset = sjis_to_kanji_offset(code >> 8, code & 0xFF)
+    if offset is None or offset + 8 > len(kanji):
+        offset = sjis_to_kanji_offset(0x81, 0x40)  # Full-width space
+    return kanji[offset:offset + 8]
+
+def text_to_runs(text):
+    """Split text into runs of (flags, color, [sjis codes])
+
+    A run ends at a newline or a color change. Color escapes:
+      \\c0 - \\cF  foreground color
+      \\c-          back to the current bitmap color
+    """
+    runs = []
+    flags = 0
+    color = RASTER_COLOR_CURRENT
+    codes = []
+
+    def flush():
+        nonlocal flags, codes
+        if codes or flags:
+            runs.append((flags, color, codes))
+        flags = 0
+        codes = []
+
+    text = text.replace('\\n', '\n')
+    i = 0
+    while i < len(text):
+        ch = text[i]
+        if ch == '\\' and text[i + 1:i + 2] == 'c' and i + 2 < len(text):
+            spec = text[i + 2]
+            new_color = RASTER_COLOR_CURRENT if spec == '-' else int(spec, 16)
+            if new_color != color:
+                flush()
+                color = new_color
+            i += 3
+            continue
+        if ch in '\r\n':
+            flush()
+            flags = RASTER_FLAG_NEWLINE
+            i += 1
+            continue
+        try:
+            sjis = ch.encode('shift-jis')
+        except UnicodeEncodeError as e:
+            print(f"Error: Character cannot be converted to Shift-JIS: {e}")
+            i += 1
+            continue
+        if len(sjis) == 2:
+            codes.append((sjis[0] << 8) | sjis[1])
+        elif 0x20 <= sjis[0] <= 0x7E or 0xA1 <= sjis[0] <= 0xDF:
+            codes.append(sjis[0])
+        if len(codes) == RASTER_MAX_RUN:
+            flush()
+        i += 1
+    flush()
+    return runs
+
+def create_raster_resource(text, fonts):
+    """Rasterize one string
+
+    Format:
+    - 1 byte: Number of runs
+    - Per run:
+      - 1 byte: Flags (bit0: newline before run)
+      - 1 byte: Foreground color (0xFF = current bitmap color)
+      - 1 byte: Width in cells
+      - Width * 8 bytes: Glyph bitmaps in display order
+    """
+    runs = text_to_runs(text)
+    if len(runs) > 255:
+        raise ValueError("too many runs in one string")
+
+    output = bytearray([len(runs)])
+    for flags, color, codes in runs:
+        output.extend((flags, color, len(codes)))
+        for code in codes:
+            output.extend(glyph_bitmap(code, fonts))
+    return bytes(output)
+
+def create_raster_binary(resources, fonts, start_offset=0):
+    """Create pre-rasterized string resources
+
+    Format:
+    - 4 bytes: 'RST' + 0x00
+    - 2 bytes: Number of strings (little-endian)
+    - 2 bytes: Reserved
+    - 4 bytes per string (same layout as the SJIS table):
+      - 1 byte: Bank number
+      - 1 byte: Reserved (0)
+      - 2 bytes: Offset within 8KB bank (little-endian)
+    - Followed by raster data; a string never crosses an 8KB bank, so it
+      can be copied with a single bank selection
+    """
+    num_strings = max(resources.keys()) + 1 if resources else 0
+    header_size = RASTER_HEADER_SIZE + num_strings * 4
+
+    table = bytearray(num_strings * 4)
+    data = bytearray()
+    current_offset = start_offset + header_size
+
+    for idx in sorted(resources.keys()):
+        raster = create_raster_resource(resources[idx], fonts)
+        if len(raster) > RASTER_BANK_SIZE:
+            raise ValueError(f"string {idx} rasterizes to {len(raster)} bytes (max {RASTER_BANK_SIZE})")
+
+        # Pad to the next bank instead of straddling a boundary
+        in_bank = current_offset % RASTER_BANK_SIZE
+        if in_bank + len(raster) > RASTER_BANK_SIZE:
+            pad = RASTER_BANK_SIZE - in_bank
+            data.extend(bytes(pad))
+            current_offset += pad
+
+        bank = current_offset // RASTER_BANK_SIZE
+        struct.pack_into('<BBH', table, idx * 4, bank, 0, current_offset % RASTER_BANK_SIZE)
+
+        data.extend(raster)
+        current_offset += len(raster)
+
+    output = bytearray(RASTER_MAGIC)
+    output.extend(struct.pack('<HH', num_strings, 0))
+    output.extend(table)
+    output.extend(data)
+    return bytes(output)
+
+def get_option_value(name, default=None):
+    """Value following a --name option on the command line"""
+    if name in sys.argv:
+        pos = sys.argv.index(name)
+        if pos + 1 < len(sys.argv):
+            return sys.argv[pos + 1]
+    return default
+
 def align_to_boundary(offset, boundary):
     """Align offset to specified boundary
     
@@ -165,10 +338,14 @@ def main():
         print("  --align16k  Align to 16KB boundary (default)")
         print("  --align8k   Align to 8KB boundary")
         print("  --no-align  No alignment")
+        print("  --raster    Emit pre-rasterized glyph runs instead of SJIS text")
+        print("  --font-file <file>      Full-width font for --raster (default: ../fontconv/font_misaki_gothic.bin)")
+        print("  --jisx0201-file <file>  Half-width font for --raster (default: ../fontconv/font_jisx0201.bin)")
         print("\nExamples:")
         print("  python convert_string_resources.py strings.txt")
         print("  python convert_string_resources.py strings.txt strings.bin")
         print("  python convert_string_resources.py strings.txt strings.bin 75776 --align8k")
+        print("  python convert_string_resources.py strings.txt raster.bin 303104 --no-align --raster")
         sys.exit(1)
     
     input_file = sys.argv[1]
@@ -219,6 +396,32 @@ def main():
     for idx in sorted(resources.keys()):
         print(f"  [{idx}] {repr(resources[idx][:50] + '...' if len(resources[idx]) > 50 else resources[idx])}")
     
+    # Pre-rasterized output
+    if '--raster' in sys.argv:
+        font_file = get_option_value('--font-file', '../fontconv/font_misaki_gothic.bin')
+        jisx0201_file = get_option_value('--jisx0201-file', '../fontconv/font_jisx0201.bin')
+        fonts = load_fonts(font_file, jisx0201_file)
+        try:
+            binary_data = create_raster_binary(resources, fonts, start_offset)
+        except ValueError as e:
+            print(f"Error: {e}")
+            sys.exit(1)
+
+        with open(output_file, 'wb') as f:
+            f.write(binary_data)
+
+        num_strings = max(resources.keys()) + 1 if resources else 0
+        print(f"\nRaster conversion complete:")
+        print(f"  Offset table size: {RASTER_HEADER_SIZE + num_strings * 4} bytes")
+        print(f"  Total size: {len(binary_data)} bytes")
+        print(f"\nRaster layout information:")
+        for idx in sorted(resources.keys()):
+            bank, _, offset = struct.unpack_from('<BBH', binary_data, RASTER_HEADER_SIZE + idx * 4)
+            runs = text_to_runs(resources[idx])
+            cells = sum(len(codes) for _, _, codes in runs)
+            print(f"  [{idx}] Bank {bank}, Offset 0x{offset:04X}, {len(runs)} runs, {cells} cells")
+        return
+
     # Create binary
     binary_data = create_resource_binary(resources, start_offset)
     